@@ -0,0 +1,60 @@
+#include "bench_common.hpp"
+
+#include <fastnum/arrow.hpp>
+#include <fastnum/running_stats.hpp>
+
+#include <cstdint>
+#include <random>
+
+namespace {
+
+// A nullable column with the given null fraction (in 1/1000).
+struct nullable_column {
+    std::vector<double> values;
+    std::vector<std::uint8_t> bits;
+};
+
+nullable_column make_column(std::size_t n, std::int64_t nulls_per_mille) {
+    nullable_column c{fastnum_bench::make_data<double>(n), std::vector<std::uint8_t>((n + 7) / 8, 0)};
+    std::mt19937 rng(777);
+    std::uniform_int_distribution<std::int64_t> u(0, 999);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (u(rng) >= nulls_per_mille) c.bits[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+    }
+    return c;
+}
+
+constexpr std::size_t n_rows = std::size_t{1} << 20;
+
+// Baseline: copy the valid values into a vector, then batch observe.
+void BM_Arrow_CopyValid(benchmark::State& state) {
+    const auto c = make_column(n_rows, state.range(0));
+    std::vector<double> buf;
+    for (auto _ : state) {
+        buf.clear();
+        for (std::size_t i = 0; i < n_rows; ++i) {
+            if ((c.bits[i / 8] >> (i % 8)) & 1) buf.push_back(c.values[i]);
+        }
+        fastnum::RunningStats<double> stats;
+        stats.observe(buf);
+        benchmark::DoNotOptimize(stats);
+    }
+    fastnum_bench::set_counters(state, n_rows, sizeof(double));
+}
+
+void BM_Arrow_ObserveInPlace(benchmark::State& state) {
+    const auto c = make_column(n_rows, state.range(0));
+    const fastnum::arrow_column<double> col{c.values.data(), c.bits.data(), 0, n_rows};
+    for (auto _ : state) {
+        fastnum::RunningStats<double> stats;
+        fastnum::observe_arrow(stats, col);
+        benchmark::DoNotOptimize(stats);
+    }
+    fastnum_bench::set_counters(state, n_rows, sizeof(double));
+}
+
+} // namespace
+
+// Null fractions: none set, 0.1%, 1%, 50%.
+BENCHMARK(BM_Arrow_CopyValid)->Arg(0)->Arg(1)->Arg(10)->Arg(500);
+BENCHMARK(BM_Arrow_ObserveInPlace)->Arg(0)->Arg(1)->Arg(10)->Arg(500);
@@ -0,0 +1,37 @@
+#include "bench_common.hpp"
+
+#include <fastnum/buffered.hpp>
+
+namespace {
+
+// One value per call, as from a per-event callback; compare with
+// BM_RunningStats_ObserveScalar / BM_Covariance_ObserveScalar.
+template <std::size_t N>
+void BM_Buffered_RunningStats(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<double>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::BufferedRunningStats<double, N> rs;
+        for (double x : xs) rs.observe(x);
+        benchmark::DoNotOptimize(rs.variance_sample());
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(double));
+}
+
+void BM_Buffered_Covariance(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<double>(n, 1);
+    const auto ys = fastnum_bench::make_data<double>(n, 2);
+    for (auto _ : state) {
+        fastnum::BufferedCovariance<double> cov;
+        for (std::size_t i = 0; i < n; ++i) cov.observe(xs[i], ys[i]);
+        benchmark::DoNotOptimize(cov->covariance_sample());
+    }
+    fastnum_bench::set_counters(state, n, 2 * sizeof(double));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Buffered_RunningStats, 64)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Buffered_RunningStats, 256)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Buffered_RunningStats, 1024)->Apply(fastnum_bench::sizes);
+BENCHMARK(BM_Buffered_Covariance)->Apply(fastnum_bench::sizes);
@@ -0,0 +1,64 @@
+#include "bench_common.hpp"
+
+#include <fastnum/column_file.hpp>
+#include <fastnum/running_stats.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+// One 64 MiB column of doubles, written once (page-cache warm afterwards, so
+// these measure the copy / mapping overhead rather than the disk).
+const std::string& column_path() {
+    static const std::string path = [] {
+        const std::string p = (std::filesystem::temp_directory_path() / "fastnum_bench_column.fncf").string();
+        const auto xs = fastnum_bench::make_data<double>(std::size_t{1} << 23);
+        const double* cols[1] = {xs.data()};
+        (void)fastnum::write_column_file(p.c_str(), cols, 1, xs.size());
+        return p;
+    }();
+    return path;
+}
+
+// Baseline: read the whole column into a vector, then batch observe.
+void BM_ColumnFile_ReadIntoVector(benchmark::State& state) {
+    const std::string& path = column_path();
+    std::size_t n = 0;
+    for (auto _ : state) {
+        std::ifstream in(path, std::ios::binary);
+        fastnum::column_file_header h{};
+        in.read(reinterpret_cast<char*>(&h), sizeof h);
+        in.seekg(static_cast<std::streamoff>(h.data_offset));
+        std::vector<double> xs(static_cast<std::size_t>(h.rows));
+        in.read(reinterpret_cast<char*>(xs.data()), static_cast<std::streamsize>(xs.size() * sizeof(double)));
+        fastnum::RunningStats<double> stats;
+        stats.observe(xs);
+        benchmark::DoNotOptimize(stats);
+        n = xs.size();
+    }
+    fastnum_bench::set_counters(state, n, sizeof(double));
+}
+
+// Map and stream page-aligned chunks into the same batch observe.
+void BM_ColumnFile_Mapped(benchmark::State& state) {
+    const std::string& path = column_path();
+    fastnum::column_stream_options opt;
+    opt.threads = static_cast<std::size_t>(state.range(0));
+    std::size_t n = 0;
+    for (auto _ : state) {
+        const fastnum::column_file<double> f(path.c_str());
+        fastnum::RunningStats<double> stats;
+        fastnum::observe_column(stats, f, 0, opt);
+        benchmark::DoNotOptimize(stats);
+        n = f.rows();
+    }
+    fastnum_bench::set_counters(state, n, sizeof(double));
+}
+
+} // namespace
+
+BENCHMARK(BM_ColumnFile_ReadIntoVector)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ColumnFile_Mapped)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
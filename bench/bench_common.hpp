@@ -0,0 +1,40 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace fastnum_bench {
+
+// Sample counts spanning L1-resident (4 KiB of doubles) to DRAM-resident
+// (64 MiB of doubles) working sets.
+inline void sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(8)->Range(std::int64_t{1} << 9, std::int64_t{1} << 23);
+}
+
+template <typename T>
+std::vector<T> make_data(std::size_t n, std::uint32_t seed = 12345) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(10.0, 3.0);
+    std::vector<T> xs(n);
+    for (T& x : xs) x = static_cast<T>(dist(rng));
+    return xs;
+}
+
+// Reports samples/s, time per sample (printed as e.g. "0.42ns") and bytes/s
+// (printed as G/s).
+inline void set_counters(benchmark::State& state, std::size_t samples_per_iter,
+                         std::size_t bytes_per_sample) {
+    const auto samples = static_cast<std::int64_t>(state.iterations()) *
+                         static_cast<std::int64_t>(samples_per_iter);
+    state.SetItemsProcessed(samples);
+    state.SetBytesProcessed(samples * static_cast<std::int64_t>(bytes_per_sample));
+    state.counters["time/sample"] = benchmark::Counter(
+        static_cast<double>(samples),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+} // namespace fastnum_bench
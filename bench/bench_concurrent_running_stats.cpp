@@ -0,0 +1,39 @@
+#include "bench_common.hpp"
+
+#include <fastnum/concurrent_running_stats.hpp>
+
+#include <mutex>
+
+namespace {
+
+constexpr std::size_t kPerIter = 4096;
+
+// Baseline: one RunningStats behind a mutex, shared by all benchmark threads.
+void BM_Concurrent_MutexBaseline(benchmark::State& state) {
+    static std::mutex mu;
+    static fastnum::RunningStats<double> rs;
+    const auto xs = fastnum_bench::make_data<double>(kPerIter, static_cast<std::uint32_t>(state.thread_index()));
+    for (auto _ : state) {
+        for (double x : xs) {
+            std::lock_guard<std::mutex> lock(mu);
+            rs.observe(x);
+        }
+    }
+    fastnum_bench::set_counters(state, kPerIter, sizeof(double));
+}
+
+void BM_Concurrent_ShardedWriter(benchmark::State& state) {
+    static fastnum::ConcurrentRunningStats<double> stats(64);
+    const auto xs = fastnum_bench::make_data<double>(kPerIter, static_cast<std::uint32_t>(state.thread_index()));
+    auto w = stats.make_writer();
+    for (auto _ : state) {
+        for (double x : xs) w.observe(x);
+    }
+    benchmark::DoNotOptimize(w.local());
+    fastnum_bench::set_counters(state, kPerIter, sizeof(double));
+}
+
+} // namespace
+
+BENCHMARK(BM_Concurrent_MutexBaseline)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_Concurrent_ShardedWriter)->ThreadRange(1, 32)->UseRealTime();
@@ -0,0 +1,34 @@
+#include "bench_common.hpp"
+
+#include <fastnum/exponential_stats.hpp>
+
+namespace {
+
+template <typename T>
+void BM_ExponentialStats_ObserveScalar(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::ExponentialStats<T> ew(static_cast<T>(0.01));
+        for (T x : xs) ew.observe(x);
+        benchmark::DoNotOptimize(ew);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+template <typename T>
+void BM_ExponentialStats_ObserveBatch(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::ExponentialStats<T> ew(static_cast<T>(0.01));
+        ew.observe(xs.data(), xs.size());
+        benchmark::DoNotOptimize(ew);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_ExponentialStats_ObserveScalar, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_ExponentialStats_ObserveScalar, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_ExponentialStats_ObserveBatch, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_ExponentialStats_ObserveBatch, double)->Apply(fastnum_bench::sizes);
@@ -0,0 +1,71 @@
+#include "bench_common.hpp"
+
+#include <fastnum/histogram.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+template <typename T, std::size_t Bins>
+void BM_Histogram_ObserveBatch(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::Histogram<T, Bins> h(T{-4}, T{4});
+        h.observe(xs.data(), xs.size());
+        benchmark::DoNotOptimize(h);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+template <typename T, std::size_t Bins>
+void BM_Histogram_ObserveScalar(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::Histogram<T, Bins> h(T{-4}, T{4});
+        for (T x : xs) h.observe(x);
+        benchmark::DoNotOptimize(h);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+template <std::size_t Bins>
+void BM_Histogram_LogBatch(benchmark::State& state) {
+    auto xs = fastnum_bench::make_data<double>(static_cast<std::size_t>(state.range(0)));
+    for (double& x : xs) x = std::exp(x);
+    for (auto _ : state) {
+        fastnum::Histogram<double, Bins, fastnum::bin_scale::log> h(1e-3, 1e3);
+        h.observe(xs.data(), xs.size());
+        benchmark::DoNotOptimize(h);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(double));
+}
+
+// Baseline: std::floor plus branchy bounds checks.
+template <std::size_t Bins>
+void BM_Histogram_NaiveFloor(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<double>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::uint64_t bins[Bins] = {}, under = 0, over = 0, nan = 0;
+        for (double x : xs) {
+            if (std::isnan(x)) ++nan;
+            else if (x < -4.0) ++under;
+            else if (x >= 4.0) ++over;
+            else ++bins[std::min<std::size_t>(Bins - 1, static_cast<std::size_t>(std::floor((x + 4.0) / 8.0 * Bins)))];
+        }
+        benchmark::DoNotOptimize(bins);
+        benchmark::DoNotOptimize(under + over + nan);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(double));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Histogram_NaiveFloor, 64)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Histogram_ObserveScalar, double, 64)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Histogram_ObserveBatch, double, 64)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Histogram_ObserveBatch, float, 64)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Histogram_ObserveBatch, double, 4096)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Histogram_LogBatch, 64)->Apply(fastnum_bench::sizes);
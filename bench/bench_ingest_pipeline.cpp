@@ -0,0 +1,35 @@
+#include "bench_common.hpp"
+
+#include <fastnum/ingest_pipeline.hpp>
+
+namespace {
+
+// Producer-side cost per sample while the consumer thread drains; compare
+// with BM_RunningStats_ObserveScalar (observing inline on the caller).
+void BM_Ingest_Push(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<double>(static_cast<std::size_t>(state.range(0)));
+    fastnum::IngestRunningStats<double> pipeline;
+    auto producer = pipeline.make_producer();
+    for (auto _ : state) {
+        for (double x : xs) producer.observe(x);
+    }
+    benchmark::DoNotOptimize(pipeline.flush());
+    fastnum_bench::set_counters(state, xs.size(), sizeof(double));
+}
+
+// Push plus wait for the consumer: end-to-end throughput.
+void BM_Ingest_PushAndFlush(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<double>(static_cast<std::size_t>(state.range(0)));
+    fastnum::IngestRunningStats<double> pipeline;
+    auto producer = pipeline.make_producer();
+    for (auto _ : state) {
+        for (double x : xs) producer.observe(x);
+        benchmark::DoNotOptimize(pipeline.flush());
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(double));
+}
+
+} // namespace
+
+BENCHMARK(BM_Ingest_Push)->Arg(1 << 12)->Arg(1 << 20)->UseRealTime();
+BENCHMARK(BM_Ingest_PushAndFlush)->Arg(1 << 12)->Arg(1 << 20)->UseRealTime();
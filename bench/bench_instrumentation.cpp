@@ -0,0 +1,37 @@
+#include "bench_common.hpp"
+
+#include <fastnum/instrumentation.hpp>
+#include <fastnum/running_stats.hpp>
+
+namespace {
+
+using counted_policy = fastnum::instrumented_policy<fastnum::counting_instrumentation<>>;
+
+// Compare with BM_RunningStats_ObserveScalar / ObserveBatch: the cost of
+// counting_instrumentation (the default hooks compile to nothing).
+template <typename T>
+void BM_Instrumented_ObserveScalar(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::RunningStats<T, counted_policy> rs;
+        for (T x : xs) rs.observe(x);
+        benchmark::DoNotOptimize(rs);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+template <typename T>
+void BM_Instrumented_ObserveBatch(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::RunningStats<T, counted_policy> rs;
+        rs.observe(xs.data(), xs.size());
+        benchmark::DoNotOptimize(rs);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Instrumented_ObserveScalar, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Instrumented_ObserveBatch, double)->Apply(fastnum_bench::sizes);
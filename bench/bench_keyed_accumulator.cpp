@@ -0,0 +1,62 @@
+#include "bench_common.hpp"
+
+#include <fastnum/keyed_accumulator.hpp>
+
+#include <unordered_map>
+
+namespace {
+
+// 1M samples spread over range(0) distinct keys: from cache-resident tables
+// to tables far larger than the LLC.
+constexpr std::size_t samples = std::size_t{1} << 20;
+
+std::vector<std::uint64_t> make_keys(std::size_t n, std::uint64_t distinct) {
+    std::mt19937_64 rng(777);
+    std::uniform_int_distribution<std::uint64_t> dist(0, distinct - 1);
+    std::vector<std::uint64_t> keys(n);
+    for (auto& k : keys) k = dist(rng) * 2654435761ull;
+    return keys;
+}
+
+inline void key_counts(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(std::int64_t{1} << 8, std::int64_t{1} << 24);
+}
+
+void BM_Keyed_UnorderedMap(benchmark::State& state) {
+    const auto keys = make_keys(samples, static_cast<std::uint64_t>(state.range(0)));
+    const auto xs = fastnum_bench::make_data<double>(samples);
+    std::unordered_map<std::uint64_t, fastnum::RunningStats<double>> table;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < samples; ++i) table[keys[i]].observe(xs[i]);
+        benchmark::DoNotOptimize(table);
+    }
+    fastnum_bench::set_counters(state, samples, sizeof(double) + sizeof(std::uint64_t));
+}
+
+void BM_Keyed_FlatScalar(benchmark::State& state) {
+    const auto keys = make_keys(samples, static_cast<std::uint64_t>(state.range(0)));
+    const auto xs = fastnum_bench::make_data<double>(samples);
+    fastnum::KeyedRunningStats<std::uint64_t> table;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < samples; ++i) table.observe(keys[i], xs[i]);
+        benchmark::DoNotOptimize(table);
+    }
+    fastnum_bench::set_counters(state, samples, sizeof(double) + sizeof(std::uint64_t));
+}
+
+void BM_Keyed_FlatBulk(benchmark::State& state) {
+    const auto keys = make_keys(samples, static_cast<std::uint64_t>(state.range(0)));
+    const auto xs = fastnum_bench::make_data<double>(samples);
+    fastnum::KeyedRunningStats<std::uint64_t> table;
+    for (auto _ : state) {
+        table.observe(keys.data(), xs.data(), samples);
+        benchmark::DoNotOptimize(table);
+    }
+    fastnum_bench::set_counters(state, samples, sizeof(double) + sizeof(std::uint64_t));
+}
+
+} // namespace
+
+BENCHMARK(BM_Keyed_UnorderedMap)->Apply(key_counts);
+BENCHMARK(BM_Keyed_FlatScalar)->Apply(key_counts);
+BENCHMARK(BM_Keyed_FlatBulk)->Apply(key_counts);
@@ -0,0 +1,58 @@
+#include "bench_common.hpp"
+
+#include <fastnum/multi_standard_scaler.hpp>
+#include <fastnum/online_standard_scaler.hpp>
+
+namespace {
+
+// range(0) = number of features; 1024 row-major samples per iteration.
+constexpr std::size_t kRows = 1024;
+
+template <typename T>
+void BM_MultiScaler_ObserveRows(benchmark::State& state) {
+    const auto d = static_cast<std::size_t>(state.range(0));
+    const auto rows = fastnum_bench::make_data<T>(kRows * d);
+    for (auto _ : state) {
+        fastnum::MultiStandardScaler<T> scaler(d);
+        scaler.observe_rows(rows.data(), kRows);
+        benchmark::DoNotOptimize(scaler.means());
+    }
+    fastnum_bench::set_counters(state, kRows * d, sizeof(T));
+}
+
+// Baseline: std::vector<OnlineStandardScaler>, strided scalar update per feature.
+template <typename T>
+void BM_MultiScaler_VectorOfScalersBaseline(benchmark::State& state) {
+    const auto d = static_cast<std::size_t>(state.range(0));
+    const auto rows = fastnum_bench::make_data<T>(kRows * d);
+    for (auto _ : state) {
+        std::vector<fastnum::OnlineStandardScaler<T>> scalers(d);
+        for (std::size_t r = 0; r < kRows; ++r)
+            for (std::size_t j = 0; j < d; ++j) scalers[j].observe(rows[r * d + j]);
+        benchmark::DoNotOptimize(scalers.data());
+    }
+    fastnum_bench::set_counters(state, kRows * d, sizeof(T));
+}
+
+template <typename T>
+void BM_MultiScaler_TransformRows(benchmark::State& state) {
+    const auto d = static_cast<std::size_t>(state.range(0));
+    const auto rows = fastnum_bench::make_data<T>(kRows * d);
+    fastnum::MultiStandardScaler<T> scaler(d);
+    scaler.observe_rows(rows.data(), kRows);
+    std::vector<T> out(rows.size());
+    for (auto _ : state) {
+        scaler.transform_rows(rows.data(), out.data(), kRows);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    fastnum_bench::set_counters(state, kRows * d, 2 * sizeof(T));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_MultiScaler_ObserveRows, float)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_MultiScaler_ObserveRows, double)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_MultiScaler_VectorOfScalersBaseline, double)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_MultiScaler_TransformRows, float)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_MultiScaler_TransformRows, double)->RangeMultiplier(8)->Range(8, 4096);
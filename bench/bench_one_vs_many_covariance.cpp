@@ -0,0 +1,54 @@
+#include "bench_common.hpp"
+
+#include <fastnum/one_vs_many_covariance.hpp>
+#include <fastnum/online_covariance.hpp>
+
+namespace {
+
+// 1024 samples of range(0) candidates plus a target; items are candidate
+// values, so time/sample is per (row, candidate) cell.
+constexpr std::size_t rows = 1024;
+
+void BM_OneVsMany_PerCandidateCovariance(benchmark::State& state) {
+    const auto d = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<double>(rows * d);
+    const auto ys = fastnum_bench::make_data<double>(rows, 99);
+    for (auto _ : state) {
+        std::vector<fastnum::OnlineCovariance<double>> covs(d);
+        for (std::size_t r = 0; r < rows; ++r) {
+            for (std::size_t j = 0; j < d; ++j) covs[j].observe(xs[r * d + j], ys[r]);
+        }
+        benchmark::DoNotOptimize(covs.data());
+    }
+    fastnum_bench::set_counters(state, rows * d, sizeof(double));
+}
+
+void BM_OneVsMany_Batch(benchmark::State& state) {
+    const auto d = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<double>(rows * d);
+    const auto ys = fastnum_bench::make_data<double>(rows, 99);
+    for (auto _ : state) {
+        fastnum::OneVsManyCovariance<double> screen(d);
+        screen.observe(ys.data(), xs.data(), rows);
+        benchmark::DoNotOptimize(screen.means());
+    }
+    fastnum_bench::set_counters(state, rows * d, sizeof(double));
+}
+
+void BM_OneVsMany_RowByRow(benchmark::State& state) {
+    const auto d = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<double>(rows * d);
+    const auto ys = fastnum_bench::make_data<double>(rows, 99);
+    for (auto _ : state) {
+        fastnum::OneVsManyCovariance<double> screen(d);
+        for (std::size_t r = 0; r < rows; ++r) screen.observe(ys[r], xs.data() + r * d);
+        benchmark::DoNotOptimize(screen.means());
+    }
+    fastnum_bench::set_counters(state, rows * d, sizeof(double));
+}
+
+} // namespace
+
+BENCHMARK(BM_OneVsMany_PerCandidateCovariance)->Arg(64)->Arg(1024)->Arg(8192);
+BENCHMARK(BM_OneVsMany_Batch)->Arg(64)->Arg(1024)->Arg(8192);
+BENCHMARK(BM_OneVsMany_RowByRow)->Arg(64)->Arg(1024)->Arg(8192);
@@ -0,0 +1,124 @@
+#include "bench_common.hpp"
+
+#include <fastnum/online_covariance.hpp>
+
+namespace {
+
+template <typename T>
+void BM_Covariance_ObserveScalar(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<T>(n, 1);
+    const auto ys = fastnum_bench::make_data<T>(n, 2);
+    for (auto _ : state) {
+        fastnum::OnlineCovariance<T> cov;
+        for (std::size_t i = 0; i < n; ++i) cov.observe(xs[i], ys[i]);
+        benchmark::DoNotOptimize(cov);
+    }
+    fastnum_bench::set_counters(state, n, 2 * sizeof(T));
+}
+
+template <typename T>
+void BM_Covariance_ObserveBatch(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<T>(n, 1);
+    const auto ys = fastnum_bench::make_data<T>(n, 2);
+    for (auto _ : state) {
+        fastnum::OnlineCovariance<T> cov;
+        cov.observe(xs.data(), ys.data(), n);
+        benchmark::DoNotOptimize(cov);
+    }
+    fastnum_bench::set_counters(state, n, 2 * sizeof(T));
+}
+
+// Interleaved (x, y) pairs: split into temporaries, then the batch kernel.
+template <typename T>
+void BM_Covariance_DeinterleaveCopy(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto xy = fastnum_bench::make_data<T>(2 * n, 1);
+    std::vector<T> xs(n), ys(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i) {
+            xs[i] = xy[2 * i];
+            ys[i] = xy[2 * i + 1];
+        }
+        fastnum::OnlineCovariance<T> cov;
+        cov.observe(xs.data(), ys.data(), n);
+        benchmark::DoNotOptimize(cov);
+    }
+    fastnum_bench::set_counters(state, n, 2 * sizeof(T));
+}
+
+template <typename T>
+void BM_Covariance_ObserveInterleaved(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto xy = fastnum_bench::make_data<T>(2 * n, 1);
+    for (auto _ : state) {
+        fastnum::OnlineCovariance<T> cov;
+        cov.observe_interleaved(xy.data(), n);
+        benchmark::DoNotOptimize(cov);
+    }
+    fastnum_bench::set_counters(state, n, 2 * sizeof(T));
+}
+
+// Two columns of a row-major matrix with 4 columns.
+template <typename T>
+void BM_Covariance_ObserveStrided(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto rows = fastnum_bench::make_data<T>(4 * n, 1);
+    for (auto _ : state) {
+        fastnum::OnlineCovariance<T> cov;
+        cov.observe_strided(rows.data(), 4, rows.data() + 3, 4, n);
+        benchmark::DoNotOptimize(cov);
+    }
+    fastnum_bench::set_counters(state, n, 2 * sizeof(T));
+}
+
+template <typename T>
+void BM_Covariance_Merge(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<T>(n, 1);
+    const auto ys = fastnum_bench::make_data<T>(n, 2);
+    std::vector<fastnum::OnlineCovariance<T>> parts(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        parts[i].observe(xs[i], ys[i]);
+        parts[i].observe(xs[(i + 1) % n], ys[(i + 1) % n]);
+    }
+    for (auto _ : state) {
+        fastnum::OnlineCovariance<T> acc;
+        for (const auto& p : parts) acc.merge(p);
+        benchmark::DoNotOptimize(acc);
+    }
+    fastnum_bench::set_counters(state, n, sizeof(fastnum::OnlineCovariance<T>));
+}
+
+template <typename T>
+void BM_Covariance_MergeMany(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<T>(n, 1);
+    const auto ys = fastnum_bench::make_data<T>(n, 2);
+    std::vector<fastnum::OnlineCovariance<T>> parts(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        parts[i].observe(xs[i], ys[i]);
+        parts[i].observe(xs[(i + 1) % n], ys[(i + 1) % n]);
+    }
+    for (auto _ : state) {
+        fastnum::OnlineCovariance<T> acc;
+        acc.merge_many(parts);
+        benchmark::DoNotOptimize(acc);
+    }
+    fastnum_bench::set_counters(state, n, sizeof(fastnum::OnlineCovariance<T>));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Covariance_ObserveScalar, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Covariance_ObserveScalar, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Covariance_ObserveBatch, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Covariance_ObserveBatch, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Covariance_DeinterleaveCopy, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Covariance_ObserveInterleaved, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Covariance_ObserveInterleaved, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Covariance_ObserveStrided, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Covariance_Merge, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Covariance_Merge, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Covariance_MergeMany, double)->Apply(fastnum_bench::sizes);
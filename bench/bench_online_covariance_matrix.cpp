@@ -0,0 +1,46 @@
+#include "bench_common.hpp"
+
+#include <fastnum/online_covariance.hpp>
+#include <fastnum/online_covariance_matrix.hpp>
+
+namespace {
+
+// range(0) = number of features D; 4096 rows per iteration.
+constexpr std::size_t kRows = 4096;
+
+template <typename T>
+void BM_CovarianceMatrix_ObserveBatch(benchmark::State& state) {
+    const auto d = static_cast<std::size_t>(state.range(0));
+    const auto rows = fastnum_bench::make_data<T>(kRows * d);
+    for (auto _ : state) {
+        fastnum::OnlineCovarianceMatrix<T> cm(d);
+        cm.observe(rows.data(), kRows);
+        benchmark::DoNotOptimize(cm.means());
+    }
+    fastnum_bench::set_counters(state, kRows, d * sizeof(T));
+}
+
+// Baseline: one OnlineCovariance per feature pair (upper triangle).
+template <typename T>
+void BM_CovarianceMatrix_PairwiseBaseline(benchmark::State& state) {
+    const auto d = static_cast<std::size_t>(state.range(0));
+    const auto rows = fastnum_bench::make_data<T>(kRows * d);
+    std::vector<fastnum::OnlineCovariance<T>> pairs(d * (d + 1) / 2);
+    for (auto _ : state) {
+        for (auto& p : pairs) p.reset();
+        for (std::size_t r = 0; r < kRows; ++r) {
+            const T* x = rows.data() + r * d;
+            std::size_t k = 0;
+            for (std::size_t i = 0; i < d; ++i)
+                for (std::size_t j = i; j < d; ++j) pairs[k++].observe(x[i], x[j]);
+        }
+        benchmark::DoNotOptimize(pairs.data());
+    }
+    fastnum_bench::set_counters(state, kRows, d * sizeof(T));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_CovarianceMatrix_ObserveBatch, float)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK_TEMPLATE(BM_CovarianceMatrix_ObserveBatch, double)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK_TEMPLATE(BM_CovarianceMatrix_PairwiseBaseline, double)->RangeMultiplier(4)->Range(4, 256);
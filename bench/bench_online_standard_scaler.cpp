@@ -0,0 +1,152 @@
+#include "bench_common.hpp"
+
+#include <fastnum/online_standard_scaler.hpp>
+
+namespace {
+
+template <typename T>
+void BM_Scaler_ObserveScalar(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::OnlineStandardScaler<T> scaler;
+        for (T x : xs) scaler.observe(x);
+        benchmark::DoNotOptimize(scaler);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+template <typename T>
+void BM_Scaler_ObserveBatch(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::OnlineStandardScaler<T> scaler;
+        scaler.observe(xs.data(), xs.size());
+        benchmark::DoNotOptimize(scaler);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+// Per-element transform(x) calls (ready() + sqrt per call).
+template <typename T>
+void BM_Scaler_TransformScalar(benchmark::State& state) {
+    auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    fastnum::OnlineStandardScaler<T> scaler;
+    scaler.observe(xs.data(), xs.size());
+    std::vector<T> out(xs.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < xs.size(); ++i) out[i] = scaler.transform(xs[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    fastnum_bench::set_counters(state, xs.size(), 2 * sizeof(T));
+}
+
+template <typename T>
+void BM_Scaler_TransformFrozen(benchmark::State& state) {
+    auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    fastnum::OnlineStandardScaler<T> scaler;
+    scaler.observe(xs.data(), xs.size());
+    const auto frozen = scaler.freeze();
+    std::vector<T> out(xs.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < xs.size(); ++i) out[i] = frozen.transform(xs[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    fastnum_bench::set_counters(state, xs.size(), 2 * sizeof(T));
+}
+
+template <typename T>
+void BM_Scaler_TransformInplace(benchmark::State& state) {
+    auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    fastnum::OnlineStandardScaler<T> scaler;
+    scaler.observe(xs.data(), xs.size());
+    for (auto _ : state) {
+        scaler.transform_inplace(xs.data(), xs.size());
+        benchmark::DoNotOptimize(xs.data());
+        benchmark::ClobberMemory();
+    }
+    fastnum_bench::set_counters(state, xs.size(), 2 * sizeof(T));
+}
+
+template <typename T>
+void BM_Scaler_TransformOutOfPlace(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    fastnum::OnlineStandardScaler<T> scaler;
+    scaler.observe(xs.data(), xs.size());
+    std::vector<T> out(xs.size());
+    for (auto _ : state) {
+        scaler.transform(xs.data(), out.data(), xs.size());
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    fastnum_bench::set_counters(state, xs.size(), 2 * sizeof(T));
+}
+
+// Prequential z-scores: transform with the prior state, then observe.
+template <typename T>
+void BM_Scaler_PrequentialLoop(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    std::vector<T> out(xs.size());
+    for (auto _ : state) {
+        fastnum::OnlineStandardScaler<T> scaler;
+        for (std::size_t i = 0; i < xs.size(); ++i) {
+            out[i] = scaler.transform(xs[i]);
+            scaler.observe(xs[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    fastnum_bench::set_counters(state, xs.size(), 2 * sizeof(T));
+}
+
+template <typename T>
+void BM_Scaler_ObserveAndTransform(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    std::vector<T> out(xs.size());
+    for (auto _ : state) {
+        fastnum::OnlineStandardScaler<T> scaler;
+        scaler.observe_and_transform(xs.data(), out.data(), xs.size());
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    fastnum_bench::set_counters(state, xs.size(), 2 * sizeof(T));
+}
+
+template <typename T>
+void BM_Scaler_Merge(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<T>(n);
+    std::vector<fastnum::OnlineStandardScaler<T>> parts(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        parts[i].observe(xs[i]);
+        parts[i].observe(xs[(i + 1) % n]);
+    }
+    for (auto _ : state) {
+        fastnum::OnlineStandardScaler<T> acc;
+        for (const auto& p : parts) acc.merge(p);
+        benchmark::DoNotOptimize(acc);
+    }
+    fastnum_bench::set_counters(state, n, sizeof(fastnum::OnlineStandardScaler<T>));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Scaler_ObserveScalar, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_ObserveScalar, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_ObserveBatch, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_ObserveBatch, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_TransformScalar, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_TransformScalar, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_TransformFrozen, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_TransformFrozen, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_TransformInplace, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_TransformInplace, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_TransformOutOfPlace, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_TransformOutOfPlace, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_PrequentialLoop, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_PrequentialLoop, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_ObserveAndTransform, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_ObserveAndTransform, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_Merge, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Scaler_Merge, double)->Apply(fastnum_bench::sizes);
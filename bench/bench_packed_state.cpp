@@ -0,0 +1,48 @@
+#include "bench_common.hpp"
+
+#include <fastnum/packed_state.hpp>
+
+namespace {
+
+using Stats = fastnum::RunningStats<double>;
+
+std::vector<Stats> make_states(std::size_t n, std::uint32_t seed) {
+    const auto xs = fastnum_bench::make_data<double>(3 * n, seed);
+    std::vector<Stats> parts(n);
+    for (std::size_t i = 0; i < n; ++i) parts[i].observe(xs.data() + 3 * i, 3);
+    return parts;
+}
+
+// Baseline: one merge() per feature.
+void BM_PackedState_ObjectMerge(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto in = make_states(n, 1);
+    const auto base = make_states(n, 2);
+    auto acc = base;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i) acc[i].merge(in[i]);
+        benchmark::ClobberMemory();
+    }
+    fastnum_bench::set_counters(state, n, sizeof(Stats));
+}
+
+// The reduction op over packed tiles.
+void BM_PackedState_PackedMerge(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto v_in = make_states(n, 1);
+    const auto v_base = make_states(n, 2);
+    const fastnum::packed_states<Stats> in(v_in.data(), n);
+    fastnum::packed_states<Stats> acc(v_base.data(), n);
+    int len = static_cast<int>(acc.tile_count());
+    for (auto _ : state) {
+        fastnum::packed_reduce_op<Stats>(const_cast<fastnum::packed_tile<Stats>*>(in.data()), acc.data(), &len,
+                                         nullptr);
+        benchmark::ClobberMemory();
+    }
+    fastnum_bench::set_counters(state, n, sizeof(Stats));
+}
+
+} // namespace
+
+BENCHMARK(BM_PackedState_ObjectMerge)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_PackedState_PackedMerge)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
@@ -0,0 +1,65 @@
+#include "bench_common.hpp"
+
+#include <fastnum/quantile_sketch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+template <typename T>
+void BM_QuantileSketch_ObserveBatch(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    fastnum::QuantileSketch<T> s;
+    for (auto _ : state) {
+        s.reset();
+        s.observe(xs.data(), xs.size());
+        benchmark::DoNotOptimize(s);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+template <typename T>
+void BM_QuantileSketch_ObserveScalar(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    fastnum::QuantileSketch<T> s;
+    for (auto _ : state) {
+        s.reset();
+        for (T x : xs) s.observe(x);
+        benchmark::DoNotOptimize(s);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+// Reference: exact quantile by nth_element on a copy.
+template <typename T>
+void BM_QuantileSketch_NthElementBaseline(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    std::vector<T> tmp;
+    for (auto _ : state) {
+        tmp.assign(xs.begin(), xs.end());
+        std::nth_element(tmp.begin(), tmp.begin() + tmp.size() / 2, tmp.end());
+        benchmark::DoNotOptimize(tmp[tmp.size() / 2]);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+void BM_QuantileSketch_Quantiles(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<double>(1 << 20);
+    fastnum::QuantileSketch<double> s(static_cast<std::size_t>(state.range(0)));
+    s.observe(xs.data(), xs.size());
+    const double qs[] = {0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99};
+    double out[7];
+    for (auto _ : state) {
+        s.quantiles(qs, out, 7);
+        benchmark::DoNotOptimize(out);
+    }
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_QuantileSketch_ObserveScalar, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_QuantileSketch_ObserveBatch, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_QuantileSketch_ObserveBatch, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_QuantileSketch_NthElementBaseline, double)->Apply(fastnum_bench::sizes);
+BENCHMARK(BM_QuantileSketch_Quantiles)->Arg(64)->Arg(200)->Arg(1000);
@@ -0,0 +1,35 @@
+#include "bench_common.hpp"
+
+#include <fastnum/running_moments.hpp>
+
+namespace {
+
+template <typename T, std::size_t Order>
+void BM_RunningMoments_ObserveBatch(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::RunningMoments<T, Order> m;
+        m.observe(xs.data(), xs.size());
+        benchmark::DoNotOptimize(m);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+template <typename T>
+void BM_RunningMoments_ObserveScalar(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::RunningMoments<T, 4> m;
+        for (T x : xs) m.observe(x);
+        benchmark::DoNotOptimize(m);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_RunningMoments_ObserveScalar, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningMoments_ObserveBatch, double, 2)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningMoments_ObserveBatch, double, 3)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningMoments_ObserveBatch, double, 4)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningMoments_ObserveBatch, float, 4)->Apply(fastnum_bench::sizes);
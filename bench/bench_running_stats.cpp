@@ -0,0 +1,176 @@
+#include "bench_common.hpp"
+
+#include <fastnum/running_stats.hpp>
+
+#include <limits>
+
+namespace {
+
+template <typename T>
+void BM_RunningStats_ObserveScalar(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::RunningStats<T> rs;
+        for (T x : xs) rs.observe(x);
+        benchmark::DoNotOptimize(rs);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+template <typename T>
+void BM_RunningStats_ObserveBatch(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::RunningStats<T> rs;
+        rs.observe(xs.data(), xs.size());
+        benchmark::DoNotOptimize(rs);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(T));
+}
+
+// One column of a row-major matrix with 4 columns.
+template <typename T>
+void BM_RunningStats_ObserveStrided(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto rows = fastnum_bench::make_data<T>(4 * n);
+    for (auto _ : state) {
+        fastnum::RunningStats<T> rs;
+        rs.observe_strided(rows.data() + 1, 4, n);
+        benchmark::DoNotOptimize(rs);
+    }
+    fastnum_bench::set_counters(state, n, sizeof(T));
+}
+
+// (value, count) pairs with counts 1..16; time/sample is per pair.
+template <typename T>
+void BM_RunningStats_ObserveWeighted(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<T>(n);
+    std::vector<T> ws(n);
+    for (std::size_t i = 0; i < n; ++i) ws[i] = static_cast<T>(1 + i % 16);
+    for (auto _ : state) {
+        fastnum::RunningStats<T> rs;
+        rs.observe(xs.data(), ws.data(), n);
+        benchmark::DoNotOptimize(rs);
+    }
+    fastnum_bench::set_counters(state, n, 2 * sizeof(T));
+}
+
+// Baseline: expanding the same pairs into repeated observe() calls.
+template <typename T>
+void BM_RunningStats_ObserveExpanded(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<T>(n);
+    for (auto _ : state) {
+        fastnum::RunningStats<T> rs;
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t k = 0; k < 1 + i % 16; ++k) rs.observe(xs[i]);
+        }
+        benchmark::DoNotOptimize(rs);
+    }
+    fastnum_bench::set_counters(state, n, 2 * sizeof(T));
+}
+
+// One merge per pair of partial states; range(0) is the number of partials.
+template <typename T>
+void BM_RunningStats_Merge(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<T>(n);
+    std::vector<fastnum::RunningStats<T>> parts(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        parts[i].observe(xs[i]);
+        parts[i].observe(xs[(i + 1) % n]);
+    }
+    for (auto _ : state) {
+        fastnum::RunningStats<T> acc;
+        for (const auto& p : parts) acc.merge(p);
+        benchmark::DoNotOptimize(acc);
+    }
+    fastnum_bench::set_counters(state, n, sizeof(fastnum::RunningStats<T>));
+}
+
+template <typename T>
+void BM_RunningStats_MergeMany(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<T>(n);
+    std::vector<fastnum::RunningStats<T>> parts(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        parts[i].observe(xs[i]);
+        parts[i].observe(xs[(i + 1) % n]);
+    }
+    for (auto _ : state) {
+        fastnum::RunningStats<T> acc;
+        acc.merge_many(parts);
+        benchmark::DoNotOptimize(acc);
+    }
+    fastnum_bench::set_counters(state, n, sizeof(fastnum::RunningStats<T>));
+}
+
+// Batch observe with every 1-in-range(1) value a NaN; range(1) == 0 means none.
+template <fastnum::nan_policy Nans>
+void BM_RunningStats_ObserveNaN(benchmark::State& state) {
+    using Stats = fastnum::RunningStats<double, fastnum::nan_handling_policy<Nans>>;
+    auto xs = fastnum_bench::make_data<double>(static_cast<std::size_t>(state.range(0)));
+    if (const auto every = static_cast<std::size_t>(state.range(1))) {
+        for (std::size_t i = 0; i < xs.size(); i += every) xs[i] = std::numeric_limits<double>::quiet_NaN();
+    }
+    for (auto _ : state) {
+        Stats rs;
+        rs.observe(xs);
+        benchmark::DoNotOptimize(rs);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(double));
+}
+
+// float data into double state: upcast copy first vs widening in the kernel.
+void BM_RunningStats_ObserveUpcastCopy(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<float>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        const std::vector<double> wide(xs.begin(), xs.end());
+        fastnum::RunningStats<double> rs;
+        rs.observe(wide);
+        benchmark::DoNotOptimize(rs);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(float));
+}
+
+void BM_RunningStats_ObserveMixed(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<float>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::RunningStats<double> rs;
+        rs.observe(xs);
+        benchmark::DoNotOptimize(rs);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(float));
+}
+
+void BM_RunningStats_ObserveCompensated(benchmark::State& state) {
+    const auto xs = fastnum_bench::make_data<float>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        fastnum::RunningStats<float, fastnum::compensated_policy<>> rs;
+        rs.observe(xs);
+        benchmark::DoNotOptimize(rs);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(float));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_RunningStats_ObserveScalar, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningStats_ObserveScalar, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningStats_ObserveBatch, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningStats_ObserveBatch, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningStats_ObserveStrided, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningStats_ObserveWeighted, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningStats_ObserveExpanded, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningStats_Merge, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningStats_Merge, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningStats_MergeMany, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_RunningStats_ObserveNaN, fastnum::nan_policy::propagate)
+    ->ArgsProduct({{1 << 16}, {0, 100}});
+BENCHMARK_TEMPLATE(BM_RunningStats_ObserveNaN, fastnum::nan_policy::skip)->ArgsProduct({{1 << 16}, {0, 100, 2}});
+BENCHMARK_TEMPLATE(BM_RunningStats_ObserveNaN, fastnum::nan_policy::count_and_skip)
+    ->ArgsProduct({{1 << 16}, {0, 100, 2}});
+BENCHMARK(BM_RunningStats_ObserveUpcastCopy)->Apply(fastnum_bench::sizes);
+BENCHMARK(BM_RunningStats_ObserveMixed)->Apply(fastnum_bench::sizes);
+BENCHMARK(BM_RunningStats_ObserveCompensated)->Apply(fastnum_bench::sizes);
@@ -0,0 +1,52 @@
+#include "bench_common.hpp"
+
+#include <fastnum/serialization.hpp>
+
+#include <cstdint>
+
+namespace {
+
+template <typename T>
+std::vector<fastnum::RunningStats<T>> make_states(std::size_t n) {
+    const auto xs = fastnum_bench::make_data<T>(n + 1);
+    std::vector<fastnum::RunningStats<T>> parts(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        parts[i].observe(xs[i]);
+        parts[i].observe(xs[i + 1]);
+    }
+    return parts;
+}
+
+template <typename T>
+void BM_Serialization_ToBytes(benchmark::State& state) {
+    using RS = fastnum::RunningStats<T>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto parts = make_states<T>(n);
+    std::vector<std::uint64_t> buf((fastnum::serialized_size<RS>(n) + 7) / 8);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fastnum::to_bytes(parts.data(), n, buf.data(), buf.size() * 8));
+        benchmark::ClobberMemory();
+    }
+    fastnum_bench::set_counters(state, n, sizeof(typename fastnum::state_traits<RS>::record));
+}
+
+// Validate (including checksum) and merge every record of a blob.
+template <typename T>
+void BM_Serialization_ViewMerge(benchmark::State& state) {
+    using RS = fastnum::RunningStats<T>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto parts = make_states<T>(n);
+    std::vector<std::uint64_t> buf((fastnum::serialized_size<RS>(n) + 7) / 8);
+    const std::size_t bytes = fastnum::to_bytes(parts.data(), n, buf.data(), buf.size() * 8);
+    for (auto _ : state) {
+        const fastnum::state_view<RS> view(buf.data(), bytes);
+        benchmark::DoNotOptimize(view.merged());
+    }
+    fastnum_bench::set_counters(state, n, sizeof(typename fastnum::state_traits<RS>::record));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Serialization_ToBytes, double)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Serialization_ViewMerge, float)->Apply(fastnum_bench::sizes);
+BENCHMARK_TEMPLATE(BM_Serialization_ViewMerge, double)->Apply(fastnum_bench::sizes);
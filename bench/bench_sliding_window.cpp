@@ -0,0 +1,52 @@
+#include "bench_common.hpp"
+
+#include <fastnum/sliding_window.hpp>
+
+#include <deque>
+
+namespace {
+
+// A 300-bucket window ("5 minutes at 1 s") fed range(0) samples per bucket
+// and queried once per bucket, as a per-tick dashboard would.
+constexpr std::size_t window_buckets = 300;
+constexpr std::size_t stream_buckets = 2000;
+
+// Baseline: buffer the window's samples and rebuild the statistics per tick.
+void BM_Window_RebuildFromBuffer(benchmark::State& state) {
+    const auto per_bucket = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<double>(per_bucket * stream_buckets);
+    for (auto _ : state) {
+        std::deque<double> buffer;
+        double sink = 0.0;
+        for (std::size_t b = 0; b < stream_buckets; ++b) {
+            for (std::size_t i = 0; i < per_bucket; ++i) buffer.push_back(xs[b * per_bucket + i]);
+            while (buffer.size() > window_buckets * per_bucket) buffer.pop_front();
+            fastnum::RunningStats<double> rs;
+            for (double x : buffer) rs.observe(x);
+            sink += rs.variance_sample();
+        }
+        benchmark::DoNotOptimize(sink);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(double));
+}
+
+void BM_Window_SlidingWindow(benchmark::State& state) {
+    const auto per_bucket = static_cast<std::size_t>(state.range(0));
+    const auto xs = fastnum_bench::make_data<double>(per_bucket * stream_buckets);
+    for (auto _ : state) {
+        fastnum::WindowedRunningStats<window_buckets> window(1);
+        double sink = 0.0;
+        for (std::size_t b = 0; b < stream_buckets; ++b) {
+            const auto t = static_cast<std::int64_t>(b);
+            for (std::size_t i = 0; i < per_bucket; ++i) window.observe(t, xs[b * per_bucket + i]);
+            sink += window.aggregate().variance_sample();
+        }
+        benchmark::DoNotOptimize(sink);
+    }
+    fastnum_bench::set_counters(state, xs.size(), sizeof(double));
+}
+
+} // namespace
+
+BENCHMARK(BM_Window_RebuildFromBuffer)->Arg(1)->Arg(16)->Arg(256);
+BENCHMARK(BM_Window_SlidingWindow)->Arg(1)->Arg(16)->Arg(256);
@@ -0,0 +1,338 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @file
+ * @brief Zero-copy ingestion of Apache Arrow arrays, nulls dropped via the validity bitmap.
+ *
+ * Optional and dependency-free: arrays are taken either as an
+ * `arrow_column<T>` (values buffer + validity bitmap + offset + length, i.e.
+ * the raw pieces of an Arrow primitive array) or through the ABI-stable
+ * Arrow C data interface (`ArrowSchema` / `ArrowArray`), which every Arrow
+ * implementation can export without copying (`arrow::ExportArray`,
+ * `pyarrow.Array._export_to_c`, ...).
+ *
+ * ## Null handling
+ * The validity bitmap is scanned one 64-bit word at a time. Runs of valid
+ * values of at least `arrow_direct_run` elements, i.e. practically all of a
+ * column with sparse nulls, go through the accumulator's batch (SIMD)
+ * `observe` in place; all-null words are skipped without touching the
+ * values. Only the valid values of short runs between dense nulls are
+ * compacted into a small stack block that is observed as one batch, so
+ * per-call lane-merge overhead does not grow with the number of nulls.
+ * Input order is preserved, so order-sensitive accumulators
+ * (`ExponentialStats`) see the valid values exactly as a filtered copy.
+ *
+ * The values under null slots are never read, so they may hold anything.
+ * A non-null NaN is a value and follows the accumulator's NaN policy.
+ */
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+// Verbatim from the Arrow C data interface specification, which asks
+// consumers to copy these definitions rather than depend on Arrow.
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace fastnum {
+
+/// Outcome of importing an Arrow array.
+enum class arrow_error {
+    none,            ///< Observed successfully.
+    type_mismatch,   ///< Format is not the accumulator's `float` (`"f"`) / `double` (`"g"`).
+    bad_layout,      ///< Not a primitive array (buffers, dictionary, negative sizes), or a
+                     ///< struct column index out of range.
+    length_mismatch, ///< Paired arrays of different lengths.
+    released,        ///< The array's `release` callback is null (already released).
+};
+
+/// Valid runs this long are observed in place; shorter ones are compacted.
+inline constexpr std::size_t arrow_direct_run = 512;
+
+/**
+ * @brief Raw pieces of an Arrow primitive column.
+ *
+ * Element `i` (`i < length`) is `values[offset + i]`, valid iff bit
+ * `offset + i` of `validity` is set (LSB-first bit order); a null `validity`
+ * means no nulls. Buffers are borrowed.
+ */
+template <typename T>
+struct arrow_column {
+    const T* values{nullptr};
+    const std::uint8_t* validity{nullptr};
+    std::size_t offset{0};
+    std::size_t length{0};
+};
+
+/// Arrow format string of `T` (`"f"` for `float`, `"g"` for `double`).
+template <typename T>
+[[nodiscard]] constexpr const char* arrow_format() noexcept {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "Arrow import supports float and double");
+    return std::is_same_v<T, float> ? "f" : "g";
+}
+
+/**
+ * @brief View a C data interface array as an `arrow_column<T>`.
+ *
+ * Checks the layout only; the caller vouches for the type, or uses the
+ * overload taking the `ArrowSchema`.
+ */
+template <typename T>
+[[nodiscard]] arrow_error arrow_import(const ArrowArray& array, arrow_column<T>& out) noexcept {
+    if (!array.release) return arrow_error::released;
+    if (array.n_buffers != 2 || !array.buffers || array.dictionary || array.length < 0 || array.offset < 0) {
+        return arrow_error::bad_layout;
+    }
+    out.values = static_cast<const T*>(array.buffers[1]);
+    if (array.length > 0 && !out.values) return arrow_error::bad_layout;
+    // null_count is -1 when the producer did not compute it.
+    out.validity = array.null_count == 0 ? nullptr : static_cast<const std::uint8_t*>(array.buffers[0]);
+    out.offset = static_cast<std::size_t>(array.offset);
+    out.length = static_cast<std::size_t>(array.length);
+    return arrow_error::none;
+}
+
+/// As above, also checking the schema's format against `T`.
+template <typename T>
+[[nodiscard]] arrow_error arrow_import(const ArrowSchema& schema, const ArrowArray& array,
+                                       arrow_column<T>& out) noexcept {
+    if (!schema.release) return arrow_error::released;
+    if (!schema.format || std::strcmp(schema.format, arrow_format<T>()) != 0) return arrow_error::type_mismatch;
+    return arrow_import(array, out);
+}
+
+/**
+ * @brief View field `field` of a struct array (an exported record batch).
+ *
+ * The parent's offset and length apply on top of the child's own; a parent
+ * with nulls of its own is rejected as `bad_layout`.
+ */
+template <typename T>
+[[nodiscard]] arrow_error arrow_import(const ArrowSchema& schema, const ArrowArray& array, std::size_t field,
+                                       arrow_column<T>& out) noexcept {
+    if (!schema.release || !array.release) return arrow_error::released;
+    if (!schema.format || std::strcmp(schema.format, "+s") != 0 || array.null_count > 0 || array.offset < 0 ||
+        array.length < 0 || schema.n_children != array.n_children || !schema.children || !array.children ||
+        field >= static_cast<std::size_t>(array.n_children) || !schema.children[field] || !array.children[field]) {
+        return arrow_error::bad_layout;
+    }
+    const arrow_error e = arrow_import(*schema.children[field], *array.children[field], out);
+    if (e != arrow_error::none) return e;
+    if (out.length < static_cast<std::size_t>(array.offset + array.length)) return arrow_error::bad_layout;
+    out.offset += static_cast<std::size_t>(array.offset);
+    out.length = static_cast<std::size_t>(array.length);
+    return arrow_error::none;
+}
+
+namespace detail {
+
+/// Validity bits `pos .. pos + m` (m <= 64) as a word, bit k = element `pos + k`.
+/// Reads only the bytes those bits live in.
+[[nodiscard]] inline std::uint64_t validity_word(const std::uint8_t* bits, std::size_t pos, std::size_t m) noexcept {
+    const std::uint8_t* p = bits + pos / 8;
+    const std::size_t shift = pos % 8;
+    const std::size_t bytes = (shift + m + 7) / 8;
+    std::uint64_t w = 0;
+    if (std::endian::native == std::endian::little && bytes >= 8) {
+        std::memcpy(&w, p, 8);
+    } else {
+        const std::size_t k = std::min<std::size_t>(bytes, 8);
+        for (std::size_t j = 0; j < k; ++j) w |= static_cast<std::uint64_t>(p[j]) << (8 * j);
+    }
+    w >>= shift;
+    if (bytes == 9) w |= static_cast<std::uint64_t>(p[8]) << (64 - shift);
+    return m == 64 ? w : w & ((std::uint64_t{1} << m) - 1);
+}
+
+/**
+ * @brief Call `run(begin, end)` for every maximal run of valid elements in
+ *        `[0, n)`, in order. `word(i, m)` returns the validity of elements
+ *        `i .. i + m` (m <= 64) as bits.
+ */
+template <class Word, class Run>
+void for_each_valid_run(std::size_t n, Word word, Run run) {
+    constexpr std::size_t none = static_cast<std::size_t>(-1);
+    std::size_t start = none;
+    for (std::size_t i = 0; i < n; i += 64) {
+        const std::size_t m = std::min<std::size_t>(64, n - i);
+        const std::uint64_t w = word(i, m);
+        if (m == 64 && w == ~std::uint64_t{0}) {
+            if (start == none) start = i;
+            continue;
+        }
+        if (w == 0) {
+            if (start != none) run(start, i);
+            start = none;
+            continue;
+        }
+        for (std::size_t p = 0; p < m;) {
+            const std::uint64_t rest = w >> p;
+            if (rest & 1) {
+                if (start == none) start = i + p;
+                p += static_cast<std::size_t>(std::countr_one(rest));
+            } else {
+                if (start != none) run(start, i + p);
+                start = none;
+                p += rest == 0 ? m - p : static_cast<std::size_t>(std::countr_zero(rest));
+            }
+        }
+    }
+    if (start != none) run(start, n);
+}
+
+/**
+ * @brief Feed valid runs to `direct(begin, end)` when long, otherwise copy
+ *        them through `stage(begin, end, slot)` into a block that
+ *        `flush(count)` observes; block and direct calls keep input order.
+ */
+template <std::size_t Block, class Word, class Direct, class Stage, class Flush>
+void observe_valid_runs(std::size_t n, Word word, Direct direct, Stage stage, Flush flush) {
+    std::size_t staged = 0;
+    for_each_valid_run(n, word, [&](std::size_t b, std::size_t e) {
+        if (e - b >= arrow_direct_run) {
+            if (staged > 0) flush(staged);
+            staged = 0;
+            direct(b, e);
+            return;
+        }
+        while (b < e) {
+            const std::size_t k = std::min(e - b, Block - staged);
+            stage(b, b + k, staged);
+            staged += k;
+            b += k;
+            if (staged == Block) {
+                flush(staged);
+                staged = 0;
+            }
+        }
+    });
+    if (staged > 0) flush(staged);
+}
+
+inline constexpr std::size_t arrow_stage_block = 1024;
+
+} // namespace detail
+
+/**
+ * @brief Batch-observe the valid values of `col` into `acc`.
+ *
+ * `Acc` needs a batch `observe(const T*, n)`: `RunningStats`,
+ * `OnlineStandardScaler`, `RunningMoments`, `Histogram`, ...
+ */
+template <class Acc, typename T>
+void observe_arrow(Acc& acc, const arrow_column<T>& col) noexcept {
+    if (col.length == 0 || !col.values) return;
+    const T* xs = col.values + col.offset;
+    if (!col.validity) {
+        acc.observe(xs, col.length);
+        return;
+    }
+    T block[detail::arrow_stage_block];
+    detail::observe_valid_runs<detail::arrow_stage_block>(
+        col.length,
+        [&col](std::size_t i, std::size_t m) { return detail::validity_word(col.validity, col.offset + i, m); },
+        [&](std::size_t b, std::size_t e) { acc.observe(xs + b, e - b); },
+        [&](std::size_t b, std::size_t e, std::size_t slot) { std::copy(xs + b, xs + e, block + slot); },
+        [&](std::size_t k) { acc.observe(block, k); });
+}
+
+/**
+ * @brief Batch-observe the pairs of `x` and `y` where both are valid.
+ *
+ * `Acc` needs a paired batch `observe(const T* xs, const T* ys, n)`, e.g.
+ * `OnlineCovariance`. The columns may have different offsets and bitmaps.
+ */
+template <class Acc, typename T>
+arrow_error observe_arrow(Acc& acc, const arrow_column<T>& x, const arrow_column<T>& y) noexcept {
+    if (x.length != y.length) return arrow_error::length_mismatch;
+    if (x.length == 0) return arrow_error::none;
+    if (!x.values || !y.values) return arrow_error::bad_layout;
+    const T* xs = x.values + x.offset;
+    const T* ys = y.values + y.offset;
+    if (!x.validity && !y.validity) {
+        acc.observe(xs, ys, x.length);
+        return arrow_error::none;
+    }
+    const auto bits = [](const arrow_column<T>& c, std::size_t i, std::size_t m) {
+        return c.validity ? detail::validity_word(c.validity, c.offset + i, m)
+                          : (m == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << m) - 1);
+    };
+    constexpr std::size_t B = detail::arrow_stage_block / 2;
+    T bx[B];
+    T by[B];
+    detail::observe_valid_runs<B>(
+        x.length,
+        [&](std::size_t i, std::size_t m) { return bits(x, i, m) & bits(y, i, m); },
+        [&](std::size_t b, std::size_t e) { acc.observe(xs + b, ys + b, e - b); },
+        [&](std::size_t b, std::size_t e, std::size_t slot) {
+            std::copy(xs + b, xs + e, bx + slot);
+            std::copy(ys + b, ys + e, by + slot);
+        },
+        [&](std::size_t k) { acc.observe(bx, by, k); });
+    return arrow_error::none;
+}
+
+/// Observe a C data interface array, checking its schema against `Acc::value_type`.
+template <class Acc>
+arrow_error observe_arrow(Acc& acc, const ArrowSchema& schema, const ArrowArray& array) noexcept {
+    arrow_column<typename Acc::value_type> col;
+    const arrow_error e = arrow_import(schema, array, col);
+    if (e == arrow_error::none) observe_arrow(acc, col);
+    return e;
+}
+
+/// Observe fields `fx` and `fy` of a struct array (record batch) as pairs.
+template <class Acc>
+arrow_error observe_arrow(Acc& acc, const ArrowSchema& schema, const ArrowArray& batch, std::size_t fx,
+                          std::size_t fy) noexcept {
+    arrow_column<typename Acc::value_type> x, y;
+    arrow_error e = arrow_import(schema, batch, fx, x);
+    if (e == arrow_error::none) e = arrow_import(schema, batch, fy, y);
+    if (e == arrow_error::none) e = observe_arrow(acc, x, y);
+    return e;
+}
+
+} // namespace fastnum
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <fastnum/running_stats.hpp>
+#include <fastnum/online_covariance.hpp>
+
+namespace fastnum {
+
+namespace detail {
+
+template <class Acc, class = void>
+struct observes_pairs : std::false_type {};
+
+template <class Acc>
+struct observes_pairs<Acc, std::void_t<decltype(std::declval<Acc&>().observe_interleaved(
+                               std::declval<const typename Acc::value_type*>(), std::size_t{}))>>
+    : std::true_type {};
+
+} // namespace detail
+
+/**
+ * @brief Micro-batching front end for callers that produce one value at a time.
+ *
+ * `observe(x)` appends to an inline buffer of `N` values; the buffer goes
+ * through the accumulator's batch (SIMD) kernel when it fills up and before
+ * every query, so per-event producers get close to batch throughput without
+ * being restructured. Results are those of observing the buffered values as
+ * one batch, i.e. equal to scalar observes up to roundoff.
+ *
+ * Pair accumulators (those with `observe_interleaved`, e.g.
+ * `OnlineCovariance`) take `observe(x, y)` and buffer interleaved pairs.
+ *
+ * ## Queries
+ * `get()` and `->` flush and expose the wrapped accumulator; `count()`,
+ * `mean()`, `variance_*()`, `ready()` and `transform(x)` are forwarded
+ * directly when `Acc` has them. Queries are `const` but flush, so a
+ * `Buffered` must not be shared between threads, not even for reading.
+ *
+ * ## Notes
+ * - No heap allocation: the buffer is `N * sizeof(T)` bytes (twice that for
+ *   pairs) inside the object.
+ * - Instrumentation hooks of `Acc` see one batch observe per flush.
+ * - Batch `observe(xs, n)` flushes first and forwards, keeping input order.
+ *
+ * @tparam Acc Accumulator with `value_type` and a batch `observe(const T*, n)`
+ *             (or `observe_interleaved(const T*, n)` for pairs).
+ * @tparam N   Buffered values (pairs) before a forced flush.
+ */
+template <class Acc, std::size_t N = 256>
+class Buffered {
+    static_assert(N > 0, "Buffered needs a non-empty buffer");
+
+    using T = typename Acc::value_type;
+    static constexpr std::size_t arity = detail::observes_pairs<Acc>::value ? 2 : 1;
+
+public:
+    using accumulator_type = Acc;
+    using value_type = T;
+
+    /// Values (pairs) held before a forced flush.
+    static constexpr std::size_t capacity = N;
+
+    constexpr Buffered() = default;
+
+    /// Start from a pre-configured (or pre-fitted) accumulator.
+    explicit constexpr Buffered(const Acc& acc) noexcept : acc_(acc) {}
+
+    // --- Observe -------------------------------------------------------------
+
+    template <class A = Acc, std::enable_if_t<!detail::observes_pairs<A>::value, int> = 0>
+    void observe(T x) noexcept {
+        buf_[pending_] = x;
+        if (++pending_ == N) flush();
+    }
+
+    template <class A = Acc, std::enable_if_t<detail::observes_pairs<A>::value, int> = 0>
+    void observe(T x, T y) noexcept {
+        buf_[2 * pending_] = x;
+        buf_[2 * pending_ + 1] = y;
+        if (++pending_ == N) flush();
+    }
+
+    /// Flush, then forward anything else (a batch such as `observe(xs, n)`,
+    /// a weighted `observe(x, w)`, ...) to the accumulator.
+    template <class... Args,
+              std::enable_if_t<!(sizeof...(Args) == arity && (std::is_arithmetic_v<std::decay_t<Args>> && ...)),
+                               int> = 0>
+    auto observe(Args&&... args) noexcept
+        -> decltype(std::declval<Acc&>().observe(std::forward<Args>(args)...), void()) {
+        flush();
+        acc_.observe(std::forward<Args>(args)...);
+    }
+
+    /// Push buffered values into the accumulator.
+    void flush() const noexcept {
+        if (pending_ == 0) return;
+        if constexpr (arity == 2) {
+            acc_.observe_interleaved(buf_, pending_);
+        } else {
+            acc_.observe(buf_, pending_);
+        }
+        pending_ = 0;
+    }
+
+    /// Values (pairs) waiting in the buffer.
+    [[nodiscard]] std::size_t pending() const noexcept { return pending_; }
+
+    void reset() noexcept {
+        pending_ = 0;
+        acc_.reset();
+    }
+
+    void merge(const Buffered& other) noexcept { get().merge(other.get()); }
+
+    // --- Queries -------------------------------------------------------------
+
+    /// The wrapped accumulator, with every buffered value applied.
+    [[nodiscard]] const Acc& get() const noexcept {
+        flush();
+        return acc_;
+    }
+
+    [[nodiscard]] Acc& get() noexcept {
+        flush();
+        return acc_;
+    }
+
+    [[nodiscard]] const Acc* operator->() const noexcept { return &get(); }
+    [[nodiscard]] Acc* operator->() noexcept { return &get(); }
+
+    template <class A = Acc>
+    [[nodiscard]] auto count() const noexcept -> decltype(std::declval<const A&>().count()) {
+        return get().count();
+    }
+
+    template <class A = Acc>
+    [[nodiscard]] auto mean() const noexcept -> decltype(std::declval<const A&>().mean()) {
+        return get().mean();
+    }
+
+    template <class A = Acc>
+    [[nodiscard]] auto variance_population() const noexcept
+        -> decltype(std::declval<const A&>().variance_population()) {
+        return get().variance_population();
+    }
+
+    template <class A = Acc>
+    [[nodiscard]] auto variance_sample() const noexcept -> decltype(std::declval<const A&>().variance_sample()) {
+        return get().variance_sample();
+    }
+
+    template <class A = Acc>
+    [[nodiscard]] auto ready() const noexcept -> decltype(std::declval<const A&>().ready()) {
+        return get().ready();
+    }
+
+    template <class A = Acc>
+    [[nodiscard]] auto transform(T x) const noexcept -> decltype(std::declval<const A&>().transform(x)) {
+        return get().transform(x);
+    }
+
+private:
+    mutable Acc acc_{};
+    mutable std::size_t pending_{0};
+    mutable T buf_[N * arity];
+};
+
+/// Micro-batched `RunningStats`.
+template <typename T = double, std::size_t N = 256>
+using BufferedRunningStats = Buffered<RunningStats<T>, N>;
+
+/// Micro-batched `OnlineCovariance` (`observe(x, y)`).
+template <typename T = double, std::size_t N = 256>
+using BufferedCovariance = Buffered<OnlineCovariance<T>, N>;
+
+} // namespace fastnum
@@ -0,0 +1,468 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fastnum/detail/parallel.hpp>
+
+// Memory mapping is POSIX-only; elsewhere every open reports `unsupported`.
+#if defined(__unix__) || defined(__APPLE__)
+#  define FASTNUM_HAS_MMAP 1
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace fastnum {
+
+/**
+ * @file
+ * @brief Zero-copy, out-of-core fitting from memory-mapped column files.
+ *
+ * Two on-disk layouts are read:
+ *
+ * - **raw**: a bare little-endian array of `T`, one column, no header.
+ * - **fastnum column file**: a 32-byte `column_file_header` followed, at
+ *   `data_offset`, by `columns` contiguous little-endian columns of `rows`
+ *   values each (column-major, no gaps):
+ *
+ * | offset | size | field                                      |
+ * |--------|------|--------------------------------------------|
+ * | 0      | 4    | magic `"FNCF"`                             |
+ * | 4      | 2    | format version (`column_format_version`)   |
+ * | 6      | 1    | `sizeof(T)` of the values                  |
+ * | 7      | 1    | reserved (0)                               |
+ * | 8      | 4    | column count                               |
+ * | 12     | 4    | reserved (0)                               |
+ * | 16     | 8    | rows per column                            |
+ * | 24     | 8    | byte offset of column 0                    |
+ *
+ * `write_column_file` places column 0 on a page boundary
+ * (`column_file_alignment`).
+ *
+ * The `observe_column` family walks a mapped column in page-aligned chunks
+ * straight into an accumulator's batch `observe`: the next chunk is hinted
+ * with `MADV_WILLNEED` while the current one is reduced, and consumed pages
+ * are released with `MADV_DONTNEED`, so the resident set stays at a few
+ * chunks no matter how large the file is. Nothing is copied.
+ */
+
+/// Layout version written by `write_column_file`; readers reject any other version.
+inline constexpr std::uint16_t column_format_version = 1;
+
+/// Offset of column 0 in files written by `write_column_file`.
+inline constexpr std::size_t column_file_alignment = 4096;
+
+/// Outcome of opening or writing a column file.
+enum class column_error {
+    none,          ///< Opened (or written) successfully.
+    open_failed,   ///< The file could not be opened, stat'ed or created.
+    map_failed,    ///< `mmap` failed.
+    truncated,     ///< File smaller than its header announces, or not a whole number of values.
+    bad_magic,     ///< Not a fastnum column file.
+    bad_version,   ///< Written by an incompatible format version.
+    type_mismatch, ///< Values are not `sizeof(T)` bytes.
+    write_failed,  ///< Short write while creating a file.
+    unsupported,   ///< No `mmap` on this platform, or a big-endian host.
+};
+
+/// Layout of the raw file on disk.
+enum class column_format {
+    fastnum, ///< `column_file_header` followed by the columns.
+    raw,     ///< Headerless single column.
+};
+
+struct column_file_header {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint8_t scalar_bytes;
+    std::uint8_t reserved0;
+    std::uint32_t columns;
+    std::uint32_t reserved1;
+    std::uint64_t rows;
+    std::uint64_t data_offset;
+
+    static constexpr std::uint32_t magic_value = 0x46434E46u; // "FNCF" read as little-endian
+};
+static_assert(sizeof(column_file_header) == 32 && std::is_trivially_copyable_v<column_file_header>);
+
+/**
+ * @brief Chunking knobs for the `observe_column` family.
+ *
+ * - `chunk_bytes`: bytes of one column per batch `observe` call, rounded up
+ *   to whole pages. Large enough to amortize the `madvise` calls, small
+ *   enough that the chunks in flight stay cache / RSS friendly.
+ * - `threads`: `1` streams on the caller; more (`0` = hardware threads)
+ *   splits the rows into contiguous ranges, each streamed into its own
+ *   `Acc` and combined with a pairwise `merge` tree.
+ * - `min_chunk`: smallest number of rows handed to one thread.
+ * - `drop_behind`: release consumed pages (`MADV_DONTNEED`). Turn off when
+ *   the same mapping is about to be read again.
+ */
+struct column_stream_options {
+    std::size_t chunk_bytes{std::size_t{4} << 20};
+    std::size_t threads{1};
+    std::size_t min_chunk{std::size_t{1} << 20};
+    bool drop_behind{true};
+};
+
+namespace detail {
+
+[[nodiscard]] inline std::size_t page_size() noexcept {
+#if defined(FASTNUM_HAS_MMAP)
+    static const std::size_t page = [] {
+        const long p = ::sysconf(_SC_PAGESIZE);
+        return p > 0 ? static_cast<std::size_t>(p) : std::size_t{4096};
+    }();
+    return page;
+#else
+    return 4096;
+#endif
+}
+
+/// Read-only, move-only mapping of a whole file.
+class file_mapping {
+public:
+    file_mapping() = default;
+    file_mapping(const file_mapping&) = delete;
+    file_mapping& operator=(const file_mapping&) = delete;
+
+    file_mapping(file_mapping&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+    file_mapping& operator=(file_mapping&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~file_mapping() { unmap(); }
+
+    /// Map `path`; an empty file maps to `data() == nullptr, size() == 0`.
+    [[nodiscard]] column_error open(const char* path) noexcept {
+        unmap();
+#if defined(FASTNUM_HAS_MMAP)
+        if (!path) return column_error::open_failed;
+        const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return column_error::open_failed;
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || st.st_size < 0) {
+            ::close(fd);
+            return column_error::open_failed;
+        }
+        const auto size = static_cast<std::size_t>(st.st_size);
+        if (size != 0) {
+            void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                return column_error::map_failed;
+            }
+            data_ = static_cast<const unsigned char*>(p);
+            size_ = size;
+            // Wider read-ahead; the chunk loop adds WILLNEED / DONTNEED on top.
+            advise(0, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd); // the mapping keeps the file referenced
+        return column_error::none;
+#else
+        (void)path;
+        return column_error::unsupported;
+#endif
+    }
+
+    [[nodiscard]] const unsigned char* data() const noexcept { return data_; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /// `madvise` on the whole pages inside `[begin, end)` (byte offsets);
+    /// pages shared with neighbouring ranges are left alone.
+    void advise_inner(std::size_t begin, std::size_t end, int advice) const noexcept {
+        const std::size_t page = page_size();
+        begin = (begin + page - 1) / page * page;
+        end = std::min(end, size_) / page * page;
+        if (begin < end) advise(begin, end, advice);
+    }
+
+    /// `madvise` on every page touching `[begin, end)`.
+    void advise_outer(std::size_t begin, std::size_t end, int advice) const noexcept {
+        const std::size_t page = page_size();
+        begin = begin / page * page;
+        end = std::min((end + page - 1) / page * page, size_);
+        if (begin < end) advise(begin, end, advice);
+    }
+
+private:
+    void advise([[maybe_unused]] std::size_t begin, [[maybe_unused]] std::size_t end,
+                [[maybe_unused]] int advice) const noexcept {
+#if defined(FASTNUM_HAS_MMAP)
+        // Purely a hint: failures change performance, never results.
+        (void)::madvise(const_cast<unsigned char*>(data_) + begin, end - begin, advice);
+#endif
+    }
+
+    void unmap() noexcept {
+#if defined(FASTNUM_HAS_MMAP)
+        if (data_) ::munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const unsigned char* data_{nullptr};
+    std::size_t size_{0};
+};
+
+#if defined(FASTNUM_HAS_MMAP)
+inline constexpr int advice_willneed = MADV_WILLNEED;
+inline constexpr int advice_dontneed = MADV_DONTNEED;
+#else
+inline constexpr int advice_willneed = 0;
+inline constexpr int advice_dontneed = 0;
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Memory-mapped, read-only view of a column file.
+ *
+ * Construction maps and validates the file; `error()` tells whether that
+ * worked. Columns are exposed in place as `std::span<const T>` over the
+ * mapping, valid as long as the `column_file` lives. Move-only.
+ *
+ * @tparam T `float` or `double`, matching the file's value width.
+ */
+template <typename T>
+class column_file {
+    static_assert(std::is_floating_point_v<T>, "column_file requires floating point T");
+
+public:
+    using value_type = T;
+
+    column_file() = default;
+
+    explicit column_file(const char* path, column_format format = column_format::fastnum) noexcept {
+        if constexpr (std::endian::native != std::endian::little) {
+            (void)path;
+            (void)format;
+            error_ = column_error::unsupported;
+        } else {
+            error_ = map_.open(path);
+            if (error_ == column_error::none) error_ = validate(format);
+            if (error_ != column_error::none) {
+                map_ = detail::file_mapping{};
+                rows_ = columns_ = offset_ = 0;
+            }
+        }
+    }
+
+    [[nodiscard]] column_error error() const noexcept { return error_; }
+    [[nodiscard]] bool ok() const noexcept { return error_ == column_error::none; }
+
+    /// Values per column (0 unless `ok()`).
+    [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+    [[nodiscard]] std::size_t columns() const noexcept { return columns_; }
+
+    /// Column `c` (`c < columns()`) in place.
+    [[nodiscard]] std::span<const T> column(std::size_t c) const noexcept {
+        if (rows_ == 0) return {};
+        return {reinterpret_cast<const T*>(map_.data() + column_offset(c)), rows_};
+    }
+
+    /// The underlying mapping, for chunk hints.
+    [[nodiscard]] const detail::file_mapping& mapping() const noexcept { return map_; }
+
+    /// Byte offset of row 0 of column `c` within the file.
+    [[nodiscard]] std::size_t column_offset(std::size_t c) const noexcept {
+        return offset_ + c * rows_ * sizeof(T);
+    }
+
+private:
+    column_error validate(column_format format) noexcept {
+        const std::size_t size = map_.size();
+        if (format == column_format::raw) {
+            if (size % sizeof(T) != 0) return column_error::truncated;
+            rows_ = size / sizeof(T);
+            columns_ = 1;
+            offset_ = 0;
+            return column_error::none;
+        }
+
+        if (size < sizeof(column_file_header)) return column_error::truncated;
+        column_file_header h;
+        std::memcpy(&h, map_.data(), sizeof h);
+        if (h.magic != column_file_header::magic_value) return column_error::bad_magic;
+        if (h.version != column_format_version) return column_error::bad_version;
+        if (h.scalar_bytes != sizeof(T)) return column_error::type_mismatch;
+        // Values must be aligned in the (page-aligned) mapping to be used in place.
+        if (h.data_offset < sizeof h || h.data_offset % sizeof(T) != 0 || h.data_offset > size) {
+            return column_error::truncated;
+        }
+        const std::size_t avail = (size - static_cast<std::size_t>(h.data_offset)) / sizeof(T);
+        if (h.columns != 0 && h.rows > avail / h.columns) return column_error::truncated;
+
+        rows_ = h.columns == 0 ? 0 : static_cast<std::size_t>(h.rows);
+        columns_ = h.columns;
+        offset_ = static_cast<std::size_t>(h.data_offset);
+        return column_error::none;
+    }
+
+    detail::file_mapping map_{};
+    column_error error_{column_error::open_failed};
+    std::size_t rows_{0};
+    std::size_t columns_{0};
+    std::size_t offset_{0};
+};
+
+/**
+ * @brief Write `n_columns` columns of `rows` values as a fastnum column file.
+ *
+ * Column `c` is read from `columns[c][0..rows)`. Column 0 starts at
+ * `column_file_alignment`.
+ */
+template <typename T>
+column_error write_column_file(const char* path, const T* const* columns, std::size_t n_columns,
+                               std::size_t rows) noexcept {
+    static_assert(std::is_floating_point_v<T>, "write_column_file requires floating point T");
+    if constexpr (std::endian::native != std::endian::little) {
+        (void)path, (void)columns, (void)n_columns, (void)rows;
+        return column_error::unsupported;
+    } else {
+        if (!path || (n_columns > 0 && rows > 0 && !columns) || n_columns > UINT32_MAX) {
+            return column_error::open_failed;
+        }
+        std::FILE* f = std::fopen(path, "wb");
+        if (!f) return column_error::open_failed;
+
+        column_file_header h{};
+        h.magic = column_file_header::magic_value;
+        h.version = column_format_version;
+        h.scalar_bytes = static_cast<std::uint8_t>(sizeof(T));
+        h.columns = static_cast<std::uint32_t>(n_columns);
+        h.rows = rows;
+        h.data_offset = column_file_alignment;
+
+        unsigned char pad[column_file_alignment] = {};
+        std::memcpy(pad, &h, sizeof h);
+        bool ok = std::fwrite(pad, 1, sizeof pad, f) == sizeof pad;
+        for (std::size_t c = 0; ok && c < n_columns && rows > 0; ++c) {
+            ok = columns[c] && std::fwrite(columns[c], sizeof(T), rows, f) == rows;
+        }
+        ok = std::fclose(f) == 0 && ok;
+        return ok ? column_error::none : column_error::write_failed;
+    }
+}
+
+namespace detail {
+
+/**
+ * @brief Run `fn(r0, r1)` over `[begin, end)` rows in chunks of `chunk` rows,
+ *        hinting the next chunk and releasing consumed pages of the columns
+ *        whose byte offsets are in `offsets`.
+ */
+template <typename T, std::size_t K, class Fn>
+void stream_rows(const file_mapping& map, const std::size_t (&offsets)[K], std::size_t begin,
+                 std::size_t end, std::size_t chunk, bool drop_behind, Fn&& fn) noexcept {
+    const auto bytes = [](std::size_t r) { return r * sizeof(T); };
+    for (std::size_t r = begin; r < end;) {
+        const std::size_t next = std::min(end, r + chunk);
+        if (next < end) {
+            for (std::size_t off : offsets) {
+                map.advise_outer(off + bytes(next), off + bytes(std::min(end, next + chunk)), advice_willneed);
+            }
+        }
+        fn(r, next);
+        if (drop_behind) {
+            // Whole pages only, so a neighbouring thread's or column's rows
+            // sharing a page are never dropped under it. Starting one page
+            // back catches the page straddling the previous chunk boundary.
+            const std::size_t from = r - std::min(r - begin, page_size() / sizeof(T));
+            for (std::size_t off : offsets) map.advise_inner(off + bytes(from), off + bytes(next), advice_dontneed);
+        }
+        r = next;
+    }
+}
+
+/// Rows per chunk: `chunk_bytes` rounded up to whole pages of `T`.
+template <typename T>
+[[nodiscard]] std::size_t chunk_rows(std::size_t chunk_bytes) noexcept {
+    const std::size_t page = page_size();
+    const std::size_t bytes = std::max<std::size_t>((chunk_bytes + page - 1) / page, 1) * page;
+    return std::max<std::size_t>(bytes / sizeof(T), 1);
+}
+
+template <class Acc, typename T, std::size_t K, class Observe>
+void observe_mapped(Acc& acc, const column_file<T>& f, const std::size_t (&offsets)[K],
+                    const column_stream_options& opt, Observe observe) {
+    const std::size_t n = f.rows();
+    if (n == 0) return;
+    const std::size_t chunk = chunk_rows<T>(opt.chunk_bytes);
+
+    // Order-sensitive accumulators (decayed state) always stream serially.
+    const std::size_t parts_n = order_sensitive_v<Acc> ? 1 : chunk_count(n, opt.threads, opt.min_chunk);
+    if (parts_n == 1) {
+        stream_rows<T>(f.mapping(), offsets, 0, n, chunk, opt.drop_behind,
+                       [&](std::size_t r0, std::size_t r1) { observe(acc, r0, r1); });
+        return;
+    }
+
+    std::vector<Acc> parts(parts_n, empty_like(acc));
+    parallel_chunks(n, opt.threads, opt.min_chunk, [&](std::size_t begin, std::size_t end, std::size_t c) {
+        stream_rows<T>(f.mapping(), offsets, begin, end, chunk, opt.drop_behind,
+                       [&](std::size_t r0, std::size_t r1) { observe(parts[c], r0, r1); });
+    });
+    tree_merge(parts.data(), parts_n);
+    acc.merge(parts[0]);
+}
+
+} // namespace detail
+
+/**
+ * @brief Fit `acc` on column `c` of a mapped file.
+ *
+ * Works with any accumulator with a batch `observe(const T*, n)` (and
+ * `merge` / `reset` when `opt.threads != 1`): `RunningStats`,
+ * `OnlineStandardScaler`, `RunningMoments`, `QuantileSketch`, `Histogram`, ...
+ * `acc` may already hold state. Threads fit empty copies of `acc` (so its
+ * configuration carries over), merged at the end; order-sensitive
+ * accumulators such as `ExponentialStats` are always streamed on the calling
+ * thread. The result equals one batch `observe` of the whole column up to
+ * roundoff.
+ *
+ * Allocates only when fitting in parallel (one `Acc` per thread).
+ */
+template <class Acc, typename T>
+void observe_column(Acc& acc, const column_file<T>& f, std::size_t c, const column_stream_options& opt = {}) {
+    if (!f.ok() || c >= f.columns()) return;
+    const T* xs = f.column(c).data();
+    const std::size_t offsets[1] = {f.column_offset(c)};
+    detail::observe_mapped(acc, f, offsets, opt,
+                           [xs](Acc& a, std::size_t r0, std::size_t r1) { a.observe(xs + r0, r1 - r0); });
+}
+
+/**
+ * @brief Fit a paired accumulator (`observe(xs, ys, n)`, e.g.
+ *        `OnlineCovariance`) on columns `cx` and `cy` of a mapped file.
+ */
+template <class Acc, typename T>
+void observe_columns(Acc& acc, const column_file<T>& f, std::size_t cx, std::size_t cy,
+                     const column_stream_options& opt = {}) {
+    if (!f.ok() || cx >= f.columns() || cy >= f.columns()) return;
+    const T* xs = f.column(cx).data();
+    const T* ys = f.column(cy).data();
+    const std::size_t offsets[2] = {f.column_offset(cx), f.column_offset(cy)};
+    detail::observe_mapped(acc, f, offsets, opt, [xs, ys](Acc& a, std::size_t r0, std::size_t r1) {
+        a.observe(xs + r0, ys + r0, r1 - r0);
+    });
+}
+
+} // namespace fastnum
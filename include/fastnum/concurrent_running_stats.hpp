@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fastnum/running_stats.hpp>
+#include <fastnum/online_covariance.hpp>
+#include <fastnum/detail/parallel.hpp>
+#include <fastnum/detail/seqlock.hpp>
+
+namespace fastnum {
+
+/**
+ * @brief Multi-writer accumulator built from per-writer shards.
+ *
+ * Each writer thread owns one shard exclusively for as long as it holds a
+ * `writer` handle, so updates never take a lock and never share a cache line
+ * with another writer (shards are padded to `shard_alignment` bytes, which
+ * also covers adjacent-line prefetching on x86).
+ *
+ * A writer keeps its working state privately and, after every update,
+ * publishes a copy into its shard under a sequence lock. `snapshot()` reads
+ * each shard optimistically (retrying only if it raced with that shard's
+ * writer) and combines the copies with `Acc::merge()`, so readers never block
+ * writers and writers never wait for readers.
+ *
+ * ## Usage
+ * - Create at most `shards()` concurrent writers; `make_writer()` waits for a
+ *   free shard otherwise, `try_make_writer()` returns `std::nullopt`.
+ * - State written through a shard survives the writer handle: the next writer
+ *   of that shard continues from it.
+ * - `snapshot()` may be called from any thread at any time.
+ * - `reset()` must not run concurrently with live writers.
+ *
+ * @tparam Acc Trivially copyable accumulator with `merge(const Acc&)`
+ *             (e.g. `RunningStats<T>`, `OnlineCovariance<T>`).
+ */
+template <class Acc>
+class ShardedAccumulator {
+    static_assert(std::is_trivially_copyable_v<Acc>, "ShardedAccumulator requires a trivially copyable Acc");
+
+public:
+    static constexpr std::size_t shard_alignment = 128;
+
+    class writer {
+    public:
+        writer(writer&& other) noexcept
+            : owner_(std::exchange(other.owner_, nullptr)), shard_(other.shard_), acc_(other.acc_) {}
+
+        writer& operator=(writer&& other) noexcept {
+            if (this != &other) {
+                release();
+                owner_ = std::exchange(other.owner_, nullptr);
+                shard_ = other.shard_;
+                acc_ = other.acc_;
+            }
+            return *this;
+        }
+
+        writer(const writer&) = delete;
+        writer& operator=(const writer&) = delete;
+
+        ~writer() { release(); }
+
+        /// Forwards to any `Acc::observe` overload (scalar or batch), then publishes.
+        template <class... Args>
+        auto observe(Args&&... args) noexcept
+            -> decltype(std::declval<Acc&>().observe(std::forward<Args>(args)...), void()) {
+            acc_.observe(std::forward<Args>(args)...);
+            owner_->publish(shard_, acc_);
+        }
+
+        /// Fold an externally computed partial state into this shard.
+        void merge(const Acc& other) noexcept {
+            acc_.merge(other);
+            owner_->publish(shard_, acc_);
+        }
+
+        /// This writer's shard state (not the global aggregate).
+        [[nodiscard]] const Acc& local() const noexcept { return acc_; }
+
+    private:
+        friend class ShardedAccumulator;
+
+        writer(ShardedAccumulator* owner, std::size_t shard) noexcept
+            : owner_(owner), shard_(shard), acc_(owner->read(shard)) {}
+
+        void release() noexcept {
+            if (owner_) owner_->shards_[shard_].owned.store(false, std::memory_order_release);
+            owner_ = nullptr;
+        }
+
+        ShardedAccumulator* owner_;
+        std::size_t shard_;
+        Acc acc_;
+    };
+
+    /// `shards == 0` uses `std::thread::hardware_concurrency()`.
+    explicit ShardedAccumulator(std::size_t shards = 0)
+        : n_shards_(detail::resolve_threads(shards)), shards_(new shard[n_shards_]) {
+        for (std::size_t i = 0; i < n_shards_; ++i) publish(i, Acc{});
+    }
+
+    [[nodiscard]] std::size_t shards() const noexcept { return n_shards_; }
+
+    /// Claim a free shard, or `std::nullopt` if all are owned.
+    [[nodiscard]] std::optional<writer> try_make_writer() noexcept {
+        const std::size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        for (std::size_t k = 0; k < n_shards_; ++k) {
+            const std::size_t i = (start + k) % n_shards_;
+            bool expected = false;
+            if (!shards_[i].owned.load(std::memory_order_relaxed) &&
+                shards_[i].owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return writer(this, i);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// Claim a free shard, yielding until one becomes available.
+    [[nodiscard]] writer make_writer() noexcept {
+        for (;;) {
+            if (auto w = try_make_writer()) return std::move(*w);
+            std::this_thread::yield();
+        }
+    }
+
+    /// Consistent merge of every shard's latest published state.
+    [[nodiscard]] Acc snapshot() const {
+        std::vector<Acc> parts(n_shards_);
+        for (std::size_t i = 0; i < n_shards_; ++i) parts[i] = read(i);
+        detail::tree_merge(parts.data(), n_shards_);
+        return parts[0];
+    }
+
+    /// Clear every shard. Not safe while writers exist.
+    void reset() noexcept {
+        for (std::size_t i = 0; i < n_shards_; ++i) publish(i, Acc{});
+    }
+
+private:
+    struct alignas(shard_alignment) shard {
+        detail::seqlock_cell<Acc> state;
+        std::atomic<bool> owned{false};
+    };
+
+    // Single writer per shard: the owning handle (or the constructor/reset).
+    void publish(std::size_t i, const Acc& acc) noexcept { shards_[i].state.publish(acc); }
+
+    [[nodiscard]] Acc read(std::size_t i) const noexcept { return shards_[i].state.read(); }
+
+    std::size_t n_shards_;
+    std::unique_ptr<shard[]> shards_;
+};
+
+/// Lock-free multi-writer `RunningStats`.
+template <typename T = double>
+using ConcurrentRunningStats = ShardedAccumulator<RunningStats<T>>;
+
+/// Lock-free multi-writer `OnlineCovariance`.
+template <typename T = double>
+using ConcurrentCovariance = ShardedAccumulator<OnlineCovariance<T>>;
+
+} // namespace fastnum
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace fastnum::detail {
+
+/// `0` means "one per hardware thread"; never returns 0.
+inline std::size_t resolve_threads(std::size_t requested) noexcept {
+    if (requested != 0) return requested;
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<std::size_t>(hw);
+}
+
+/// Number of chunks `parallel_chunks` will use for the same arguments.
+inline std::size_t chunk_count(std::size_t n, std::size_t threads, std::size_t min_chunk) noexcept {
+    if (n == 0) return 0;
+    min_chunk = std::max<std::size_t>(min_chunk, 1);
+    const std::size_t max_chunks = n / min_chunk;
+    return std::max<std::size_t>(1, std::min(resolve_threads(threads), max_chunks));
+}
+
+/// Accumulators whose state depends on the order of the samples (e.g.
+/// exponentially decayed ones) declare `static constexpr bool order_sensitive
+/// = true`; chunked fits cannot reproduce their serial result.
+template <class Acc, class = void>
+inline constexpr bool order_sensitive_v = false;
+
+template <class Acc>
+inline constexpr bool order_sensitive_v<Acc, std::void_t<decltype(Acc::order_sensitive)>> = Acc::order_sensitive;
+
+/// Empty accumulator configured like `acc` (sketch `k`, histogram range, ...),
+/// to seed the per-chunk partial states.
+template <class Acc>
+[[nodiscard]] Acc empty_like(const Acc& acc) {
+    Acc part = acc;
+    part.reset();
+    return part;
+}
+
+/**
+ * @brief Merge `parts[1..count)` into `parts[0]` with a pairwise (balanced) tree.
+ *
+ * Each level merges partials of similar size, which keeps the rounding error
+ * growth logarithmic in `count` instead of linear as with a left fold.
+ */
+template <class Acc>
+void tree_merge(Acc* parts, std::size_t count) noexcept {
+    for (std::size_t stride = 1; stride < count; stride *= 2) {
+        for (std::size_t i = 0; i + stride < count; i += 2 * stride) {
+            parts[i].merge(parts[i + stride]);
+        }
+    }
+}
+
+/**
+ * @brief Split `[0, n)` into contiguous chunks and run `fn(begin, end, index)` on each.
+ *
+ * At most `threads` chunks are used and no chunk is smaller than `min_chunk`
+ * (except when `n < min_chunk`), so small inputs stay on the calling thread.
+ * Chunk 0 always runs on the caller. If a worker thread cannot be started the
+ * chunk runs inline instead, so this never throws.
+ *
+ * @return Number of chunks used.
+ */
+template <class Fn>
+std::size_t parallel_chunks(std::size_t n, std::size_t threads, std::size_t min_chunk,
+                            Fn&& fn) noexcept {
+    const std::size_t chunks = chunk_count(n, threads, min_chunk);
+    if (chunks == 0) return 0;
+
+    const auto bounds = [n, chunks](std::size_t c) { return n / chunks * c + std::min(c, n % chunks); };
+
+    if (chunks == 1) {
+        fn(std::size_t{0}, n, std::size_t{0});
+        return 1;
+    }
+
+    std::vector<std::thread> workers;
+    try {
+        workers.reserve(chunks - 1);
+    } catch (...) {
+    }
+    for (std::size_t c = 1; c < chunks; ++c) {
+        try {
+            workers.emplace_back([&fn, &bounds, c] { fn(bounds(c), bounds(c + 1), c); });
+        } catch (...) {
+            fn(bounds(c), bounds(c + 1), c);
+        }
+    }
+    fn(std::size_t{0}, bounds(1), std::size_t{0});
+    for (auto& w : workers) w.join();
+    return chunks;
+}
+
+} // namespace fastnum::detail
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace fastnum::detail {
+
+/**
+ * @brief Single-writer, multi-reader copy of a trivially copyable value.
+ *
+ * The writer bumps the sequence to odd, stores the words and bumps it to
+ * even; readers copy the words and retry if the sequence changed or was odd,
+ * so readers never block the writer and the writer never waits. The words
+ * are relaxed atomics, so racing reads are well defined.
+ */
+template <class T>
+class seqlock_cell {
+    static_assert(std::is_trivially_copyable_v<T>, "seqlock_cell requires a trivially copyable T");
+
+    static constexpr std::size_t words = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+public:
+    /// Only one thread may publish at a time.
+    void publish(const T& value) noexcept {
+        std::uint64_t buf[words] = {};
+        std::memcpy(buf, &value, sizeof(T));
+
+        const std::uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t w = 0; w < words; ++w) data_[w].store(buf[w], std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    [[nodiscard]] T read() const noexcept {
+        std::uint64_t buf[words];
+        for (;;) {
+            const std::uint32_t before = seq_.load(std::memory_order_acquire);
+            if (before & 1u) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (std::size_t w = 0; w < words; ++w) buf[w] = data_[w].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == before) break;
+        }
+        T value;
+        std::memcpy(&value, buf, sizeof(T));
+        return value;
+    }
+
+private:
+    std::atomic<std::uint32_t> seq_{0};
+    std::atomic<std::uint64_t> data_[words];
+};
+
+} // namespace fastnum::detail
@@ -0,0 +1,603 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Instruction set selection. The widest ISA enabled by the compiler flags wins
+// (e.g. `-mavx512f`, `-mavx2 -mfma`, `-march=native`). Define
+// FASTNUM_DISABLE_SIMD to force the portable scalar fallback.
+#if !defined(FASTNUM_DISABLE_SIMD)
+#  if defined(__AVX512F__)
+#    define FASTNUM_SIMD_AVX512 1
+#    include <immintrin.h>
+#  elif defined(__AVX2__)
+#    define FASTNUM_SIMD_AVX2 1
+#    include <immintrin.h>
+#  elif defined(__SSE2__) || defined(_M_X64)
+#    define FASTNUM_SIMD_SSE2 1
+#    include <emmintrin.h>
+#  elif defined(__ARM_NEON) && defined(__aarch64__)
+#    define FASTNUM_SIMD_NEON 1
+#    include <arm_neon.h>
+#  endif
+#endif
+
+namespace fastnum::detail::simd {
+
+/// Architectural vector registers; kernels size their register blocking on it.
+#if defined(FASTNUM_SIMD_AVX512) || defined(FASTNUM_SIMD_NEON)
+inline constexpr std::size_t registers = 32;
+#else
+inline constexpr std::size_t registers = 16;
+#endif
+
+/**
+ * @brief Minimal fixed-width SIMD register wrapper used by the batch kernels.
+ *
+ * The primary template is the scalar fallback (`width == 1`); it is used for
+ * `long double` and whenever no supported instruction set is enabled.
+ * Specializations for `float` / `double` wrap the native registers of the
+ * selected ISA. Only the handful of operations the kernels need are provided:
+ * unaligned load/store, 2-way deinterleaving load, broadcast, arithmetic, fused multiply-add, horizontal
+ * sum, min/max, sqrt, truncation, truncating int32 stores and finite / non-NaN / less-than
+ * masks with select/popcount.
+ */
+template <typename T>
+struct batch {
+    static constexpr std::size_t width = 1;
+    using mask = bool;
+
+    T v;
+
+    static batch load(const T* p) noexcept { return {*p}; }
+    /// Deinterleave `2 * width` values: even-indexed ones to `even`, odd to `odd`.
+    static void load2(const T* p, batch& even, batch& odd) noexcept {
+        even.v = p[0];
+        odd.v = p[1];
+    }
+    static batch broadcast(T x) noexcept { return {x}; }
+    void store(T* p) const noexcept { *p = v; }
+    /// Lane-wise truncation toward zero; lanes must be representable as int32.
+    void store_trunc(std::int32_t* p) const noexcept { *p = static_cast<std::int32_t>(v); }
+
+    friend batch operator+(batch a, batch b) noexcept { return {a.v + b.v}; }
+    friend batch operator-(batch a, batch b) noexcept { return {a.v - b.v}; }
+    friend batch operator*(batch a, batch b) noexcept { return {a.v * b.v}; }
+    friend batch operator/(batch a, batch b) noexcept { return {a.v / b.v}; }
+
+    /// a * b + c
+    friend batch fma(batch a, batch b, batch c) noexcept { return {a.v * b.v + c.v}; }
+    friend T reduce_add(batch a) noexcept { return a.v; }
+
+    /// Lanes holding neither NaN nor +/-inf (`x - x == 0`).
+    friend mask finite(batch a) noexcept { return (a.v - a.v) == T{0}; }
+    friend batch select(mask m, batch a, batch b) noexcept { return m ? a : b; }
+
+    /// Lanes that are not NaN.
+    friend mask ordered(batch a) noexcept { return a.v == a.v; }
+    /// Lane-wise min / max; the result for NaN lanes is unspecified.
+    friend batch min(batch a, batch b) noexcept { return {b.v < a.v ? b.v : a.v}; }
+    friend batch max(batch a, batch b) noexcept { return {a.v < b.v ? b.v : a.v}; }
+    friend batch sqrt(batch a) noexcept { return {std::sqrt(a.v)}; }
+    /// Lane-wise rounding toward zero.
+    friend batch trunc(batch a) noexcept { return {std::trunc(a.v)}; }
+    /// Lanes with `a < b` (false for NaN).
+    friend mask operator<(batch a, batch b) noexcept { return a.v < b.v; }
+    /// Number of set lanes; a static member because masks are not class types.
+    static std::size_t popcount(mask m) noexcept { return m ? 1u : 0u; }
+};
+
+#if defined(FASTNUM_SIMD_AVX512)
+
+template <>
+struct batch<double> {
+    static constexpr std::size_t width = 8;
+    using mask = __mmask8;
+
+    __m512d v;
+
+    static batch load(const double* p) noexcept { return {_mm512_loadu_pd(p)}; }
+    static void load2(const double* p, batch& even, batch& odd) noexcept {
+        const __m512d a = _mm512_loadu_pd(p);
+        const __m512d b = _mm512_loadu_pd(p + 8);
+        even.v = _mm512_permutex2var_pd(a, _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0), b);
+        odd.v = _mm512_permutex2var_pd(a, _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1), b);
+    }
+    static batch broadcast(double x) noexcept { return {_mm512_set1_pd(x)}; }
+    void store(double* p) const noexcept { _mm512_storeu_pd(p, v); }
+    // Masked forms with explicit sources here and in min/max: GCC 12's unmasked
+    // intrinsics trip -Wmaybe-uninitialized inside its own header.
+    void store_trunc(std::int32_t* p) const noexcept {
+        const __m256i t = _mm512_mask_cvttpd_epi32(_mm256_setzero_si256(), 0xFF, v);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), t);
+    }
+
+    friend batch operator+(batch a, batch b) noexcept { return {_mm512_add_pd(a.v, b.v)}; }
+    friend batch operator-(batch a, batch b) noexcept { return {_mm512_sub_pd(a.v, b.v)}; }
+    friend batch operator*(batch a, batch b) noexcept { return {_mm512_mul_pd(a.v, b.v)}; }
+    friend batch operator/(batch a, batch b) noexcept { return {_mm512_div_pd(a.v, b.v)}; }
+    friend batch fma(batch a, batch b, batch c) noexcept { return {_mm512_fmadd_pd(a.v, b.v, c.v)}; }
+    // Via memory: GCC 12's _mm512_reduce_add_pd trips -Wuninitialized inside its own header.
+    friend double reduce_add(batch a) noexcept {
+        alignas(64) double t[8];
+        _mm512_store_pd(t, a.v);
+        return ((t[0] + t[4]) + (t[2] + t[6])) + ((t[1] + t[5]) + (t[3] + t[7]));
+    }
+
+    friend mask finite(batch a) noexcept {
+        return _mm512_cmp_pd_mask(_mm512_sub_pd(a.v, a.v), _mm512_setzero_pd(), _CMP_EQ_OQ);
+    }
+    friend batch select(mask m, batch a, batch b) noexcept { return {_mm512_mask_blend_pd(m, b.v, a.v)}; }
+    friend mask ordered(batch a) noexcept { return _mm512_cmp_pd_mask(a.v, a.v, _CMP_ORD_Q); }
+    friend batch min(batch a, batch b) noexcept { return {_mm512_mask_min_pd(a.v, 0xFF, a.v, b.v)}; }
+    friend batch max(batch a, batch b) noexcept { return {_mm512_mask_max_pd(a.v, 0xFF, a.v, b.v)}; }
+    friend batch sqrt(batch a) noexcept { return {_mm512_mask_sqrt_pd(a.v, 0xFF, a.v)}; }
+    friend batch trunc(batch a) noexcept {
+        return {_mm512_mask_roundscale_pd(a.v, 0xFF, a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)};
+    }
+    friend mask operator<(batch a, batch b) noexcept { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ); }
+    static std::size_t popcount(mask m) noexcept {
+        return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(m)));
+    }
+};
+
+template <>
+struct batch<float> {
+    static constexpr std::size_t width = 16;
+    using mask = __mmask16;
+
+    __m512 v;
+
+    static batch load(const float* p) noexcept { return {_mm512_loadu_ps(p)}; }
+    static void load2(const float* p, batch& even, batch& odd) noexcept {
+        const __m512 a = _mm512_loadu_ps(p);
+        const __m512 b = _mm512_loadu_ps(p + 16);
+        const __m512i ie = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0);
+        const __m512i io = _mm512_set_epi32(31, 29, 27, 25, 23, 21, 19, 17, 15, 13, 11, 9, 7, 5, 3, 1);
+        even.v = _mm512_permutex2var_ps(a, ie, b);
+        odd.v = _mm512_permutex2var_ps(a, io, b);
+    }
+    static batch broadcast(float x) noexcept { return {_mm512_set1_ps(x)}; }
+    void store(float* p) const noexcept { _mm512_storeu_ps(p, v); }
+    void store_trunc(std::int32_t* p) const noexcept {
+        _mm512_storeu_si512(p, _mm512_mask_cvttps_epi32(_mm512_setzero_si512(), 0xFFFF, v));
+    }
+
+    friend batch operator+(batch a, batch b) noexcept { return {_mm512_add_ps(a.v, b.v)}; }
+    friend batch operator-(batch a, batch b) noexcept { return {_mm512_sub_ps(a.v, b.v)}; }
+    friend batch operator*(batch a, batch b) noexcept { return {_mm512_mul_ps(a.v, b.v)}; }
+    friend batch operator/(batch a, batch b) noexcept { return {_mm512_div_ps(a.v, b.v)}; }
+    friend batch fma(batch a, batch b, batch c) noexcept { return {_mm512_fmadd_ps(a.v, b.v, c.v)}; }
+    // Via memory, see batch<double>.
+    friend float reduce_add(batch a) noexcept {
+        alignas(64) float t[16];
+        _mm512_store_ps(t, a.v);
+        float s[4] = {};
+        for (int i = 0; i < 16; ++i) s[i & 3] += t[i];
+        return (s[0] + s[2]) + (s[1] + s[3]);
+    }
+
+    friend mask finite(batch a) noexcept {
+        return _mm512_cmp_ps_mask(_mm512_sub_ps(a.v, a.v), _mm512_setzero_ps(), _CMP_EQ_OQ);
+    }
+    friend batch select(mask m, batch a, batch b) noexcept { return {_mm512_mask_blend_ps(m, b.v, a.v)}; }
+    friend mask ordered(batch a) noexcept { return _mm512_cmp_ps_mask(a.v, a.v, _CMP_ORD_Q); }
+    friend batch min(batch a, batch b) noexcept { return {_mm512_mask_min_ps(a.v, 0xFFFF, a.v, b.v)}; }
+    friend batch max(batch a, batch b) noexcept { return {_mm512_mask_max_ps(a.v, 0xFFFF, a.v, b.v)}; }
+    friend batch sqrt(batch a) noexcept { return {_mm512_mask_sqrt_ps(a.v, 0xFFFF, a.v)}; }
+    friend batch trunc(batch a) noexcept {
+        return {_mm512_mask_roundscale_ps(a.v, 0xFFFF, a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)};
+    }
+    friend mask operator<(batch a, batch b) noexcept { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ); }
+    static std::size_t popcount(mask m) noexcept {
+        return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(m)));
+    }
+};
+
+#elif defined(FASTNUM_SIMD_AVX2)
+
+template <>
+struct batch<double> {
+    static constexpr std::size_t width = 4;
+    using mask = __m256d;
+
+    __m256d v;
+
+    static batch load(const double* p) noexcept { return {_mm256_loadu_pd(p)}; }
+    // Unpack within 128-bit lanes, then put the 64-bit chunks back in order.
+    static void load2(const double* p, batch& even, batch& odd) noexcept {
+        const __m256d a = _mm256_loadu_pd(p);
+        const __m256d b = _mm256_loadu_pd(p + 4);
+        even.v = _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+        odd.v = _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+    }
+    static batch broadcast(double x) noexcept { return {_mm256_set1_pd(x)}; }
+    void store(double* p) const noexcept { _mm256_storeu_pd(p, v); }
+    void store_trunc(std::int32_t* p) const noexcept {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_cvttpd_epi32(v));
+    }
+
+    friend batch operator+(batch a, batch b) noexcept { return {_mm256_add_pd(a.v, b.v)}; }
+    friend batch operator-(batch a, batch b) noexcept { return {_mm256_sub_pd(a.v, b.v)}; }
+    friend batch operator*(batch a, batch b) noexcept { return {_mm256_mul_pd(a.v, b.v)}; }
+    friend batch operator/(batch a, batch b) noexcept { return {_mm256_div_pd(a.v, b.v)}; }
+    friend batch fma(batch a, batch b, batch c) noexcept {
+#  if defined(__FMA__)
+        return {_mm256_fmadd_pd(a.v, b.v, c.v)};
+#  else
+        return {_mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v)};
+#  endif
+    }
+    friend double reduce_add(batch a) noexcept {
+        const __m128d lo = _mm256_castpd256_pd128(a.v);
+        const __m128d hi = _mm256_extractf128_pd(a.v, 1);
+        const __m128d s = _mm_add_pd(lo, hi);
+        return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+
+    friend mask finite(batch a) noexcept {
+        return _mm256_cmp_pd(_mm256_sub_pd(a.v, a.v), _mm256_setzero_pd(), _CMP_EQ_OQ);
+    }
+    friend batch select(mask m, batch a, batch b) noexcept { return {_mm256_blendv_pd(b.v, a.v, m)}; }
+    friend mask ordered(batch a) noexcept { return _mm256_cmp_pd(a.v, a.v, _CMP_ORD_Q); }
+    friend batch min(batch a, batch b) noexcept { return {_mm256_min_pd(a.v, b.v)}; }
+    friend batch max(batch a, batch b) noexcept { return {_mm256_max_pd(a.v, b.v)}; }
+    friend batch sqrt(batch a) noexcept { return {_mm256_sqrt_pd(a.v)}; }
+    friend batch trunc(batch a) noexcept { return {_mm256_round_pd(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)}; }
+    friend mask operator<(batch a, batch b) noexcept { return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+    static std::size_t popcount(mask m) noexcept {
+        return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(_mm256_movemask_pd(m))));
+    }
+};
+
+template <>
+struct batch<float> {
+    static constexpr std::size_t width = 8;
+    using mask = __m256;
+
+    __m256 v;
+
+    static batch load(const float* p) noexcept { return {_mm256_loadu_ps(p)}; }
+    static void load2(const float* p, batch& even, batch& odd) noexcept {
+        const __m256 a = _mm256_loadu_ps(p);
+        const __m256 b = _mm256_loadu_ps(p + 8);
+        const __m256d e = _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        const __m256d o = _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        even.v = _mm256_castpd_ps(_mm256_permute4x64_pd(e, _MM_SHUFFLE(3, 1, 2, 0)));
+        odd.v = _mm256_castpd_ps(_mm256_permute4x64_pd(o, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    static batch broadcast(float x) noexcept { return {_mm256_set1_ps(x)}; }
+    void store(float* p) const noexcept { _mm256_storeu_ps(p, v); }
+    void store_trunc(std::int32_t* p) const noexcept {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm256_cvttps_epi32(v));
+    }
+
+    friend batch operator+(batch a, batch b) noexcept { return {_mm256_add_ps(a.v, b.v)}; }
+    friend batch operator-(batch a, batch b) noexcept { return {_mm256_sub_ps(a.v, b.v)}; }
+    friend batch operator*(batch a, batch b) noexcept { return {_mm256_mul_ps(a.v, b.v)}; }
+    friend batch operator/(batch a, batch b) noexcept { return {_mm256_div_ps(a.v, b.v)}; }
+    friend batch fma(batch a, batch b, batch c) noexcept {
+#  if defined(__FMA__)
+        return {_mm256_fmadd_ps(a.v, b.v, c.v)};
+#  else
+        return {_mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v)};
+#  endif
+    }
+    friend float reduce_add(batch a) noexcept {
+        const __m128 lo = _mm256_castps256_ps128(a.v);
+        const __m128 hi = _mm256_extractf128_ps(a.v, 1);
+        __m128 s = _mm_add_ps(lo, hi);
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x1));
+        return _mm_cvtss_f32(s);
+    }
+
+    friend mask finite(batch a) noexcept {
+        return _mm256_cmp_ps(_mm256_sub_ps(a.v, a.v), _mm256_setzero_ps(), _CMP_EQ_OQ);
+    }
+    friend batch select(mask m, batch a, batch b) noexcept { return {_mm256_blendv_ps(b.v, a.v, m)}; }
+    friend mask ordered(batch a) noexcept { return _mm256_cmp_ps(a.v, a.v, _CMP_ORD_Q); }
+    friend batch min(batch a, batch b) noexcept { return {_mm256_min_ps(a.v, b.v)}; }
+    friend batch max(batch a, batch b) noexcept { return {_mm256_max_ps(a.v, b.v)}; }
+    friend batch sqrt(batch a) noexcept { return {_mm256_sqrt_ps(a.v)}; }
+    friend batch trunc(batch a) noexcept { return {_mm256_round_ps(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)}; }
+    friend mask operator<(batch a, batch b) noexcept { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+    static std::size_t popcount(mask m) noexcept {
+        return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(_mm256_movemask_ps(m))));
+    }
+};
+
+#elif defined(FASTNUM_SIMD_SSE2)
+
+template <>
+struct batch<double> {
+    static constexpr std::size_t width = 2;
+    using mask = __m128d;
+
+    __m128d v;
+
+    static batch load(const double* p) noexcept { return {_mm_loadu_pd(p)}; }
+    static void load2(const double* p, batch& even, batch& odd) noexcept {
+        const __m128d a = _mm_loadu_pd(p);
+        const __m128d b = _mm_loadu_pd(p + 2);
+        even.v = _mm_unpacklo_pd(a, b);
+        odd.v = _mm_unpackhi_pd(a, b);
+    }
+    static batch broadcast(double x) noexcept { return {_mm_set1_pd(x)}; }
+    void store(double* p) const noexcept { _mm_storeu_pd(p, v); }
+    void store_trunc(std::int32_t* p) const noexcept {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_cvttpd_epi32(v));
+    }
+
+    friend batch operator+(batch a, batch b) noexcept { return {_mm_add_pd(a.v, b.v)}; }
+    friend batch operator-(batch a, batch b) noexcept { return {_mm_sub_pd(a.v, b.v)}; }
+    friend batch operator*(batch a, batch b) noexcept { return {_mm_mul_pd(a.v, b.v)}; }
+    friend batch operator/(batch a, batch b) noexcept { return {_mm_div_pd(a.v, b.v)}; }
+    friend batch fma(batch a, batch b, batch c) noexcept { return {_mm_add_pd(_mm_mul_pd(a.v, b.v), c.v)}; }
+    friend double reduce_add(batch a) noexcept {
+        return _mm_cvtsd_f64(_mm_add_sd(a.v, _mm_unpackhi_pd(a.v, a.v)));
+    }
+
+    friend mask finite(batch a) noexcept { return _mm_cmpeq_pd(_mm_sub_pd(a.v, a.v), _mm_setzero_pd()); }
+    friend batch select(mask m, batch a, batch b) noexcept {
+        return {_mm_or_pd(_mm_and_pd(m, a.v), _mm_andnot_pd(m, b.v))};
+    }
+    friend mask ordered(batch a) noexcept { return _mm_cmpord_pd(a.v, a.v); }
+    friend batch min(batch a, batch b) noexcept { return {_mm_min_pd(a.v, b.v)}; }
+    friend batch max(batch a, batch b) noexcept { return {_mm_max_pd(a.v, b.v)}; }
+    friend batch sqrt(batch a) noexcept { return {_mm_sqrt_pd(a.v)}; }
+    // No roundpd before SSE4.1: round the magnitude to an integer via 2^52,
+    // step back where that rounded up, and restore the sign. Magnitudes from
+    // 2^52 up (and NaN) are already integral and pass through.
+    friend batch trunc(batch a) noexcept {
+        const __m128d sign = _mm_set1_pd(-0.0);
+        const __m128d big = _mm_set1_pd(4503599627370496.0);
+        const __m128d mag = _mm_andnot_pd(sign, a.v);
+        __m128d r = _mm_sub_pd(_mm_add_pd(mag, big), big);
+        r = _mm_sub_pd(r, _mm_and_pd(_mm_cmpgt_pd(r, mag), _mm_set1_pd(1.0)));
+        r = _mm_or_pd(r, _mm_and_pd(sign, a.v));
+        return select(_mm_cmplt_pd(mag, big), {r}, a);
+    }
+    friend mask operator<(batch a, batch b) noexcept { return _mm_cmplt_pd(a.v, b.v); }
+    static std::size_t popcount(mask m) noexcept {
+        return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(_mm_movemask_pd(m))));
+    }
+};
+
+template <>
+struct batch<float> {
+    static constexpr std::size_t width = 4;
+    using mask = __m128;
+
+    __m128 v;
+
+    static batch load(const float* p) noexcept { return {_mm_loadu_ps(p)}; }
+    static void load2(const float* p, batch& even, batch& odd) noexcept {
+        const __m128 a = _mm_loadu_ps(p);
+        const __m128 b = _mm_loadu_ps(p + 4);
+        even.v = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        odd.v = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+    static batch broadcast(float x) noexcept { return {_mm_set1_ps(x)}; }
+    void store(float* p) const noexcept { _mm_storeu_ps(p, v); }
+    void store_trunc(std::int32_t* p) const noexcept {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_cvttps_epi32(v));
+    }
+
+    friend batch operator+(batch a, batch b) noexcept { return {_mm_add_ps(a.v, b.v)}; }
+    friend batch operator-(batch a, batch b) noexcept { return {_mm_sub_ps(a.v, b.v)}; }
+    friend batch operator*(batch a, batch b) noexcept { return {_mm_mul_ps(a.v, b.v)}; }
+    friend batch operator/(batch a, batch b) noexcept { return {_mm_div_ps(a.v, b.v)}; }
+    friend batch fma(batch a, batch b, batch c) noexcept { return {_mm_add_ps(_mm_mul_ps(a.v, b.v), c.v)}; }
+    friend float reduce_add(batch a) noexcept {
+        __m128 s = _mm_add_ps(a.v, _mm_movehl_ps(a.v, a.v));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x1));
+        return _mm_cvtss_f32(s);
+    }
+
+    friend mask finite(batch a) noexcept { return _mm_cmpeq_ps(_mm_sub_ps(a.v, a.v), _mm_setzero_ps()); }
+    friend batch select(mask m, batch a, batch b) noexcept {
+        return {_mm_or_ps(_mm_and_ps(m, a.v), _mm_andnot_ps(m, b.v))};
+    }
+    friend mask ordered(batch a) noexcept { return _mm_cmpord_ps(a.v, a.v); }
+    friend batch min(batch a, batch b) noexcept { return {_mm_min_ps(a.v, b.v)}; }
+    friend batch max(batch a, batch b) noexcept { return {_mm_max_ps(a.v, b.v)}; }
+    friend batch sqrt(batch a) noexcept { return {_mm_sqrt_ps(a.v)}; }
+    // See batch<double>::trunc; 2^23 for float.
+    friend batch trunc(batch a) noexcept {
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        const __m128 big = _mm_set1_ps(8388608.0f);
+        const __m128 mag = _mm_andnot_ps(sign, a.v);
+        __m128 r = _mm_sub_ps(_mm_add_ps(mag, big), big);
+        r = _mm_sub_ps(r, _mm_and_ps(_mm_cmpgt_ps(r, mag), _mm_set1_ps(1.0f)));
+        r = _mm_or_ps(r, _mm_and_ps(sign, a.v));
+        return select(_mm_cmplt_ps(mag, big), {r}, a);
+    }
+    friend mask operator<(batch a, batch b) noexcept { return _mm_cmplt_ps(a.v, b.v); }
+    static std::size_t popcount(mask m) noexcept {
+        return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(_mm_movemask_ps(m))));
+    }
+};
+
+#elif defined(FASTNUM_SIMD_NEON)
+
+template <>
+struct batch<double> {
+    static constexpr std::size_t width = 2;
+    using mask = uint64x2_t;
+
+    float64x2_t v;
+
+    static batch load(const double* p) noexcept { return {vld1q_f64(p)}; }
+    static void load2(const double* p, batch& even, batch& odd) noexcept {
+        const float64x2x2_t ab = vld2q_f64(p);
+        even.v = ab.val[0];
+        odd.v = ab.val[1];
+    }
+    static batch broadcast(double x) noexcept { return {vdupq_n_f64(x)}; }
+    void store(double* p) const noexcept { vst1q_f64(p, v); }
+    void store_trunc(std::int32_t* p) const noexcept { vst1_s32(p, vmovn_s64(vcvtq_s64_f64(v))); }
+
+    friend batch operator+(batch a, batch b) noexcept { return {vaddq_f64(a.v, b.v)}; }
+    friend batch operator-(batch a, batch b) noexcept { return {vsubq_f64(a.v, b.v)}; }
+    friend batch operator*(batch a, batch b) noexcept { return {vmulq_f64(a.v, b.v)}; }
+    friend batch operator/(batch a, batch b) noexcept { return {vdivq_f64(a.v, b.v)}; }
+    friend batch fma(batch a, batch b, batch c) noexcept { return {vfmaq_f64(c.v, a.v, b.v)}; }
+    friend double reduce_add(batch a) noexcept { return vaddvq_f64(a.v); }
+
+    friend mask finite(batch a) noexcept { return vceqq_f64(vsubq_f64(a.v, a.v), vdupq_n_f64(0.0)); }
+    friend batch select(mask m, batch a, batch b) noexcept { return {vbslq_f64(m, a.v, b.v)}; }
+    friend mask ordered(batch a) noexcept { return vceqq_f64(a.v, a.v); }
+    friend batch min(batch a, batch b) noexcept { return {vminq_f64(a.v, b.v)}; }
+    friend batch max(batch a, batch b) noexcept { return {vmaxq_f64(a.v, b.v)}; }
+    friend batch sqrt(batch a) noexcept { return {vsqrtq_f64(a.v)}; }
+    friend batch trunc(batch a) noexcept { return {vrndq_f64(a.v)}; }
+    friend mask operator<(batch a, batch b) noexcept { return vcltq_f64(a.v, b.v); }
+    static std::size_t popcount(mask m) noexcept {
+        return static_cast<std::size_t>(vaddvq_u64(vshrq_n_u64(m, 63)));
+    }
+};
+
+template <>
+struct batch<float> {
+    static constexpr std::size_t width = 4;
+    using mask = uint32x4_t;
+
+    float32x4_t v;
+
+    static batch load(const float* p) noexcept { return {vld1q_f32(p)}; }
+    static void load2(const float* p, batch& even, batch& odd) noexcept {
+        const float32x4x2_t ab = vld2q_f32(p);
+        even.v = ab.val[0];
+        odd.v = ab.val[1];
+    }
+    static batch broadcast(float x) noexcept { return {vdupq_n_f32(x)}; }
+    void store(float* p) const noexcept { vst1q_f32(p, v); }
+    void store_trunc(std::int32_t* p) const noexcept { vst1q_s32(p, vcvtq_s32_f32(v)); }
+
+    friend batch operator+(batch a, batch b) noexcept { return {vaddq_f32(a.v, b.v)}; }
+    friend batch operator-(batch a, batch b) noexcept { return {vsubq_f32(a.v, b.v)}; }
+    friend batch operator*(batch a, batch b) noexcept { return {vmulq_f32(a.v, b.v)}; }
+    friend batch operator/(batch a, batch b) noexcept { return {vdivq_f32(a.v, b.v)}; }
+    friend batch fma(batch a, batch b, batch c) noexcept { return {vfmaq_f32(c.v, a.v, b.v)}; }
+    friend float reduce_add(batch a) noexcept { return vaddvq_f32(a.v); }
+
+    friend mask finite(batch a) noexcept { return vceqq_f32(vsubq_f32(a.v, a.v), vdupq_n_f32(0.0f)); }
+    friend batch select(mask m, batch a, batch b) noexcept { return {vbslq_f32(m, a.v, b.v)}; }
+    friend mask ordered(batch a) noexcept { return vceqq_f32(a.v, a.v); }
+    friend batch min(batch a, batch b) noexcept { return {vminq_f32(a.v, b.v)}; }
+    friend batch max(batch a, batch b) noexcept { return {vmaxq_f32(a.v, b.v)}; }
+    friend batch sqrt(batch a) noexcept { return {vsqrtq_f32(a.v)}; }
+    friend batch trunc(batch a) noexcept { return {vrndq_f32(a.v)}; }
+    friend mask operator<(batch a, batch b) noexcept { return vcltq_f32(a.v, b.v); }
+    static std::size_t popcount(mask m) noexcept {
+        return static_cast<std::size_t>(vaddvq_u32(vshrq_n_u32(m, 31)));
+    }
+};
+
+#endif
+
+// float -> double conversion of one double register's worth of lanes.
+#if defined(FASTNUM_SIMD_AVX512)
+// The zero-masked form: GCC 12 warns about the undefined source operand of
+// the plain _mm512_cvtps_pd.
+inline batch<double> widen_f32(const float* p) noexcept {
+    return {_mm512_maskz_cvtps_pd(__mmask8(0xFF), _mm256_loadu_ps(p))};
+}
+#elif defined(FASTNUM_SIMD_AVX2)
+inline batch<double> widen_f32(const float* p) noexcept { return {_mm256_cvtps_pd(_mm_loadu_ps(p))}; }
+#elif defined(FASTNUM_SIMD_SSE2)
+inline batch<double> widen_f32(const float* p) noexcept {
+    return {_mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))))};
+}
+#elif defined(FASTNUM_SIMD_NEON)
+inline batch<double> widen_f32(const float* p) noexcept { return {vcvt_f64_f32(vld1_f32(p))}; }
+#else
+inline batch<double> widen_f32(const float* p) noexcept { return {static_cast<double>(*p)}; }
+#endif
+
+/// Load `batch<T>::width` values of a narrower type `U` from `p`, converted
+/// to `T` in registers (one half-width load and a convert for float -> double).
+template <typename T, typename U>
+batch<T> load_widened(const U* p) noexcept {
+    if constexpr (std::is_same_v<T, double> && std::is_same_v<U, float>) {
+        return widen_f32(p);
+    } else {
+        T lanes[batch<T>::width];
+        for (std::size_t k = 0; k < batch<T>::width; ++k) lanes[k] = static_cast<T>(p[k]);
+        return batch<T>::load(lanes);
+    }
+}
+
+// uint64 -> double conversion of one double register's worth of counts
+// below 2^52: OR-ing the exponent of 2^52 into the bits gives the double
+// 2^52 + n exactly (no 64-bit integer convert before AVX-512DQ), and one
+// subtraction removes the offset. count_f32 narrows two such registers.
+#if defined(FASTNUM_SIMD_AVX512)
+inline batch<double> count_f64(const std::uint64_t* p) noexcept {
+    const __m512i bits = _mm512_or_si512(_mm512_loadu_si512(p), _mm512_set1_epi64(0x4330000000000000));
+    return {_mm512_sub_pd(_mm512_castsi512_pd(bits), _mm512_set1_pd(0x1p52))};
+}
+// Zero-masked forms throughout: GCC 12 warns about the undefined pass-through
+// operands of the plain converts and inserts.
+inline batch<float> count_f32(const std::uint64_t* p) noexcept {
+    const __m256i lo = _mm256_castps_si256(_mm512_maskz_cvtpd_ps(__mmask8(0xFF), count_f64(p).v));
+    const __m256i hi = _mm256_castps_si256(_mm512_maskz_cvtpd_ps(__mmask8(0xFF), count_f64(p + 8).v));
+    const __m512i base = _mm512_maskz_inserti64x4(__mmask8(0xFF), _mm512_setzero_si512(), lo, 0);
+    return {_mm512_castsi512_ps(_mm512_maskz_inserti64x4(__mmask8(0xFF), base, hi, 1))};
+}
+#elif defined(FASTNUM_SIMD_AVX2)
+inline batch<double> count_f64(const std::uint64_t* p) noexcept {
+    const __m256i bits = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)),
+                                         _mm256_set1_epi64x(0x4330000000000000));
+    return {_mm256_sub_pd(_mm256_castsi256_pd(bits), _mm256_set1_pd(0x1p52))};
+}
+inline batch<float> count_f32(const std::uint64_t* p) noexcept {
+    const __m128 lo = _mm256_cvtpd_ps(count_f64(p).v);
+    return {_mm256_insertf128_ps(_mm256_castps128_ps256(lo), _mm256_cvtpd_ps(count_f64(p + 4).v), 1)};
+}
+#elif defined(FASTNUM_SIMD_SSE2)
+inline batch<double> count_f64(const std::uint64_t* p) noexcept {
+    const __m128i bits = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)),
+                                      _mm_set1_epi64x(0x4330000000000000));
+    return {_mm_sub_pd(_mm_castsi128_pd(bits), _mm_set1_pd(0x1p52))};
+}
+inline batch<float> count_f32(const std::uint64_t* p) noexcept {
+    return {_mm_movelh_ps(_mm_cvtpd_ps(count_f64(p).v), _mm_cvtpd_ps(count_f64(p + 2).v))};
+}
+#elif defined(FASTNUM_SIMD_NEON)
+inline batch<double> count_f64(const std::uint64_t* p) noexcept { return {vcvtq_f64_u64(vld1q_u64(p))}; }
+inline batch<float> count_f32(const std::uint64_t* p) noexcept {
+    return {vcvt_high_f32_f64(vcvt_f32_f64(count_f64(p).v), count_f64(p + 2).v)};
+}
+#else
+inline batch<double> count_f64(const std::uint64_t* p) noexcept { return {static_cast<double>(*p)}; }
+inline batch<float> count_f32(const std::uint64_t* p) noexcept { return {static_cast<float>(*p)}; }
+#endif
+
+/// Load `batch<T>::width` 64-bit counts (each below 2^52) from `p` as `T`.
+template <typename T>
+batch<T> load_counts(const std::uint64_t* p) noexcept {
+    if constexpr (std::is_same_v<T, double>) {
+        return count_f64(p);
+    } else if constexpr (std::is_same_v<T, float>) {
+        return count_f32(p);
+    } else {
+        T lanes[batch<T>::width];
+        for (std::size_t k = 0; k < batch<T>::width; ++k) lanes[k] = static_cast<T>(p[k]);
+        return batch<T>::load(lanes);
+    }
+}
+
+/// Load `width` values spaced `stride` elements apart, starting at `p`.
+template <typename T>
+batch<T> load_strided(const T* p, std::size_t stride) noexcept {
+    T lanes[batch<T>::width];
+    for (std::size_t k = 0; k < batch<T>::width; ++k) lanes[k] = p[k * stride];
+    return batch<T>::load(lanes);
+}
+
+} // namespace fastnum::detail::simd
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <fastnum/policy.hpp>
+#include <fastnum/detail/simd.hpp>
+#include <fastnum/online_standard_scaler.hpp>
+
+namespace fastnum {
+
+/**
+ * @brief Exponentially weighted online mean and variance.
+ *
+ * Every observation enters with weight 1 and all previous weight is multiplied
+ * by a decay factor `d = 1 - alpha`, so old samples fade out geometrically and
+ * memory stays constant. The state is a weighted Welford accumulator
+ * (West, 1979): total weight `W = sum w_i`, `W2 = sum w_i^2`, the weighted mean
+ * and `S = sum w_i (x_i - mean)^2`. Because earlier weights are renormalized
+ * exactly, early estimates are not biased towards the initial zero state.
+ *
+ * ## Decay modes
+ * - Per sample: `ExponentialStats(alpha)` or `from_half_life(samples)`.
+ * - Per unit of time: `from_time_half_life(h)` together with
+ *   `observe_at(x, t)`; weight halves every `h` time units between
+ *   (possibly irregular) timestamps, independent of the sampling rate.
+ * `decay(f)` ages the state by an explicit factor in either mode.
+ *
+ * ## Batch path
+ * `observe(xs, n)` is equivalent to `n` scalar observes but never decays the
+ * state per element: each L1-sized chunk is reduced with weights `d^(c-1-i)`
+ * generated as SIMD powers, the state is decayed once by `d^c`, and the chunk
+ * is folded in with the weighted Chan merge.
+ *
+ * ## Merge
+ * `merge(other)` combines two states observed over the same time frame
+ * (weights add). To append a state that ends later, `decay()` the older one
+ * by the elapsed factor first.
+ *
+ * Drop-in statistics backend for `OnlineStandardScaler<T, ExponentialStats<T>>`.
+ *
+ * @tparam T      Floating-point type.
+ * @tparam Policy Count type and readiness epsilon (see `default_policy`).
+ */
+template <typename T = double, class Policy = default_policy>
+class ExponentialStats {
+    static_assert(std::is_floating_point_v<T>, "ExponentialStats requires floating point T");
+    static_assert(detail::is_policy_v<Policy>, "ExponentialStats requires a fastnum policy");
+    static_assert(!detail::compensated_of_v<Policy>, "ExponentialStats does not implement compensated_policy");
+    static_assert(detail::nan_policy_of_v<Policy> == nan_policy::propagate,
+                  "ExponentialStats only supports nan_policy::propagate");
+
+public:
+    using value_type = T;
+    using policy_type = Policy;
+    /// Decayed state depends on sample order; chunked parallel fits are rejected.
+    static constexpr bool order_sensitive = true;
+    using count_type = typename Policy::count_type;
+
+    /// Weight of a new sample relative to the decayed history, `0 < alpha <= 1`.
+    explicit constexpr ExponentialStats(T alpha = static_cast<T>(0.05)) noexcept
+        : decay_(T{1} - alpha) {
+        assert(alpha > T{0} && alpha <= T{1});
+    }
+
+    /// Per-sample decay such that a sample's weight halves after `samples` observations.
+    [[nodiscard]] static ExponentialStats from_half_life(T samples) noexcept {
+        assert(samples > T{0});
+        return ExponentialStats(T{1} - std::exp2(T{-1} / samples));
+    }
+
+    /// Time-based decay for `observe_at`: weight halves every `half_life` time units.
+    [[nodiscard]] static ExponentialStats from_time_half_life(T half_life) noexcept {
+        assert(half_life > T{0});
+        ExponentialStats s(T{1});
+        s.decay_ = T{1};
+        s.inv_half_life_ = T{1} / half_life;
+        return s;
+    }
+
+    // --- Observe -------------------------------------------------------------
+
+    constexpr void observe(T x) noexcept {
+        ++n_;
+        w_ = decay_ * w_ + T{1};
+        w2_ = decay_ * decay_ * w2_ + T{1};
+        const T delta = x - mean_;
+        mean_ += delta / w_;
+        s_ = decay_ * s_ + delta * (x - mean_);
+    }
+
+    void observe(const T* xs, std::size_t n) noexcept {
+        if (!xs || n == 0) return;
+        for (std::size_t off = 0; off < n; off += chunk) {
+            observe_chunk(xs + off, n - off < chunk ? n - off : chunk);
+        }
+    }
+
+    template <class Container>
+    auto observe(const Container& c) noexcept
+        -> decltype(c.data(), c.size(), void()) {
+        observe(c.data(), static_cast<std::size_t>(c.size()));
+    }
+
+    /**
+     * @brief Observe `x` at time `t` (time-based decay).
+     *
+     * The history is first decayed by `2^(-(t - t_prev) / half_life)`. Times
+     * must be non-decreasing. Has no time effect unless the object was made
+     * by `from_time_half_life`.
+     */
+    void observe_at(T x, T t) noexcept {
+        if (n_ > 0 && inv_half_life_ > T{0}) {
+            assert(t >= last_t_);
+            decay(std::exp2(-(t - last_t_) * inv_half_life_));
+        }
+        last_t_ = t;
+        observe(x);
+    }
+
+    /// Timestamped batch (`ts` non-decreasing).
+    void observe_at(const T* xs, const T* ts, std::size_t n) noexcept {
+        if (!xs || !ts) return;
+        for (std::size_t i = 0; i < n; ++i) observe_at(xs[i], ts[i]);
+    }
+
+    /// Multiply all accumulated weight by `factor` (ages the state).
+    constexpr void decay(T factor) noexcept {
+        w_ *= factor;
+        w2_ *= factor * factor;
+        s_ *= factor;
+    }
+
+    // --- Accessors -----------------------------------------------------------
+
+    [[nodiscard]] constexpr std::size_t count() const noexcept { return n_; }
+    [[nodiscard]] constexpr T mean() const noexcept { return mean_; }
+
+    /// Total (decayed) weight `W`.
+    [[nodiscard]] constexpr T weight() const noexcept { return w_; }
+
+    /// Kish effective sample size `W^2 / W2`.
+    [[nodiscard]] constexpr T effective_count() const noexcept {
+        if (n_ < 1) return T{0};
+        return w_ * w_ / w2_;
+    }
+
+    /// Per-sample decay factor `1 - alpha`.
+    [[nodiscard]] constexpr T decay_factor() const noexcept { return decay_; }
+
+    /// Weighted population variance `S / W`.
+    [[nodiscard]] constexpr T variance_population() const noexcept {
+        if (n_ < 1) return std::numeric_limits<T>::quiet_NaN();
+        return s_ / w_;
+    }
+
+    /// Reliability-weighted unbiased variance `S / (W - W2 / W)`.
+    [[nodiscard]] constexpr T variance_sample() const noexcept {
+        if (n_ < 2) return std::numeric_limits<T>::quiet_NaN();
+        return s_ / (w_ - w2_ / w_);
+    }
+
+    [[nodiscard]] T stddev_population() const noexcept { return std::sqrt(variance_population()); }
+    [[nodiscard]] T stddev_sample() const noexcept { return std::sqrt(variance_sample()); }
+
+    // --- Merge / reset -------------------------------------------------------
+
+    /// Weighted Chan merge of a state covering the same time frame.
+    constexpr void merge(const ExponentialStats& other) noexcept {
+        if (other.n_ == 0) return;
+        if (n_ == 0) {
+            merge_into_empty(other);
+            return;
+        }
+        merge_weighted(other.n_, other.w_, other.w2_, other.mean_, other.s_);
+        if (other.last_t_ > last_t_) last_t_ = other.last_t_;
+    }
+
+    /// Clear the state, keeping the decay configuration.
+    constexpr void reset() noexcept {
+        n_ = 0;
+        w_ = T{0};
+        w2_ = T{0};
+        mean_ = T{0};
+        s_ = T{0};
+        last_t_ = T{0};
+    }
+
+private:
+    static constexpr std::size_t chunk = 1024;
+
+    constexpr void merge_into_empty(const ExponentialStats& other) noexcept {
+        n_ = other.n_;
+        w_ = other.w_;
+        w2_ = other.w2_;
+        mean_ = other.mean_;
+        s_ = other.s_;
+        last_t_ = other.last_t_;
+    }
+
+    constexpr void merge_weighted(count_type n_b, T w_b, T w2_b, T mean_b, T s_b) noexcept {
+        const T w = w_ + w_b;
+        const T delta = mean_b - mean_;
+        mean_ += delta * (w_b / w);
+        s_ += s_b + delta * delta * (w_ * w_b / w);
+        w2_ += w2_b;
+        w_ = w;
+        n_ += n_b;
+    }
+
+    // Reduce one chunk with weights d^(c-1-i), then decay-and-merge.
+    void observe_chunk(const T* xs, std::size_t c) noexcept {
+        using B = detail::simd::batch<T>;
+        constexpr std::size_t W = B::width;
+
+        // Lane j of the last vector holds exponent W-1-j; each earlier vector
+        // is scaled by d^W.
+        T base[W];
+        T p = T{1};
+        for (std::size_t j = W; j-- > 0;) {
+            base[j] = p;
+            p *= decay_;
+        }
+        const T dW = p;
+        const std::size_t vec = c / W;
+        const std::size_t head = c - vec * W; // leading scalar elements
+
+        // Pass 1: sum w, sum w^2, sum w x.
+        B wv = B::load(base);
+        const B vdW = B::broadcast(dW);
+        B sw = B::broadcast(T{0}), sw2 = sw, swx = sw;
+        for (std::size_t k = vec; k-- > 0;) {
+            const B x = B::load(xs + head + k * W);
+            sw = sw + wv;
+            sw2 = fma(wv, wv, sw2);
+            swx = fma(wv, x, swx);
+            wv = wv * vdW;
+        }
+        T w_b = reduce_add(sw);
+        T w2_b = reduce_add(sw2);
+        T wx_b = reduce_add(swx);
+        // Head elements continue the power sequence after the vector blocks.
+        T wh = T{1};
+        for (std::size_t k = 0; k < vec; ++k) wh *= dW;
+        T whead[W] = {};
+        for (std::size_t i = head; i-- > 0;) {
+            whead[i] = wh;
+            w_b += wh;
+            w2_b += wh * wh;
+            wx_b += wh * xs[i];
+            wh *= decay_;
+        }
+        const T mean_b = wx_b / w_b;
+
+        // Pass 2: sum w (x - mean_b)^2 over the (cache-resident) chunk.
+        wv = B::load(base);
+        const B vmean = B::broadcast(mean_b);
+        B ss = B::broadcast(T{0});
+        for (std::size_t k = vec; k-- > 0;) {
+            const B dx = B::load(xs + head + k * W) - vmean;
+            ss = fma(wv * dx, dx, ss);
+            wv = wv * vdW;
+        }
+        T s_b = reduce_add(ss);
+        for (std::size_t i = 0; i < head; ++i) {
+            const T dx = xs[i] - mean_b;
+            s_b += whead[i] * dx * dx;
+        }
+
+        // Decay history by d^c (= weight of the element just before the chunk, times d).
+        const T f = wh;
+        if (n_ == 0) {
+            n_ = static_cast<count_type>(c);
+            w_ = w_b;
+            w2_ = w2_b;
+            mean_ = mean_b;
+            s_ = s_b;
+            return;
+        }
+        decay(f);
+        merge_weighted(static_cast<count_type>(c), w_b, w2_b, mean_b, s_b);
+    }
+
+    count_type n_{0};
+    T w_{0};
+    T w2_{0};
+    T mean_{0};
+    T s_{0};
+    T decay_;
+    T inv_half_life_{0};
+    T last_t_{0};
+};
+
+static_assert(sizeof(ExponentialStats<double>) == accumulator_size<double, default_policy, 7>);
+
+/// Standard scaler that tracks an exponentially weighted mean/variance.
+template <typename T = double>
+using ExponentialStandardScaler = OnlineStandardScaler<T, ExponentialStats<T>>;
+
+} // namespace fastnum
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <fastnum/detail/simd.hpp>
+
+namespace fastnum {
+
+/// Bin spacing of a `Histogram`.
+enum class bin_scale {
+    linear, ///< equal-width bins on `[lo, hi)`
+    log     ///< equal-ratio bins on `[lo, hi)`, `0 < lo < hi`
+};
+
+/**
+ * @brief Mergeable fixed-range streaming histogram.
+ *
+ * Counts samples into `Bins` bins spanning `[lo, hi)`, plus an underflow
+ * (`x < lo`), an overflow (`x >= hi`, including `+inf`) and a NaN counter.
+ * NaN inputs follow the library policy of being observed rather than
+ * dropped: they are counted in `count()` and `nan_count()` but fall into
+ * no bin.
+ *
+ * Bin assignment is branch-free:
+ * - linear: `slot = clamp((x - lo) * Bins / (hi - lo) + 1, 0, Bins + 1)`
+ *   truncated, computed `batch<T>::width` samples at a time;
+ * - log: branch-free binary search over the `Bins + 1` precomputed edges,
+ *   so samples exactly on an edge land in the upper bin.
+ *
+ * Linear edges are subject to the rounding of `(x - lo) * scale`; a sample
+ * within one ulp of an inner edge may land in either neighbour.
+ *
+ * Batch `observe(const T*, n)` resolves bin indices for a block of samples
+ * first, then increments `sub_histograms` interleaved 32-bit copies of the
+ * counters, so repeated hits on one bin do not serialize on a single
+ * store-to-load chain. The copies live on the stack for the whole call and
+ * are folded into the 64-bit counters once at its end (only used while they
+ * fit in 32 KiB, and for calls of at least `sub_histograms * (Bins + 3)`
+ * samples, so zeroing and folding them stays small next to the increments).
+ *
+ * @tparam T     Floating-point type of the samples.
+ * @tparam Bins  Number of bins inside the range.
+ * @tparam Scale Linear or logarithmic bin spacing.
+ */
+template <typename T = double, std::size_t Bins = 64, bin_scale Scale = bin_scale::linear>
+class Histogram {
+    static_assert(std::is_floating_point_v<T>, "Histogram requires floating point T");
+    static_assert(Bins >= 1 && Bins < (std::size_t{1} << 24), "Histogram requires 1 <= Bins < 2^24");
+
+public:
+    using value_type = T;
+    using count_type = std::uint64_t;
+    static constexpr std::size_t bins = Bins;
+    static constexpr bin_scale scale = Scale;
+    static constexpr std::size_t sub_histograms = 4;
+
+    /// Range `[lo, hi)`; requires `lo < hi` (and `lo > 0` for log bins).
+    Histogram(T lo, T hi) noexcept : lo_(lo), hi_(hi) {
+        assert(lo < hi && (Scale == bin_scale::linear || lo > T{0}));
+        if constexpr (Scale == bin_scale::linear) {
+            scale_ = static_cast<T>(Bins) / (hi - lo);
+        } else {
+            // edge_i = lo * (hi / lo)^(i / Bins), exact at both ends.
+            const double l = std::log(static_cast<double>(lo));
+            const double step = (std::log(static_cast<double>(hi)) - l) / static_cast<double>(Bins);
+            edges_.e[0] = lo;
+            for (std::size_t i = 1; i < Bins; ++i) {
+                edges_.e[i] = static_cast<T>(std::exp(l + step * static_cast<double>(i)));
+            }
+            edges_.e[Bins] = hi;
+        }
+    }
+
+    // --- Observe -------------------------------------------------------------
+
+    void observe(T x) noexcept { ++counts_[slot(x)]; }
+
+    void observe(const T* xs, std::size_t n) noexcept {
+        if (!xs || n == 0) return;
+        constexpr bool interleave = sub_histograms * slots * sizeof(std::uint32_t) <= 32 * 1024;
+        std::int32_t idx[block];
+        // Zeroing and folding the copies costs ~2 * sub_histograms * slots
+        // operations per call; short calls count straight into counts_.
+        if (!interleave || n < sub_histograms * slots) {
+            for (std::size_t base = 0; base < n; base += block) {
+                const std::size_t m = n - base < block ? n - base : block;
+                slots_of(xs + base, m, idx);
+                for (std::size_t i = 0; i < m; ++i) ++counts_[idx[i]];
+            }
+            return;
+        }
+        if constexpr (interleave) {
+            // One set of copies for the whole call, folded at the end, or
+            // earlier once they could hold 2^32 samples and wrap.
+            std::uint32_t sub[sub_histograms][slots] = {};
+            std::size_t pending = 0;
+            for (std::size_t base = 0; base < n; base += block) {
+                const std::size_t m = n - base < block ? n - base : block;
+                slots_of(xs + base, m, idx);
+                std::size_t i = 0;
+                for (; i + sub_histograms <= m; i += sub_histograms) {
+                    for (std::size_t s = 0; s < sub_histograms; ++s) ++sub[s][idx[i + s]];
+                }
+                for (; i < m; ++i) ++sub[0][idx[i]];
+                pending += m;
+                if (pending > fold_limit - block) {
+                    fold(sub);
+                    pending = 0;
+                }
+            }
+            fold(sub);
+        }
+    }
+
+    template <class Container>
+    auto observe(const Container& c) noexcept -> decltype(c.data(), c.size(), void()) {
+        observe(c.data(), static_cast<std::size_t>(c.size()));
+    }
+
+    // --- Merge / reset -------------------------------------------------------
+
+    /// Add the counts of a histogram over the same range.
+    void merge(const Histogram& other) noexcept {
+        assert(other.lo_ == lo_ && other.hi_ == hi_);
+        for (std::size_t b = 0; b < slots; ++b) counts_[b] += other.counts_[b];
+    }
+
+    /// Zero all counters; keeps the range.
+    void reset() noexcept {
+        for (auto& c : counts_) c = 0;
+    }
+
+    // --- Accessors -----------------------------------------------------------
+
+    /// All observed samples, including under/overflow and NaN.
+    [[nodiscard]] count_type count() const noexcept {
+        count_type total = 0;
+        for (auto c : counts_) total += c;
+        return total;
+    }
+
+    [[nodiscard]] bool ready() const noexcept { return count() > 0; }
+
+    /// Samples in bin `i`, `0 <= i < Bins`.
+    [[nodiscard]] count_type bin_count(std::size_t i) const noexcept { return counts_[i + 1]; }
+
+    /// Bin counts as a contiguous array of `Bins` values.
+    [[nodiscard]] const count_type* counts() const noexcept { return counts_ + 1; }
+
+    [[nodiscard]] count_type underflow() const noexcept { return counts_[0]; }
+    [[nodiscard]] count_type overflow() const noexcept { return counts_[Bins + 1]; }
+    [[nodiscard]] count_type nan_count() const noexcept { return counts_[Bins + 2]; }
+
+    [[nodiscard]] T lo() const noexcept { return lo_; }
+    [[nodiscard]] T hi() const noexcept { return hi_; }
+
+    /// Lower edge of bin `i`; `bin_lower(Bins) == hi()`.
+    [[nodiscard]] T bin_lower(std::size_t i) const noexcept {
+        if constexpr (Scale == bin_scale::linear) {
+            return i == Bins ? hi_ : lo_ + static_cast<T>(i) * (hi_ - lo_) / static_cast<T>(Bins);
+        } else {
+            return edges_.e[i];
+        }
+    }
+
+    [[nodiscard]] T bin_upper(std::size_t i) const noexcept { return bin_lower(i + 1); }
+
+private:
+    // counts_[0] underflow, [1, Bins] bins, [Bins + 1] overflow, [Bins + 2] NaN.
+    static constexpr std::size_t slots = Bins + 3;
+    static constexpr std::size_t block = 1024;
+    // Samples the 32-bit copies in observe() may take between folds.
+    static constexpr std::size_t fold_limit = std::size_t{0xFFFFFFFFu};
+
+    struct no_edges {};
+    struct log_edges {
+        T e[Bins + 1];
+    };
+
+    // Add the 32-bit copies into counts_ and zero them.
+    void fold(std::uint32_t (&sub)[sub_histograms][slots]) noexcept {
+        for (std::size_t b = 0; b < slots; ++b) {
+            count_type c = 0;
+            for (std::size_t s = 0; s < sub_histograms; ++s) {
+                c += sub[s][b];
+                sub[s][b] = 0;
+            }
+            counts_[b] += c;
+        }
+    }
+
+    [[nodiscard]] std::size_t slot(T x) const noexcept {
+        if constexpr (Scale == bin_scale::linear) {
+            T u = (x - lo_) * scale_ + T{1};
+            u = u < T{0} ? T{0} : u;
+            u = u > static_cast<T>(Bins + 1) ? static_cast<T>(Bins + 1) : u;
+            return x == x ? static_cast<std::size_t>(u) : Bins + 2;
+        } else {
+            return x == x ? log_slot(x) : Bins + 2;
+        }
+    }
+
+    // Number of edges <= x: 0 underflow, 1..Bins bin + 1, Bins + 1 overflow.
+    [[nodiscard]] std::size_t log_slot(T x) const noexcept {
+        const T* base = edges_.e;
+        std::size_t len = Bins + 1;
+        while (len > 1) {
+            const std::size_t half = len / 2;
+            base = base[half] <= x ? base + half : base;
+            len -= half;
+        }
+        return static_cast<std::size_t>(base - edges_.e) + (*base <= x ? 1u : 0u);
+    }
+
+    void slots_of(const T* xs, std::size_t m, std::int32_t* idx) const noexcept {
+        std::size_t i = 0;
+        if constexpr (Scale == bin_scale::linear) {
+            using B = detail::simd::batch<T>;
+            constexpr std::size_t W = B::width;
+            const B lo = B::broadcast(lo_);
+            const B s = B::broadcast(scale_);
+            const B one = B::broadcast(T{1});
+            const B zero = B::broadcast(T{0});
+            const B top = B::broadcast(static_cast<T>(Bins + 1));
+            const B nan_slot = B::broadcast(static_cast<T>(Bins + 2));
+            for (; i + W <= m; i += W) {
+                const B x = B::load(xs + i);
+                const B u = min(max((x - lo) * s + one, zero), top); // same rounding as slot()
+                select(ordered(x), u, nan_slot).store_trunc(idx + i);
+            }
+        }
+        for (; i < m; ++i) idx[i] = static_cast<std::int32_t>(slot(xs[i]));
+    }
+
+    T lo_;
+    T hi_;
+    T scale_{};
+    [[no_unique_address]] std::conditional_t<Scale == bin_scale::log, log_edges, no_edges> edges_{};
+    count_type counts_[slots]{};
+};
+
+} // namespace fastnum
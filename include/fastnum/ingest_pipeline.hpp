@@ -0,0 +1,373 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fastnum/buffered.hpp>
+#include <fastnum/running_stats.hpp>
+#include <fastnum/online_covariance.hpp>
+#include <fastnum/detail/parallel.hpp>
+#include <fastnum/detail/seqlock.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace fastnum {
+
+namespace detail {
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+/// Spin briefly, then yield: the thread being waited for may need this core.
+struct backoff {
+    unsigned spins = 0;
+
+    void pause() noexcept {
+        if (spins < 64) {
+            ++spins;
+            cpu_relax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+};
+
+/**
+ * Wait-free single-producer / single-consumer ring of samples of `Arity`
+ * values. Each side keeps a private copy of the other side's index and
+ * re-reads the shared one only when the copy says the ring is full (empty),
+ * so a push is one store of the values plus one release store of the index.
+ * The consumer reads the filled region in place and frees it separately,
+ * which lets it publish results before handing the slots back.
+ */
+template <class T, std::size_t Arity>
+class spsc_ring {
+public:
+    static constexpr std::size_t alignment = 128;
+
+    void init(std::size_t capacity) {
+        std::size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        mask_ = cap - 1;
+        data_.reset(new T[cap * Arity]);
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+
+    // --- Producer side ---
+
+    bool try_push(const T (&v)[Arity]) noexcept {
+        const std::uint64_t h = head_.load(std::memory_order_relaxed);
+        if (h - tail_cache_ > mask_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (h - tail_cache_ > mask_) return false;
+        }
+        T* slot = data_.get() + (h & mask_) * Arity;
+        for (std::size_t a = 0; a < Arity; ++a) slot[a] = v[a];
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // --- Consumer side ---
+
+    /// Pass the filled region to `fn(const T* values, std::size_t samples)`
+    /// (twice when it wraps) without freeing it; returns the sample count.
+    template <class Fn>
+    std::size_t peek(Fn&& fn) noexcept {
+        const std::uint64_t t = tail_.load(std::memory_order_relaxed);
+        if (head_cache_ == t) head_cache_ = head_.load(std::memory_order_acquire);
+        const std::size_t n = static_cast<std::size_t>(head_cache_ - t);
+        if (n == 0) return 0;
+        const std::size_t begin = static_cast<std::size_t>(t & mask_);
+        const std::size_t first = std::min(n, capacity() - begin);
+        fn(data_.get() + begin * Arity, first);
+        if (first < n) fn(data_.get(), n - first);
+        return n;
+    }
+
+    /// Free the `n` oldest samples.
+    void pop(std::size_t n) noexcept {
+        tail_.store(tail_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    [[nodiscard]] std::uint64_t pushed() const noexcept { return head_.load(std::memory_order_acquire); }
+    [[nodiscard]] std::uint64_t popped() const noexcept { return tail_.load(std::memory_order_acquire); }
+
+private:
+    alignas(alignment) std::atomic<std::uint64_t> head_{0};
+    std::uint64_t tail_cache_{0}; // producer's copy of tail_
+    alignas(alignment) std::atomic<std::uint64_t> tail_{0};
+    std::uint64_t head_cache_{0}; // consumer's copy of head_
+    alignas(alignment) std::size_t mask_{0};
+    std::unique_ptr<T[]> data_;
+};
+
+} // namespace detail
+
+/**
+ * @brief Knobs for `IngestPipeline`.
+ *
+ * - `producers`: number of SPSC lanes, i.e. concurrent producer handles
+ *   (`1` = single producer, `0` = `std::thread::hardware_concurrency()`).
+ * - `capacity`: samples per lane, rounded up to a power of two; a full lane
+ *   makes `observe` wait (`try_observe` fails) until the consumer catches up.
+ * - `idle_sleep`: how long the consumer sleeps per poll once it has found
+ *   nothing for a while; bounds both its idle CPU use and `flush()` latency.
+ */
+struct ingest_options {
+    std::size_t producers{1};
+    std::size_t capacity{std::size_t{1} << 14};
+    std::chrono::microseconds idle_sleep{50};
+};
+
+/**
+ * @brief Asynchronous ingestion: producers enqueue raw samples, a consumer
+ *        thread applies them to an accumulator in batches.
+ *
+ * Every producer handle owns one lock-free SPSC ring (a lane), so pushing a
+ * sample costs a store and an index bump, with no read-modify-write and no
+ * cache line shared with another producer; several lanes make the pipeline
+ * multi-producer without contention between producers. The consumer thread
+ * drains each lane's filled region in place through the accumulator's batch
+ * `observe` (or `observe_interleaved` for pair accumulators such as
+ * `OnlineCovariance`), so the SIMD kernels run on the consumer and the
+ * producers never touch the statistics.
+ *
+ * ## Snapshots
+ * After every drain the consumer publishes a copy of the state under a
+ * sequence lock (see `ShardedAccumulator`), and only then frees the slots.
+ * - `snapshot()` returns the latest published state without waiting; it may
+ *   lag the producers.
+ * - `flush()` waits until every sample pushed before the call is applied and
+ *   returns that state, so a producer sees all of its own samples.
+ *
+ * ## Usage
+ * - Create at most `lanes()` concurrent producers; `make_producer()` waits
+ *   for a free lane, `try_make_producer()` returns `std::nullopt`.
+ * - Samples are applied in push order per lane; lanes interleave arbitrarily.
+ * - The destructor applies every pushed sample and joins the consumer; no
+ *   producer may outlive the pipeline.
+ *
+ * @tparam Acc Trivially copyable accumulator with `value_type` and a batch
+ *             `observe(const T*, n)` (or `observe_interleaved(const T*, n)`).
+ */
+template <class Acc>
+class IngestPipeline {
+    static_assert(std::is_trivially_copyable_v<Acc>, "IngestPipeline requires a trivially copyable Acc");
+
+    using T = typename Acc::value_type;
+    static constexpr std::size_t arity = detail::observes_pairs<Acc>::value ? 2 : 1;
+
+    struct lane {
+        detail::spsc_ring<T, arity> ring;
+        alignas(detail::spsc_ring<T, arity>::alignment) std::atomic<bool> owned{false};
+    };
+
+public:
+    using accumulator_type = Acc;
+    using value_type = T;
+
+    class producer {
+    public:
+        producer(producer&& other) noexcept
+            : owner_(std::exchange(other.owner_, nullptr)), lane_(other.lane_) {}
+
+        producer& operator=(producer&& other) noexcept {
+            if (this != &other) {
+                release();
+                owner_ = std::exchange(other.owner_, nullptr);
+                lane_ = other.lane_;
+            }
+            return *this;
+        }
+
+        producer(const producer&) = delete;
+        producer& operator=(const producer&) = delete;
+
+        ~producer() { release(); }
+
+        /// Enqueue one sample, waiting while the lane is full.
+        template <class A = Acc, std::enable_if_t<!detail::observes_pairs<A>::value, int> = 0>
+        void observe(T x) noexcept {
+            const T v[1] = {x};
+            for (detail::backoff b; !lane_->ring.try_push(v);) b.pause();
+        }
+
+        /// Enqueue one pair, waiting while the lane is full.
+        template <class A = Acc, std::enable_if_t<detail::observes_pairs<A>::value, int> = 0>
+        void observe(T x, T y) noexcept {
+            const T v[2] = {x, y};
+            for (detail::backoff b; !lane_->ring.try_push(v);) b.pause();
+        }
+
+        /// Enqueue one sample unless the lane is full.
+        template <class A = Acc, std::enable_if_t<!detail::observes_pairs<A>::value, int> = 0>
+        [[nodiscard]] bool try_observe(T x) noexcept {
+            const T v[1] = {x};
+            return lane_->ring.try_push(v);
+        }
+
+        template <class A = Acc, std::enable_if_t<detail::observes_pairs<A>::value, int> = 0>
+        [[nodiscard]] bool try_observe(T x, T y) noexcept {
+            const T v[2] = {x, y};
+            return lane_->ring.try_push(v);
+        }
+
+    private:
+        friend class IngestPipeline;
+
+        producer(IngestPipeline* owner, lane* l) noexcept : owner_(owner), lane_(l) {}
+
+        void release() noexcept {
+            if (owner_) lane_->owned.store(false, std::memory_order_release);
+            owner_ = nullptr;
+        }
+
+        IngestPipeline* owner_;
+        lane* lane_;
+    };
+
+    /// Start the consumer thread; `initial` is the state samples are added to.
+    explicit IngestPipeline(const ingest_options& options = {}, const Acc& initial = Acc{})
+        : n_lanes_(detail::resolve_threads(options.producers)),
+          lanes_(new lane[n_lanes_]),
+          pending_(n_lanes_, 0),
+          idle_sleep_(options.idle_sleep),
+          acc_(initial) {
+        for (std::size_t i = 0; i < n_lanes_; ++i) lanes_[i].ring.init(options.capacity);
+        state_.publish(acc_);
+        consumer_ = std::thread([this] { run(); });
+    }
+
+    IngestPipeline(const IngestPipeline&) = delete;
+    IngestPipeline& operator=(const IngestPipeline&) = delete;
+
+    ~IngestPipeline() {
+        stop_.store(true, std::memory_order_release);
+        consumer_.join();
+    }
+
+    [[nodiscard]] std::size_t lanes() const noexcept { return n_lanes_; }
+
+    /// Claim a free lane, or `std::nullopt` if all are owned.
+    [[nodiscard]] std::optional<producer> try_make_producer() noexcept {
+        const std::size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        for (std::size_t k = 0; k < n_lanes_; ++k) {
+            lane& l = lanes_[(start + k) % n_lanes_];
+            bool expected = false;
+            if (!l.owned.load(std::memory_order_relaxed) &&
+                l.owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return producer(this, &l);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// Claim a free lane, yielding until one becomes available.
+    [[nodiscard]] producer make_producer() noexcept {
+        for (;;) {
+            if (auto p = try_make_producer()) return std::move(*p);
+            std::this_thread::yield();
+        }
+    }
+
+    /// Latest state published by the consumer (does not wait).
+    [[nodiscard]] Acc snapshot() const noexcept { return state_.read(); }
+
+    /// State including every sample pushed before this call.
+    [[nodiscard]] Acc flush() const noexcept {
+        for (std::size_t i = 0; i < n_lanes_; ++i) {
+            const auto& ring = lanes_[i].ring;
+            const std::uint64_t target = ring.pushed();
+            for (detail::backoff b; ring.popped() < target;) b.pause();
+        }
+        return state_.read();
+    }
+
+    /// Samples applied by the consumer so far.
+    [[nodiscard]] std::uint64_t consumed() const noexcept { return consumed_.load(std::memory_order_relaxed); }
+
+private:
+    void run() {
+        constexpr unsigned spin_polls = 256;
+        constexpr unsigned yield_polls = 256 + 64;
+        unsigned idle = 0;
+        for (;;) {
+            // Read the flag first: a drain that then finds nothing saw every
+            // sample pushed before the stop request.
+            const bool stopping = stop_.load(std::memory_order_acquire);
+            if (drain() > 0) {
+                idle = 0;
+                continue;
+            }
+            if (stopping) return;
+            if (++idle < spin_polls) {
+                detail::cpu_relax();
+            } else if (idle < yield_polls) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(idle_sleep_);
+            }
+        }
+    }
+
+    // Apply every lane's filled region, publish, then free the slots.
+    std::size_t drain() noexcept {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < n_lanes_; ++i) {
+            pending_[i] = lanes_[i].ring.peek([this](const T* values, std::size_t n) {
+                if constexpr (arity == 2) {
+                    acc_.observe_interleaved(values, n);
+                } else {
+                    acc_.observe(values, n);
+                }
+            });
+            total += pending_[i];
+        }
+        if (total == 0) return 0;
+        state_.publish(acc_);
+        for (std::size_t i = 0; i < n_lanes_; ++i) {
+            if (pending_[i]) lanes_[i].ring.pop(pending_[i]);
+        }
+        consumed_.fetch_add(total, std::memory_order_relaxed);
+        return total;
+    }
+
+    std::size_t n_lanes_;
+    std::unique_ptr<lane[]> lanes_;
+    std::vector<std::size_t> pending_; // consumer-only
+    std::chrono::microseconds idle_sleep_;
+    Acc acc_;                          // consumer-only
+    detail::seqlock_cell<Acc> state_;
+    std::atomic<std::uint64_t> consumed_{0};
+    std::atomic<bool> stop_{false};
+    std::thread consumer_;
+};
+
+/// Asynchronous `RunningStats` ingestion.
+template <typename T = double>
+using IngestRunningStats = IngestPipeline<RunningStats<T>>;
+
+/// Asynchronous `OnlineCovariance` ingestion (`observe(x, y)`).
+template <typename T = double>
+using IngestCovariance = IngestPipeline<OnlineCovariance<T>>;
+
+} // namespace fastnum
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <fastnum/detail/simd.hpp>
+
+namespace fastnum {
+
+/**
+ * @brief Instrumentation hooks that do nothing; the default of every policy.
+ *
+ * A hook type is a stateless class with
+ * - `static constexpr bool enabled`: when false, no hook is called and no
+ *   hook argument (e.g. the NaN count of a batch) is computed, so the
+ *   instrumented code compiles to exactly the uninstrumented code;
+ * - `on_observe(n)`: one observe call with `n` inputs (1 for scalar calls);
+ * - `on_nan(n)`: `n` NaN input values seen by that call;
+ * - `on_merge(parts)`: `parts` partial states merged in (1 per `merge`);
+ * - `on_not_ready(n)`: a transform on a not-ready scaler filled `n` NaNs.
+ *
+ * Hooks are selected per accumulator through `Policy::instrumentation`,
+ * e.g. `RunningStats<double, instrumented_policy<counting_instrumentation<>>>`.
+ * Hooks fire at the public entry points only: a batch observe is one
+ * `on_observe(n)`, not `n` scalar ones, and the merges a batch kernel does
+ * internally are not reported.
+ */
+struct no_instrumentation {
+    static constexpr bool enabled = false;
+    static constexpr void on_observe(std::size_t) noexcept {}
+    static constexpr void on_nan(std::size_t) noexcept {}
+    static constexpr void on_merge(std::size_t) noexcept {}
+    static constexpr void on_not_ready(std::size_t) noexcept {}
+};
+
+/// Point-in-time copy of a `counting_instrumentation` tally.
+struct instrumentation_snapshot {
+    /// `batch_sizes[b]` counts observe calls with `std::bit_width(n) == b`,
+    /// i.e. `n` in `[2^(b-1), 2^b - 1]`.
+    static constexpr std::size_t buckets = 65;
+
+    std::uint64_t samples = 0;
+    std::uint64_t observe_calls = 0;
+    std::uint64_t nans = 0;
+    std::uint64_t merges = 0;
+    std::uint64_t not_ready_transforms = 0;
+    std::uint64_t batch_sizes[buckets] = {};
+};
+
+/**
+ * @brief Hooks that tally every event into process-wide counters.
+ *
+ * Counters are relaxed atomics shared by all accumulators using the same
+ * `Tag`, so one tally can cover a whole subsystem; use distinct tags to keep
+ * subsystems apart. Each event costs one or two uncontended atomic adds,
+ * plus a NaN scan per batch. Heavily multi-threaded writers sharing a tag
+ * will contend on its cache lines.
+ *
+ * @tparam Tag Any type; distinct tags have independent counters.
+ */
+template <class Tag = void>
+struct counting_instrumentation {
+    static constexpr bool enabled = true;
+
+    static void on_observe(std::size_t n) noexcept {
+        counters_.samples.fetch_add(n, std::memory_order_relaxed);
+        counters_.calls.fetch_add(1, std::memory_order_relaxed);
+        counters_.batch_sizes[std::bit_width(n)].fetch_add(1, std::memory_order_relaxed);
+    }
+    static void on_nan(std::size_t n) noexcept { counters_.nans.fetch_add(n, std::memory_order_relaxed); }
+    static void on_merge(std::size_t parts) noexcept {
+        counters_.merges.fetch_add(parts, std::memory_order_relaxed);
+    }
+    static void on_not_ready(std::size_t n) noexcept {
+        counters_.not_ready.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /// Current tally; counters updated concurrently may be captured at
+    /// slightly different instants.
+    [[nodiscard]] static instrumentation_snapshot snapshot() noexcept {
+        instrumentation_snapshot s;
+        s.samples = counters_.samples.load(std::memory_order_relaxed);
+        s.observe_calls = counters_.calls.load(std::memory_order_relaxed);
+        s.nans = counters_.nans.load(std::memory_order_relaxed);
+        s.merges = counters_.merges.load(std::memory_order_relaxed);
+        s.not_ready_transforms = counters_.not_ready.load(std::memory_order_relaxed);
+        for (std::size_t b = 0; b < instrumentation_snapshot::buckets; ++b) {
+            s.batch_sizes[b] = counters_.batch_sizes[b].load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+
+    static void reset() noexcept {
+        counters_.samples.store(0, std::memory_order_relaxed);
+        counters_.calls.store(0, std::memory_order_relaxed);
+        counters_.nans.store(0, std::memory_order_relaxed);
+        counters_.merges.store(0, std::memory_order_relaxed);
+        counters_.not_ready.store(0, std::memory_order_relaxed);
+        for (auto& b : counters_.batch_sizes) b.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct counters {
+        std::atomic<std::uint64_t> samples{0};
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> nans{0};
+        std::atomic<std::uint64_t> merges{0};
+        std::atomic<std::uint64_t> not_ready{0};
+        std::atomic<std::uint64_t> batch_sizes[instrumentation_snapshot::buckets]{};
+    };
+
+    static inline counters counters_{};
+};
+
+/**
+ * @brief Push a snapshot into a metrics backend.
+ *
+ * `Exporter` needs two members, called once per metric:
+ * - `counter(std::string_view name, std::uint64_t value)` for the totals
+ *   `fastnum_samples`, `fastnum_observe_calls`, `fastnum_nans`,
+ *   `fastnum_merges` and `fastnum_not_ready_transforms`;
+ * - `bucket(std::string_view name, std::uint64_t upper_bound, std::uint64_t count)`
+ *   for every non-empty `fastnum_batch_size` bucket, where `count` observe
+ *   calls had between `upper_bound / 2 + 1` and `upper_bound` inputs
+ *   (non-cumulative; `upper_bound` saturates at 2^64 - 1).
+ */
+template <class Exporter>
+void export_metrics(const instrumentation_snapshot& s, Exporter& exporter) {
+    exporter.counter(std::string_view{"fastnum_samples"}, s.samples);
+    exporter.counter(std::string_view{"fastnum_observe_calls"}, s.observe_calls);
+    exporter.counter(std::string_view{"fastnum_nans"}, s.nans);
+    exporter.counter(std::string_view{"fastnum_merges"}, s.merges);
+    exporter.counter(std::string_view{"fastnum_not_ready_transforms"}, s.not_ready_transforms);
+    for (std::size_t b = 0; b < instrumentation_snapshot::buckets; ++b) {
+        if (s.batch_sizes[b] == 0) continue;
+        const std::uint64_t upper = b == 0 ? 0 : b == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << b) - 1;
+        exporter.bucket(std::string_view{"fastnum_batch_size"}, upper, s.batch_sizes[b]);
+    }
+}
+
+namespace detail {
+
+template <class Policy, class = void>
+struct instrumentation_of {
+    using type = no_instrumentation;
+};
+
+template <class Policy>
+struct instrumentation_of<Policy, std::void_t<typename Policy::instrumentation>> {
+    using type = typename Policy::instrumentation;
+};
+
+/// `Policy::instrumentation` if present, else `no_instrumentation`.
+template <class Policy>
+using instrumentation_of_t = typename instrumentation_of<Policy>::type;
+
+/// NaNs among `xs[0], xs[stride], ..., xs[(n - 1) * stride]`.
+template <class T>
+std::size_t count_nan(const T* xs, std::size_t n, std::size_t stride = 1) noexcept {
+    if (stride == 0) return xs[0] != xs[0] ? n : 0;
+    std::size_t nans = 0;
+    if (stride != 1) {
+        for (const T* end = xs + n * stride; xs != end; xs += stride) nans += *xs != *xs ? 1u : 0u;
+        return nans;
+    }
+    using B = simd::batch<T>;
+    std::size_t i = 0;
+    for (; i + B::width <= n; i += B::width) nans += B::width - B::popcount(ordered(B::load(xs + i)));
+    for (; i < n; ++i) nans += xs[i] != xs[i] ? 1u : 0u;
+    return nans;
+}
+
+/// Report one batch observe of `n` inputs to hooks `I`.
+template <class I, class T>
+constexpr void note_observe(const T* xs, std::size_t n, std::size_t stride = 1) noexcept {
+    if constexpr (I::enabled) {
+        I::on_observe(n);
+        if (const std::size_t nans = count_nan(xs, n, stride)) I::on_nan(nans);
+    }
+}
+
+/// Report one scalar observe of `x` to hooks `I`.
+template <class I, class T>
+constexpr void note_observe(T x) noexcept {
+    if constexpr (I::enabled) {
+        I::on_observe(1);
+        if (x != x) I::on_nan(1);
+    }
+}
+
+} // namespace detail
+
+} // namespace fastnum
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fastnum/running_stats.hpp>
+#include <fastnum/online_covariance.hpp>
+#include <fastnum/online_standard_scaler.hpp>
+
+namespace fastnum {
+
+namespace detail {
+
+inline void prefetch(const void* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Per-key accumulators in a flat open-addressed table.
+ *
+ * Replaces `std::unordered_map<Key, Acc>` for group-by statistics. Keys and
+ * accumulators live in two dense arrays indexed by a stable id (insertion
+ * order); the hash index is an array of 8-byte slots `{id, hash tag}` with
+ * linear probing and Fibonacci hashing, kept at most 3/4 full. There is one
+ * allocation per array instead of one heap node per key, and iteration,
+ * merging and serialization (`values()` is a plain `Acc` array) walk
+ * contiguous memory.
+ *
+ * ## Batch observe
+ * `observe(keys, xs, n)` is a sliding software pipeline: while element `i`
+ * is resolved (or inserted) and updated, element `i + 8` has the key and
+ * accumulator its home slot points to prefetched, and element `i + 16` is
+ * hashed and has its home slot prefetched. The cache misses of nearby keys
+ * therefore overlap instead of being paid one key at a time. Tables smaller
+ * than 256 KiB (index plus arrays, i.e. L2-resident) take a plain loop
+ * without prefetches. Updates are applied in input order.
+ *
+ * ## Notes
+ * - Ids, and with them `keys()` / `values()` order, never change; pointers
+ *   and references into the arrays are invalidated by inserts, as with
+ *   `std::vector`.
+ * - New keys start as a copy of the prototype given to the constructor
+ *   (e.g. a configured `ExponentialStats`).
+ * - Keys cannot be erased individually; use `clear()`.
+ * - Not thread-safe; shard by key and `merge()` the tables instead.
+ *
+ * @tparam Key      Key type (copyable).
+ * @tparam Acc      Accumulator with `merge(const Acc&)`.
+ * @tparam Hash     Hash for `Key`; its result is re-mixed, so identity hashes are fine.
+ * @tparam KeyEqual Equality for `Key`.
+ */
+template <class Key, class Acc, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class KeyedAccumulator {
+public:
+    using key_type = Key;
+    using accumulator_type = Acc;
+
+    explicit KeyedAccumulator(Acc prototype = Acc{}, std::size_t expected_keys = 0)
+        : prototype_(std::move(prototype)) {
+        reserve(expected_keys);
+    }
+
+    // --- Capacity ------------------------------------------------------------
+
+    [[nodiscard]] std::size_t size() const noexcept { return keys_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+
+    /// Make room for `keys` distinct keys without rehashing.
+    void reserve(std::size_t keys) {
+        keys_.reserve(keys);
+        values_.reserve(keys);
+        ensure_slots(keys);
+    }
+
+    /// Remove every key (keeps the allocated storage).
+    void clear() noexcept {
+        keys_.clear();
+        values_.clear();
+        for (slot& s : slots_) s.id = empty_id;
+    }
+
+    // --- Lookup --------------------------------------------------------------
+
+    /// Accumulator for `key`, inserting a copy of the prototype if absent.
+    Acc& operator[](const Key& key) {
+        ensure_slots(size() + 1);
+        return values_[find_or_insert(key, hash_of(key))];
+    }
+
+    [[nodiscard]] Acc* find(const Key& key) noexcept {
+        const std::uint32_t id = find_id(key);
+        return id == empty_id ? nullptr : &values_[id];
+    }
+
+    [[nodiscard]] const Acc* find(const Key& key) const noexcept {
+        const std::uint32_t id = find_id(key);
+        return id == empty_id ? nullptr : &values_[id];
+    }
+
+    [[nodiscard]] bool contains(const Key& key) const noexcept { return find_id(key) != empty_id; }
+
+    /// Dense key / accumulator arrays; `values()[i]` belongs to `keys()[i]`.
+    [[nodiscard]] const Key* keys() const noexcept { return keys_.data(); }
+    [[nodiscard]] const Acc* values() const noexcept { return values_.data(); }
+    [[nodiscard]] Acc* values() noexcept { return values_.data(); }
+
+    /// Call `fn(key, acc)` for every key in insertion order.
+    template <class Fn>
+    void for_each(Fn&& fn) const {
+        for (std::size_t i = 0; i < size(); ++i) fn(keys_[i], values_[i]);
+    }
+
+    // --- Observe -------------------------------------------------------------
+
+    /// Forward to `Acc::observe(args...)` of `key`'s accumulator.
+    template <class... Args>
+    auto observe(const Key& key, Args&&... args)
+        -> decltype(std::declval<Acc&>().observe(std::forward<Args>(args)...), void()) {
+        (*this)[key].observe(std::forward<Args>(args)...);
+    }
+
+    /// Bulk `observe(keys[i], xs[i])`, with the misses of each block overlapped.
+    template <class U>
+    auto observe(const Key* keys, const U* xs, std::size_t n)
+        -> decltype(std::declval<Acc&>().observe(xs[0]), void()) {
+        if (!keys || !xs) return;
+        observe_bulk(keys, n, [xs](Acc& acc, std::size_t i) { acc.observe(xs[i]); });
+    }
+
+    /// Bulk `observe(keys[i], xs[i], ys[i])`, e.g. for `OnlineCovariance`.
+    template <class U>
+    auto observe(const Key* keys, const U* xs, const U* ys, std::size_t n)
+        -> decltype(std::declval<Acc&>().observe(xs[0], ys[0]), void()) {
+        if (!keys || !xs || !ys) return;
+        observe_bulk(keys, n, [xs, ys](Acc& acc, std::size_t i) { acc.observe(xs[i], ys[i]); });
+    }
+
+    // --- Transform -----------------------------------------------------------
+
+    /**
+     * @brief `out[i] = acc(keys[i]).transform(in[i])`, for keyed scalers.
+     *
+     * Unknown keys produce `NaN`, as a scaler that has not seen any data.
+     * `in` and `out` may alias.
+     */
+    template <class U, class A = Acc>
+    auto transform(const Key* keys, const U* in, U* out, std::size_t n) const noexcept
+        -> decltype(out[0] = std::declval<const A&>().transform(in[0]), void()) {
+        if (!keys || !in || !out) return;
+        for (std::size_t i = 0; i < n; ++i) {
+            const Acc* acc = find(keys[i]);
+            out[i] = acc ? acc->transform(in[i]) : std::numeric_limits<U>::quiet_NaN();
+        }
+    }
+
+    // --- Merge ---------------------------------------------------------------
+
+    /// Key-wise `Acc::merge`; keys only present in `other` are added.
+    void merge(const KeyedAccumulator& other) {
+        if (other.empty()) return;
+        if (&other == this) {
+            const KeyedAccumulator copy(other);
+            merge(copy);
+            return;
+        }
+        ensure_slots(size() + other.size());
+        for (std::size_t i = 0; i < other.size(); ++i) {
+            const std::uint32_t id = find_or_insert(other.keys_[i], hash_of(other.keys_[i]));
+            values_[id].merge(other.values_[i]);
+        }
+    }
+
+private:
+    static constexpr std::uint32_t empty_id = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t bulk_distance = 8;
+    static constexpr std::size_t bulk_prefetch_bytes = std::size_t{256} << 10;
+
+    struct slot {
+        std::uint32_t id;
+        std::uint32_t tag;
+    };
+
+    [[nodiscard]] std::uint64_t hash_of(const Key& key) const noexcept {
+        // Fibonacci re-mix: the high bits pick the slot, so weak hashes
+        // (std::hash of an integer is the identity) still spread evenly.
+        return static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+    }
+
+    [[nodiscard]] std::size_t home(std::uint64_t h) const noexcept {
+        return static_cast<std::size_t>(h >> shift_);
+    }
+
+    [[nodiscard]] static std::uint32_t tag_of(std::uint64_t h) noexcept {
+        return static_cast<std::uint32_t>(h);
+    }
+
+    [[nodiscard]] std::uint32_t find_id(const Key& key) const noexcept {
+        if (slots_.empty()) return empty_id;
+        const std::uint64_t h = hash_of(key);
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = home(h);; i = (i + 1) & mask) {
+            const slot s = slots_[i];
+            if (s.id == empty_id) return empty_id;
+            if (s.tag == tag_of(h) && eq_(keys_[s.id], key)) return s.id;
+        }
+    }
+
+    // Requires ensure_slots(size() + 1) beforehand.
+    std::uint32_t find_or_insert(const Key& key, std::uint64_t h) {
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = home(h);; i = (i + 1) & mask) {
+            slot& s = slots_[i];
+            if (s.id == empty_id) {
+                assert(keys_.size() < empty_id);
+                const auto id = static_cast<std::uint32_t>(keys_.size());
+                keys_.push_back(key);
+                values_.push_back(prototype_);
+                s = {id, tag_of(h)};
+                return id;
+            }
+            if (s.tag == tag_of(h) && eq_(keys_[s.id], key)) return s.id;
+        }
+    }
+
+    // Grow the index so that `keys` entries stay within the 3/4 load limit.
+    void ensure_slots(std::size_t keys) {
+        if (keys * 4 <= slots_.size() * 3) return;
+        std::size_t cap = 16;
+        unsigned bits = 4;
+        while (keys * 4 > cap * 3) {
+            cap *= 2;
+            ++bits;
+        }
+        if (cap <= slots_.size()) return;
+
+        slots_.assign(cap, slot{empty_id, 0});
+        shift_ = 64 - bits;
+        const std::size_t mask = cap - 1;
+        for (std::size_t id = 0; id < keys_.size(); ++id) {
+            const std::uint64_t h = hash_of(keys_[id]);
+            std::size_t i = home(h);
+            while (slots_[i].id != empty_id) i = (i + 1) & mask;
+            slots_[i] = {static_cast<std::uint32_t>(id), tag_of(h)};
+        }
+    }
+
+    // Software pipeline over the input: element i + 2D has its home slot
+    // prefetched, element i + D has the key / accumulator its slot points to
+    // prefetched, and element i is resolved and updated. Prefetches are only
+    // hints, so a rehash in between is harmless. Tables that still fit in L2
+    // take the plain loop, where the extra stages are pure overhead.
+    template <class Update>
+    void observe_bulk(const Key* keys, std::size_t n, Update&& update) {
+        const std::size_t footprint =
+            slots_.size() * sizeof(slot) + size() * (sizeof(Key) + sizeof(Acc));
+        if (footprint < bulk_prefetch_bytes) {
+            for (std::size_t i = 0; i < n; ++i) {
+                ensure_slots(size() + 1);
+                update(values_[find_or_insert(keys[i], hash_of(keys[i]))], i);
+            }
+            return;
+        }
+
+        constexpr std::size_t D = bulk_distance;
+        std::uint64_t h[4 * D];
+        const auto stage_slot = [&](std::size_t i) {
+            h[i % (4 * D)] = hash_of(keys[i]);
+            detail::prefetch(&slots_[home(h[i % (4 * D)])]);
+        };
+        const auto stage_peek = [&](std::size_t i) {
+            const slot s = slots_[home(h[i % (4 * D)])];
+            if (s.id != empty_id) {
+                detail::prefetch(&keys_[s.id]);
+                detail::prefetch(&values_[s.id]);
+            }
+        };
+
+        ensure_slots(size() + 1);
+        for (std::size_t i = 0; i < n && i < 2 * D; ++i) stage_slot(i);
+        for (std::size_t i = 0; i < n && i < D; ++i) stage_peek(i);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i + 2 * D < n) stage_slot(i + 2 * D);
+            if (i + D < n) stage_peek(i + D);
+            ensure_slots(size() + 1);
+            update(values_[find_or_insert(keys[i], h[i % (4 * D)])], i);
+        }
+    }
+
+    std::vector<slot> slots_;
+    std::vector<Key> keys_;
+    std::vector<Acc> values_;
+    unsigned shift_{64};
+    Acc prototype_;
+    [[no_unique_address]] Hash hash_{};
+    [[no_unique_address]] KeyEqual eq_{};
+};
+
+/// Per-key `RunningStats`.
+template <class Key, typename T = double, class Hash = std::hash<Key>>
+using KeyedRunningStats = KeyedAccumulator<Key, RunningStats<T>, Hash>;
+
+/// Per-key `OnlineCovariance`.
+template <class Key, typename T = double, class Hash = std::hash<Key>>
+using KeyedCovariance = KeyedAccumulator<Key, OnlineCovariance<T>, Hash>;
+
+/// Per-key `OnlineStandardScaler`; see `KeyedAccumulator::transform`.
+template <class Key, typename T = double, class Hash = std::hash<Key>>
+using KeyedStandardScaler = KeyedAccumulator<Key, OnlineStandardScaler<T>, Hash>;
+
+} // namespace fastnum
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <fastnum/running_stats.hpp>
+#include <fastnum/online_standard_scaler.hpp>
+#include <fastnum/detail/simd.hpp>
+
+namespace fastnum {
+
+/**
+ * @brief Online z-score standardization of many feature columns at once.
+ *
+ * Equivalent to one `OnlineStandardScaler<T>` per feature, but the state is
+ * stored as structure-of-arrays (`means`, `M2`, cached `1/stddev`) with a
+ * single sample count shared by all features (every observe call feeds the
+ * same samples to every feature). Row-major batches are processed one sample
+ * at a time with the Welford update vectorized *across* features, so each row
+ * is a handful of contiguous SIMD loads instead of one strided scalar update
+ * per feature. Column-major batches go through the `RunningStats` batch
+ * kernel per column.
+ *
+ * ## Layouts
+ * - Row-major: `rows[r * ld + j]` is feature `j` of sample `r`.
+ * - Column-major: `cols[j * ld + r]` is feature `j` of sample `r`.
+ * `ld == 0` means densely packed (`features()` resp. `n_rows`).
+ *
+ * ## Readiness / NaN policy
+ * Per feature, exactly as `OnlineStandardScaler`: feature `j` is ready once at
+ * least 2 samples were seen and its population variance exceeds `eps^2`.
+ * Transforms write `NaN` for features that are not ready.
+ *
+ * Storage for `features()` columns is allocated once by the constructor.
+ *
+ * @tparam T Floating-point type for accumulation and output.
+ */
+template <typename T = double>
+class MultiStandardScaler {
+    static_assert(std::is_floating_point_v<T>, "MultiStandardScaler requires floating point T");
+
+public:
+    explicit MultiStandardScaler(std::size_t features)
+        : d_(features), mean_(features, T{0}), m2_(features, T{0}),
+          inv_std_(features, std::numeric_limits<T>::quiet_NaN()) {}
+
+    // --- Observe -------------------------------------------------------------
+
+    /**
+     * @brief Observe `n_rows` samples stored row-major.
+     *
+     * @param rows   Pointer to feature 0 of sample 0.
+     * @param n_rows Number of samples.
+     * @param ld     Elements between consecutive samples (`0` = `features()`).
+     */
+    void observe_rows(const T* rows, std::size_t n_rows, std::size_t ld = 0) noexcept {
+        if (!rows || n_rows == 0) return;
+        if (ld == 0) ld = d_;
+        assert(ld >= d_);
+
+        using B = detail::simd::batch<T>;
+        constexpr std::size_t W = B::width;
+        T* mean = mean_.data();
+        T* m2 = m2_.data();
+
+        for (std::size_t r = 0; r < n_rows; ++r) {
+            const T* x = rows + r * ld;
+            ++n_;
+            const T inv_n = T{1} / static_cast<T>(n_);
+            const B vinv = B::broadcast(inv_n);
+
+            std::size_t j = 0;
+            for (; j + W <= d_; j += W) {
+                const B xv = B::load(x + j);
+                B mv = B::load(mean + j);
+                const B delta = xv - mv;
+                mv = fma(delta, vinv, mv);
+                fma(delta, xv - mv, B::load(m2 + j)).store(m2 + j);
+                mv.store(mean + j);
+            }
+            for (; j < d_; ++j) {
+                const T delta = x[j] - mean[j];
+                mean[j] += delta * inv_n;
+                m2[j] += delta * (x[j] - mean[j]);
+            }
+        }
+        refresh();
+    }
+
+    /**
+     * @brief Observe `n_rows` samples stored column-major.
+     *
+     * @param cols   Pointer to sample 0 of feature 0.
+     * @param n_rows Number of samples (length of each column).
+     * @param ld     Elements between consecutive columns (`0` = `n_rows`).
+     */
+    void observe_columns(const T* cols, std::size_t n_rows, std::size_t ld = 0) noexcept {
+        if (!cols || n_rows == 0) return;
+        if (ld == 0) ld = n_rows;
+        assert(ld >= n_rows);
+
+        const T n_a = static_cast<T>(n_);
+        const T n_b = static_cast<T>(n_rows);
+        const T n_t = n_a + n_b;
+        for (std::size_t j = 0; j < d_; ++j) {
+            RunningStats<T> col;
+            col.observe(cols + j * ld, n_rows);
+            const T delta = col.mean() - mean_[j];
+            mean_[j] += delta * (n_b / n_t);
+            m2_[j] += col.m2() + delta * delta * (n_a * n_b / n_t);
+        }
+        n_ += n_rows;
+        refresh();
+    }
+
+    // --- Accessors -----------------------------------------------------------
+
+    [[nodiscard]] std::size_t features() const noexcept { return d_; }
+    [[nodiscard]] std::size_t count() const noexcept { return n_; }
+    [[nodiscard]] T mean(std::size_t j) const noexcept { return mean_[j]; }
+    [[nodiscard]] const T* means() const noexcept { return mean_.data(); }
+
+    [[nodiscard]] T variance_population(std::size_t j) const noexcept {
+        if (n_ < 1) return std::numeric_limits<T>::quiet_NaN();
+        return m2_[j] / static_cast<T>(n_);
+    }
+
+    /// Cached `1 / stddev` of feature `j`, `NaN` if the feature is not ready.
+    [[nodiscard]] T inv_std(std::size_t j) const noexcept { return inv_std_[j]; }
+
+    /// Whether feature `j` can be standardized.
+    [[nodiscard]] bool ready(std::size_t j) const noexcept { return !std::isnan(inv_std_[j]); }
+
+    /// Whether every feature can be standardized.
+    [[nodiscard]] bool ready() const noexcept {
+        for (std::size_t j = 0; j < d_; ++j) {
+            if (!ready(j)) return false;
+        }
+        return d_ > 0;
+    }
+
+    /// Snapshot of feature `j` (see `OnlineStandardScaler::freeze`).
+    [[nodiscard]] FrozenStandardScaler<T> freeze(std::size_t j) const noexcept {
+        if (!ready(j)) return {};
+        return {mean_[j], inv_std_[j]};
+    }
+
+    // --- Transform -----------------------------------------------------------
+
+    /// Standardize `n_rows` dense row-major samples from `in` into `out` (`in == out` allowed).
+    void transform_rows(const T* in, T* out, std::size_t n_rows) const noexcept {
+        if (!in || !out || n_rows == 0) return;
+
+        using B = detail::simd::batch<T>;
+        constexpr std::size_t W = B::width;
+        const T* mean = mean_.data();
+        const T* s = inv_std_.data();
+
+        for (std::size_t r = 0; r < n_rows; ++r) {
+            const T* x = in + r * d_;
+            T* z = out + r * d_;
+            std::size_t j = 0;
+            for (; j + W <= d_; j += W) {
+                ((B::load(x + j) - B::load(mean + j)) * B::load(s + j)).store(z + j);
+            }
+            for (; j < d_; ++j) z[j] = (x[j] - mean[j]) * s[j];
+        }
+    }
+
+    /// Standardize `n_rows` dense column-major samples from `in` into `out` (`in == out` allowed).
+    void transform_columns(const T* in, T* out, std::size_t n_rows) const noexcept {
+        if (!in || !out || n_rows == 0) return;
+        for (std::size_t j = 0; j < d_; ++j) {
+            detail::standardize(in + j * n_rows, out + j * n_rows, n_rows, mean_[j], inv_std_[j]);
+        }
+    }
+
+    // --- Merge / reset -------------------------------------------------------
+
+    /// Merge another scaler with the same `features()` (Chan et al.).
+    void merge(const MultiStandardScaler& other) noexcept {
+        assert(other.d_ == d_);
+        if (other.n_ == 0) return;
+        if (n_ == 0) {
+            *this = other;
+            return;
+        }
+
+        using B = detail::simd::batch<T>;
+        constexpr std::size_t W = B::width;
+        const T n_a = static_cast<T>(n_);
+        const T n_b = static_cast<T>(other.n_);
+        const T n_t = n_a + n_b;
+        const T f = n_b / n_t;
+        const T w = n_a * n_b / n_t;
+        const B vf = B::broadcast(f);
+        const B vw = B::broadcast(w);
+
+        T* mean = mean_.data();
+        T* m2 = m2_.data();
+        const T* omean = other.mean_.data();
+        const T* om2 = other.m2_.data();
+
+        std::size_t j = 0;
+        for (; j + W <= d_; j += W) {
+            const B ma = B::load(mean + j);
+            const B delta = B::load(omean + j) - ma;
+            fma(delta, vf, ma).store(mean + j);
+            fma(delta * delta, vw, B::load(m2 + j) + B::load(om2 + j)).store(m2 + j);
+        }
+        for (; j < d_; ++j) {
+            const T delta = omean[j] - mean[j];
+            mean[j] += delta * f;
+            m2[j] += om2[j] + delta * delta * w;
+        }
+        n_ += other.n_;
+        refresh();
+    }
+
+    void reset() noexcept {
+        n_ = 0;
+        std::fill(mean_.begin(), mean_.end(), T{0});
+        std::fill(m2_.begin(), m2_.end(), T{0});
+        std::fill(inv_std_.begin(), inv_std_.end(), std::numeric_limits<T>::quiet_NaN());
+    }
+
+private:
+    // Recompute the cached 1/stddev of every feature after a state change.
+    void refresh() noexcept {
+        const T nan = std::numeric_limits<T>::quiet_NaN();
+        if (n_ < 2) {
+            std::fill(inv_std_.begin(), inv_std_.end(), nan);
+            return;
+        }
+        const T inv_n = T{1} / static_cast<T>(n_);
+        for (std::size_t j = 0; j < d_; ++j) {
+            const T var = m2_[j] * inv_n;
+            inv_std_[j] = (var > eps_ * eps_) ? T{1} / std::sqrt(var) : nan;
+        }
+    }
+
+    static constexpr T eps_ = default_policy::eps<T>;
+
+    std::size_t d_{0};
+    std::size_t n_{0};
+    std::vector<T> mean_;
+    std::vector<T> m2_;
+    std::vector<T> inv_std_;
+};
+
+} // namespace fastnum
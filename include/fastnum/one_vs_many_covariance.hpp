@@ -0,0 +1,317 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <fastnum/policy.hpp>
+#include <fastnum/detail/simd.hpp>
+
+namespace fastnum {
+
+namespace detail {
+
+template <typename T, std::size_t D>
+struct one_vs_many_storage {
+    std::array<T, D> mean{};
+    std::array<T, D> m2{};
+    std::array<T, D> c{};
+
+    [[nodiscard]] constexpr std::size_t dim() const noexcept { return D; }
+};
+
+template <typename T>
+struct one_vs_many_storage<T, std::dynamic_extent> {
+    std::size_t d{0};
+    std::vector<T> mean;
+    std::vector<T> m2;
+    std::vector<T> c;
+
+    one_vs_many_storage() = default;
+    explicit one_vs_many_storage(std::size_t dim)
+        : d(dim), mean(dim, T{0}), m2(dim, T{0}), c(dim, T{0}) {}
+
+    [[nodiscard]] std::size_t dim() const noexcept { return d; }
+};
+
+} // namespace detail
+
+/**
+ * @brief Covariance / correlation of one target against D candidate features.
+ *
+ * Replaces D `OnlineCovariance` objects that would each re-track the same
+ * target: the target's count, mean and M2 are kept once, the candidates'
+ * means, M2s and cross-moments with the target as three SoA arrays. Candidate
+ * `j` holds exactly the state an `OnlineCovariance` fed `(x_j, y)` would.
+ *
+ * ## Batch ingestion
+ * `observe(ys, rows, n)` takes the targets plus a row-major `n x D` candidate
+ * block. Per block of up to `block_rows` samples (fewer for wide rows, so a
+ * block stays in L2) the target is updated first, which fixes each sample's
+ * `1/n` and centered target `y - mean_y`; those are shared by every
+ * candidate. The candidates are then swept in strips of SIMD registers, each
+ * strip running the Welford recurrence down the whole block with its means,
+ * M2s and cross-moments held in registers: three FMAs per candidate and
+ * sample, no division, and one load / store of the state per block instead
+ * of per sample.
+ *
+ * ## Dimension
+ * - `OneVsManyCovariance<T, D>`: compile-time D, inline storage, no allocation.
+ * - `OneVsManyCovariance<T>`: runtime D given to the constructor; storage is
+ *   allocated once there and never again.
+ *
+ * ## Readiness / NaN policy
+ * Readiness as for `OnlineCovariance`: variances / covariances need 1
+ * (population) or 2 (sample) observations, otherwise `NaN`; `correlation(j)`
+ * is `NaN` when either variance is not above `Policy::eps<T>^2`. NaN inputs
+ * always propagate (a NaN target poisons every candidate), and hooks are
+ * not supported: policies with `nan_policy::skip` / `count_and_skip` or with
+ * enabled instrumentation are rejected at compile time.
+ *
+ * @tparam T      Floating-point type.
+ * @tparam D      Number of candidates, or `std::dynamic_extent` for runtime D.
+ * @tparam Policy Count type and readiness threshold (see `default_policy`).
+ */
+template <typename T = double, std::size_t D = std::dynamic_extent, class Policy = default_policy>
+class OneVsManyCovariance {
+    static_assert(std::is_floating_point_v<T>, "OneVsManyCovariance requires floating point T");
+    static_assert(detail::is_policy_v<Policy>, "OneVsManyCovariance requires a fastnum policy");
+    static_assert(!detail::compensated_of_v<Policy>, "OneVsManyCovariance does not implement compensated_policy");
+    static_assert(detail::nan_policy_of_v<Policy> == nan_policy::propagate,
+                  "OneVsManyCovariance only supports nan_policy::propagate");
+    static_assert(!detail::instrumentation_of_t<Policy>::enabled,
+                  "OneVsManyCovariance does not support instrumentation hooks");
+
+public:
+    using value_type = T;
+    using policy_type = Policy;
+    using count_type = typename Policy::count_type;
+
+    /// Most samples per target pre-pass in the batch path.
+    static constexpr std::size_t block_rows = 256;
+
+    constexpr OneVsManyCovariance() noexcept requires (D != std::dynamic_extent) = default;
+
+    explicit OneVsManyCovariance(std::size_t dim) requires (D == std::dynamic_extent) : s_(dim) {}
+
+    // --- Observe -------------------------------------------------------------
+
+    /// Observe target `y` with the `dim()` candidate values in `row`.
+    void observe(T y, const T* row) noexcept {
+        if (!row) return;
+        observe_block(&y, row, 1, dim());
+    }
+
+    /**
+     * @brief Observe `n_rows` samples.
+     *
+     * @param ys     `n_rows` target values.
+     * @param rows   Row-major candidate values, one row of `dim()` per target.
+     * @param n_rows Number of samples.
+     * @param ld     Distance (in elements) between consecutive rows;
+     *               `0` means densely packed (`ld == dim()`).
+     */
+    void observe(const T* ys, const T* rows, std::size_t n_rows, std::size_t ld = 0) noexcept {
+        if (!ys || !rows || n_rows == 0) return;
+        if (ld == 0) ld = dim();
+        assert(ld >= dim());
+        // Wide rows get shorter blocks, so that a block (~256 KiB) stays in
+        // L2 and a strip's walk down it stays within the TLB reach. With no
+        // candidates only the target is tracked, in full blocks.
+        const std::size_t k = dim() == 0 ? block_rows
+                                         : std::clamp<std::size_t>((std::size_t{256} << 10) / (ld * sizeof(T)),
+                                                                   16, block_rows);
+        for (std::size_t r = 0; r < n_rows; r += k) {
+            observe_block(ys + r, rows + r * ld, std::min(k, n_rows - r), ld);
+        }
+    }
+
+    // --- Basic accessors -----------------------------------------------------
+
+    [[nodiscard]] std::size_t count() const noexcept { return n_; }
+    [[nodiscard]] std::size_t dim() const noexcept { return s_.dim(); }
+
+    [[nodiscard]] T mean_target() const noexcept { return mean_y_; }
+    [[nodiscard]] T mean(std::size_t j) const noexcept { return s_.mean[j]; }
+    [[nodiscard]] const T* means() const noexcept { return s_.mean.data(); }
+
+    // --- Variances / Covariance ---------------------------------------------
+
+    [[nodiscard]] T variance_target_population() const noexcept { return moment(m2_y_, 1); }
+    [[nodiscard]] T variance_target_sample() const noexcept { return moment(m2_y_, 2); }
+    [[nodiscard]] T variance_population(std::size_t j) const noexcept { return moment(s_.m2[j], 1); }
+    [[nodiscard]] T variance_sample(std::size_t j) const noexcept { return moment(s_.m2[j], 2); }
+    [[nodiscard]] T covariance_population(std::size_t j) const noexcept { return moment(s_.c[j], 1); }
+    [[nodiscard]] T covariance_sample(std::size_t j) const noexcept { return moment(s_.c[j], 2); }
+
+    /// Pearson correlation of candidate `j` with the target.
+    [[nodiscard]] T correlation(std::size_t j) const noexcept {
+        if (n_ < 2 || !target_varies()) return std::numeric_limits<T>::quiet_NaN();
+        return correlation_of(j);
+    }
+
+    /// Write all `dim()` sample covariances with the target to `out`.
+    void covariances_sample(T* out) const noexcept {
+        for (std::size_t j = 0; j < dim(); ++j) out[j] = covariance_sample(j);
+    }
+
+    /// Write all `dim()` correlations with the target to `out`, e.g. for ranking.
+    void correlations(T* out) const noexcept {
+        const bool defined = n_ >= 2 && target_varies();
+        for (std::size_t j = 0; j < dim(); ++j) {
+            out[j] = defined ? correlation_of(j) : std::numeric_limits<T>::quiet_NaN();
+        }
+    }
+
+    // --- Readiness / policy --------------------------------------------------
+
+    [[nodiscard]] bool ready() const noexcept { return n_ >= 2; }
+
+    // --- Reset ---------------------------------------------------------------
+
+    void reset() noexcept {
+        n_ = 0;
+        mean_y_ = T{0};
+        m2_y_ = T{0};
+        std::fill(s_.mean.begin(), s_.mean.end(), T{0});
+        std::fill(s_.m2.begin(), s_.m2.end(), T{0});
+        std::fill(s_.c.begin(), s_.c.end(), T{0});
+    }
+
+    // --- Merge ---------------------------------------------------------------
+
+    /// Chan et al. pairwise merge, candidate-wise the same as
+    /// `OnlineCovariance::merge`; both sides must have the same `dim()`.
+    void merge(const OneVsManyCovariance& other) noexcept {
+        assert(other.dim() == dim());
+        if (other.n_ == 0) return;
+        if (n_ == 0) {
+            *this = other;
+            return;
+        }
+        const T n_a = static_cast<T>(n_);
+        const T n_b = static_cast<T>(other.n_);
+        const T n = n_a + n_b;
+        const T w = n_a * n_b / n;
+        const T f = n_b / n;
+
+        const T dy = other.mean_y_ - mean_y_;
+        mean_y_ += dy * f;
+        m2_y_ += other.m2_y_ + dy * dy * w;
+        const T wdy = w * dy;
+
+        T* mean = s_.mean.data();
+        T* m2 = s_.m2.data();
+        T* c = s_.c.data();
+        const T* omean = other.s_.mean.data();
+        const T* om2 = other.s_.m2.data();
+        const T* oc = other.s_.c.data();
+        for (std::size_t j = 0; j < dim(); ++j) {
+            const T dx = omean[j] - mean[j];
+            mean[j] += dx * f;
+            m2[j] += om2[j] + dx * dx * w;
+            c[j] += oc[j] + dx * wdy;
+        }
+        n_ += other.n_;
+    }
+
+private:
+    [[nodiscard]] T moment(T m, std::size_t min_n) const noexcept {
+        if (n_ < min_n) return std::numeric_limits<T>::quiet_NaN();
+        return m / static_cast<T>(n_ - (min_n - 1));
+    }
+
+    [[nodiscard]] bool target_varies() const noexcept {
+        return !std::isnan(m2_y_) && m2_y_ / static_cast<T>(n_) > eps_ * eps_;
+    }
+
+    [[nodiscard]] T correlation_of(std::size_t j) const noexcept {
+        const T m2x = s_.m2[j];
+        if (std::isnan(m2x) || m2x / static_cast<T>(n_) <= eps_ * eps_) return std::numeric_limits<T>::quiet_NaN();
+        return s_.c[j] / std::sqrt(m2x * m2_y_);
+    }
+
+    void observe_block(const T* ys, const T* rows, std::size_t k, std::size_t ld) noexcept {
+        // Target first: per sample, the candidates' Welford step needs only
+        // 1/n and y - mean_y (after the update), C += (x - mean_x_old) * that.
+        T inv[block_rows];
+        T ydev[block_rows];
+        for (std::size_t r = 0; r < k; ++r) {
+            ++n_;
+            inv[r] = T{1} / static_cast<T>(n_);
+            const T dy = ys[r] - mean_y_;
+            mean_y_ += dy * inv[r];
+            ydev[r] = ys[r] - mean_y_;
+            m2_y_ += dy * ydev[r];
+        }
+
+        using B = detail::simd::batch<T>;
+        constexpr std::size_t W = B::width;
+        const std::size_t d = dim();
+        std::size_t j = 0;
+        for (; j + W * U <= d; j += W * U) candidate_strip<U>(rows + j, j, k, ld, inv, ydev);
+        for (; j + W <= d; j += W) candidate_strip<1>(rows + j, j, k, ld, inv, ydev);
+
+        for (; j < d; ++j) {
+            T mx = s_.mean[j], m2 = s_.m2[j], c = s_.c[j];
+            for (std::size_t r = 0; r < k; ++r) {
+                const T x = rows[r * ld + j];
+                const T dx = x - mx;
+                mx += dx * inv[r];
+                m2 += dx * (x - mx);
+                c += dx * ydev[r];
+            }
+            s_.mean[j] = mx;
+            s_.m2[j] = m2;
+            s_.c[j] = c;
+        }
+    }
+
+    // Candidates [j, j + V * width) over the `k` rows of a block, state in registers.
+    template <std::size_t V>
+    void candidate_strip(const T* col, std::size_t j, std::size_t k, std::size_t ld, const T* inv,
+                         const T* ydev) noexcept {
+        using B = detail::simd::batch<T>;
+        constexpr std::size_t W = B::width;
+        B mx[V], m2[V], c[V];
+        for (std::size_t v = 0; v < V; ++v) {
+            mx[v] = B::load(s_.mean.data() + j + v * W);
+            m2[v] = B::load(s_.m2.data() + j + v * W);
+            c[v] = B::load(s_.c.data() + j + v * W);
+        }
+        for (std::size_t r = 0; r < k; ++r) {
+            const T* x = col + r * ld;
+            const B vinv = B::broadcast(inv[r]);
+            const B vy = B::broadcast(ydev[r]);
+            for (std::size_t v = 0; v < V; ++v) {
+                const B xv = B::load(x + v * W);
+                const B dx = xv - mx[v];
+                mx[v] = fma(dx, vinv, mx[v]);
+                m2[v] = fma(dx, xv - mx[v], m2[v]);
+                c[v] = fma(dx, vy, c[v]);
+            }
+        }
+        for (std::size_t v = 0; v < V; ++v) {
+            mx[v].store(s_.mean.data() + j + v * W);
+            m2[v].store(s_.m2.data() + j + v * W);
+            c[v].store(s_.c.data() + j + v * W);
+        }
+    }
+
+    /// Register sets per candidate strip: 3 state vectors each.
+    static constexpr std::size_t U = detail::simd::registers >= 32 ? 4 : 2;
+
+    static constexpr T eps_ = Policy::template eps<T>;
+
+    count_type n_{0};
+    T mean_y_{0};
+    T m2_y_{0};
+    detail::one_vs_many_storage<T, D> s_{};
+};
+
+} // namespace fastnum
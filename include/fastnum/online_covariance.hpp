@@ -2,46 +2,123 @@
 
 #include <cstddef>
 #include <limits>
+#include <span>
 #include <type_traits>
+#include <utility>
 #include <cmath>
 #include <cassert>
+#include <fastnum/policy.hpp>
+#include <fastnum/detail/simd.hpp>
 
 namespace fastnum {
 
-template <typename T = double>
+// Policy supplies the count type and readiness epsilon; see policy.hpp.
+template <typename T = double, class Policy = default_policy>
 class OnlineCovariance {
     static_assert(std::is_floating_point_v<T>, "OnlineCovariance requires floating point T");
+    static_assert(detail::is_policy_v<Policy>, "OnlineCovariance requires a fastnum policy");
+    static_assert(!detail::compensated_of_v<Policy>, "OnlineCovariance does not implement compensated_policy");
 
 public:
+    using value_type = T;
+    using policy_type = Policy;
+    using count_type = typename Policy::count_type;
+    static constexpr nan_policy nans = detail::nan_policy_of_v<Policy>;
+
+    // Rebuild an accumulator from its raw moments, e.g. a partial state shipped
+    // from another process. `c` is the co-moment sum (x - mean_x)(y - mean_y).
+    [[nodiscard]] static constexpr OnlineCovariance from_moments(std::size_t n, T mean_x, T mean_y,
+                                                                 T m2_x, T m2_y, T c) noexcept {
+        OnlineCovariance cov;
+        if (n == 0) return cov;
+        cov.n_ = static_cast<count_type>(n);
+        cov.mean_x_ = mean_x;
+        cov.mean_y_ = mean_y;
+        cov.m2_x_ = m2_x;
+        cov.m2_y_ = m2_y;
+        cov.c_ = c;
+        return cov;
+    }
+
     // --- Observe -------------------------------------------------------------
 
     constexpr void observe(T x, T y) noexcept {
-        ++n_;
-
-        // Save deltas against the *old* means
-        const T dx = x - mean_x_;
-        const T dy = y - mean_y_;
+        if constexpr (hooks::enabled) {
+            hooks::on_observe(1);
+            if (const std::size_t nans = (x != x ? 1u : 0u) + (y != y ? 1u : 0u)) hooks::on_nan(nans);
+        }
+        put(x, y);
+    }
 
-        // Update means
-        const T inv_n = T{1} / static_cast<T>(n_);
-        mean_x_ += dx * inv_n;
-        mean_y_ += dy * inv_n;
+    // Batch observe: per-lane Welford accumulators in SIMD registers, folded
+    // in with merge(). See RunningStats::observe(const T*, std::size_t).
+    constexpr void observe(const T* xs, const T* ys, std::size_t n) noexcept {
+        if (!xs || !ys || n == 0) return;
+        note_observe(xs, 1, ys, 1, n);
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < n; ++i) put(xs[i], ys[i]);
+            return;
+        }
+        observe_batch(n, [xs, ys](std::size_t i, batch_type& x, batch_type& y) {
+            x = batch_type::load(xs + i);
+            y = batch_type::load(ys + i);
+        }, [xs, ys](std::size_t i) { return std::pair<T, T>{xs[i], ys[i]}; });
+    }
 
-        // Deltas against the *new* means
-        const T dx2 = x - mean_x_;
-        const T dy2 = y - mean_y_;
+    // Mixed-precision batch observe: narrower inputs (e.g. float columns into
+    // double state) are widened in registers; see RunningStats.
+    template <class U>
+        requires (std::is_floating_point_v<U> && sizeof(U) < sizeof(T))
+    constexpr void observe(const U* xs, const U* ys, std::size_t n) noexcept {
+        if (!xs || !ys || n == 0) return;
+        note_observe(xs, 1, ys, 1, n);
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < n; ++i) put(static_cast<T>(xs[i]), static_cast<T>(ys[i]));
+            return;
+        }
+        observe_batch(n, [xs, ys](std::size_t i, batch_type& x, batch_type& y) {
+            x = detail::simd::load_widened<T>(xs + i);
+            y = detail::simd::load_widened<T>(ys + i);
+        }, [xs, ys](std::size_t i) { return std::pair<T, T>{static_cast<T>(xs[i]), static_cast<T>(ys[i])}; });
+    }
 
-        // Update second central moments (Welford)
-        m2_x_ += dx * dx2;
-        m2_y_ += dy * dy2;
+    // Batch observe of (xs[i * x_stride], ys[i * y_stride]) for i < n, e.g. two
+    // columns of a row-major matrix, without copying them out first. Strides
+    // are in elements; (2, 2) with `ys == xs + 1` takes the interleaved path.
+    constexpr void observe_strided(const T* xs, std::size_t x_stride,
+                                   const T* ys, std::size_t y_stride, std::size_t n) noexcept {
+        if (x_stride == 1 && y_stride == 1) { observe(xs, ys, n); return; }
+        if (x_stride == 2 && y_stride == 2 && ys == xs + 1) { observe_interleaved(xs, n); return; }
+        if (!xs || !ys || n == 0) return;
+        note_observe(xs, x_stride, ys, y_stride, n);
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < n; ++i) put(xs[i * x_stride], ys[i * y_stride]);
+            return;
+        }
+        observe_batch(n, [=](std::size_t i, batch_type& x, batch_type& y) {
+            x = detail::simd::load_strided(xs + i * x_stride, x_stride);
+            y = detail::simd::load_strided(ys + i * y_stride, y_stride);
+        }, [=](std::size_t i) { return std::pair<T, T>{xs[i * x_stride], ys[i * y_stride]}; });
+    }
 
-        // Cross moment (covariance numerator)
-        c_ += dx * dy2;
+    // Batch observe of `n` interleaved pairs `x0, y0, x1, y1, ...`; the pairs
+    // are split into x / y registers by shuffles, not through a buffer.
+    constexpr void observe_interleaved(const T* xy, std::size_t n) noexcept {
+        if (!xy || n == 0) return;
+        note_observe(xy, 2, xy + 1, 2, n);
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < n; ++i) put(xy[2 * i], xy[2 * i + 1]);
+            return;
+        }
+        observe_batch(n, [xy](std::size_t i, batch_type& x, batch_type& y) { batch_type::load2(xy + 2 * i, x, y); },
+                      [xy](std::size_t i) { return std::pair<T, T>{xy[2 * i], xy[2 * i + 1]}; });
     }
 
-    constexpr void observe(const T* xs, const T* ys, std::size_t n) noexcept {
-        if (!xs || !ys || n == 0) return;
-        for (std::size_t i = 0; i < n; ++i) observe(xs[i], ys[i]);
+    // Interleaved pairs from a container of 2 * pairs elements.
+    template <class C>
+    constexpr auto observe_interleaved(const C& xy) noexcept -> decltype(xy.data(), xy.size(), void()) {
+        assert(static_cast<std::size_t>(xy.size()) % 2 == 0);
+        observe_interleaved(xy.data(), static_cast<std::size_t>(xy.size()) / 2);
     }
 
     template <class CX, class CY>
@@ -51,12 +128,53 @@ public:
         observe(xs.data(), ys.data(), static_cast<std::size_t>(xs.size()));
     }
 
+    // Frequency-weighted observe: same result as `w` calls to observe(x, y) in
+    // O(1). `w` is a count: a fractional part is truncated and `w < 1` is a
+    // no-op, here and in the batch form alike.
+    constexpr void observe(T x, T y, T w) noexcept {
+        if constexpr (hooks::enabled) {
+            hooks::on_observe(1);
+            if (const std::size_t nans = (x != x ? 1u : 0u) + (y != y ? 1u : 0u)) hooks::on_nan(nans);
+        }
+        put(x, y, w);
+    }
+
+    // Batch of (x, y, count) triples; per-lane weight sums, folded with merge().
+    constexpr void observe(const T* xs, const T* ys, const T* ws, std::size_t n) noexcept {
+        if (!xs || !ys || !ws || n == 0) return;
+        note_observe(xs, 1, ys, 1, n);
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < n; ++i) put(xs[i], ys[i], ws[i]);
+            return;
+        }
+        const std::size_t done = weighted_lanes<skips>(n, [xs, ys, ws](std::size_t i, batch_type& x,
+                                                                        batch_type& y, batch_type& w) {
+            x = batch_type::load(xs + i);
+            y = batch_type::load(ys + i);
+            w = batch_type::load(ws + i);
+        });
+        for (std::size_t i = done; i < n; ++i) put(xs[i], ys[i], ws[i]);
+    }
+
+    // Inject an already-reduced chunk given by its raw moments (see from_moments).
+    constexpr void observe_summary(std::size_t count, T mean_x, T mean_y, T m2_x, T m2_y, T c) noexcept {
+        merge(from_moments(count, mean_x, mean_y, m2_x, m2_y, c));
+    }
+
     // --- Basic accessors -----------------------------------------------------
 
     [[nodiscard]] constexpr std::size_t count() const noexcept { return n_; }
     [[nodiscard]] constexpr T mean_x() const noexcept { return mean_x_; }
     [[nodiscard]] constexpr T mean_y() const noexcept { return mean_y_; }
 
+    // Raw second moments: sums of squared / cross deviations from the means.
+    [[nodiscard]] constexpr T m2_x() const noexcept { return m2_x_; }
+    [[nodiscard]] constexpr T m2_y() const noexcept { return m2_y_; }
+    [[nodiscard]] constexpr T comoment() const noexcept { return c_; }
+    // Pairs dropped because x or y was not finite; always 0 unless the policy
+    // uses nan_policy::count_and_skip.
+    [[nodiscard]] constexpr std::size_t skipped() const noexcept { return skipped_.value(); }
+
     // --- Variances / Covariance ---------------------------------------------
 
     [[nodiscard]] constexpr T variance_x_population() const noexcept {
@@ -109,6 +227,7 @@ public:
         m2_x_ = T{0};
         m2_y_ = T{0};
         c_ = T{0};
+        skipped_ = {};
     }
 
         // --- Correlation ---------------------------------------------------------
@@ -129,10 +248,135 @@ public:
     }
 
 
-    constexpr void merge(const OnlineCovariance& other) noexcept{
+    constexpr void merge(const OnlineCovariance& other) noexcept {
+        if constexpr (hooks::enabled) hooks::on_merge(1);
+        combine(other);
+    }
+
+    // Fold many partial states in L1-sized blocks, two passes per block
+    // (global count and means, then the second moments about them); see
+    // RunningStats::merge_many.
+    constexpr void merge_many(const OnlineCovariance* parts, std::size_t count) noexcept {
+        if (!parts) return;
+        if constexpr (hooks::enabled) hooks::on_merge(count);
+        constexpr std::size_t block = 32768 / sizeof(OnlineCovariance);
+        for (std::size_t base = 0; base < count; base += block) {
+            combine(reduce_block(parts + base, count - base < block ? count - base : block));
+        }
+    }
+
+    constexpr void merge_many(std::span<const OnlineCovariance> parts) noexcept {
+        merge_many(parts.data(), parts.size());
+    }
+
+private:
+    using hooks = detail::instrumentation_of_t<Policy>;
+
+    // One hook call per batch; NaNs are counted per value, in x and in y.
+    template <class U>
+    constexpr void note_observe(const U* xs, std::size_t x_stride,
+                                const U* ys, std::size_t y_stride, std::size_t n) noexcept {
+        if constexpr (hooks::enabled) {
+            hooks::on_observe(n);
+            const std::size_t nans = detail::count_nan(xs, n, x_stride) + detail::count_nan(ys, n, y_stride);
+            if (nans) hooks::on_nan(nans);
+        }
+    }
+
+    static constexpr bool skips = nans != nan_policy::propagate;
+
+    // Single updates under the NaN policy: a pair is dropped if x or y is not finite.
+    constexpr void put(T x, T y) noexcept {
+        if constexpr (skips) {
+            if (!((x - x) + (y - y) == T{0})) { skipped_.add(1); return; }
+        }
+        push(x, y);
+    }
+
+    constexpr void put(T x, T y, T w) noexcept {
+        if constexpr (skips) {
+            if (!((x - x) + (y - y) + (w - w) == T{0})) { skipped_.add(1); return; }
+        }
+        push(x, y, w);
+    }
+
+    // Batch update over `load(i, x, y)` (pairs [i, i + width)) and `at(i)`.
+    template <class Load, class At>
+    void observe_batch(std::size_t n, Load load, At at) noexcept {
+        std::size_t done = 0;
+        if constexpr (skips) {
+            // Unmasked while clean, masked from the first dirty chunk on;
+            // see RunningStats::observe_batch.
+            using B = batch_type;
+            constexpr std::size_t C = 8192;
+            for (; done + C <= n; done += C) {
+                OnlineCovariance chunk;
+                chunk.observe_lanes(C, [&load, off = done](std::size_t i, B& x, B& y) { load(off + i, x, y); });
+                const T probe = (chunk.m2_x_ + chunk.m2_y_) + chunk.c_;
+                if (!(probe - probe == T{0})) break;
+                combine(chunk);
+            }
+            done += weighted_lanes<true>(n - done, [&load, off = done](std::size_t i, B& x, B& y, B& w) {
+                load(off + i, x, y);
+                w = B::broadcast(T{1});
+            });
+        } else {
+            done = observe_lanes(n, load);
+        }
+        for (std::size_t i = done; i < n; ++i) {
+            const auto [x, y] = at(i);
+            put(x, y);
+        }
+    }
+
+    // Uninstrumented updates behind the public entry points.
+    constexpr void push(T x, T y) noexcept {
+        ++n_;
+
+        // Save deltas against the *old* means
+        const T dx = x - mean_x_;
+        const T dy = y - mean_y_;
+
+        // Update means
+        const T inv_n = T{1} / static_cast<T>(n_);
+        mean_x_ += dx * inv_n;
+        mean_y_ += dy * inv_n;
+
+        // Deltas against the *new* means
+        const T dx2 = x - mean_x_;
+        const T dy2 = y - mean_y_;
+
+        // Update second central moments (Welford)
+        m2_x_ += dx * dx2;
+        m2_y_ += dy * dy2;
+
+        // Cross moment (covariance numerator)
+        c_ += dx * dy2;
+    }
+
+    constexpr void push(T x, T y, T w) noexcept {
+        if (!(w >= T{1})) return;
+        const auto k = static_cast<count_type>(w);
+        n_ += k;
+        const T kw = static_cast<T>(k);
+        const T dx = x - mean_x_;
+        const T dy = y - mean_y_;
+        const T r = kw / static_cast<T>(n_);
+        mean_x_ += dx * r;
+        mean_y_ += dy * r;
+        const T dy2 = y - mean_y_;
+        m2_x_ += kw * dx * (x - mean_x_);
+        m2_y_ += kw * dy * dy2;
+        c_ += kw * dx * dy2;
+    }
+
+    constexpr void combine(const OnlineCovariance& other) noexcept {
+        skipped_.add(other.skipped_.value());
         if(other.n_ == 0) return;
         if(n_ == 0){
+            const auto skipped = skipped_;
             *this = other;
+            skipped_ = skipped;
             return;
         }
 
@@ -165,17 +409,233 @@ public:
         //Combine cross_deviation sum
         c_ = c_ + other.c_ + dx * dy * (n_a_t * n_b_t / n_t);
 
-        n_ = n;
+        n_ = static_cast<count_type>(n);
     }
 
-private:
-    std::size_t n_{0};
+    [[nodiscard]] static constexpr OnlineCovariance reduce_block(const OnlineCovariance* parts,
+                                                                 std::size_t count) noexcept {
+        const T px = parts[0].mean_x_;
+        const T py = parts[0].mean_y_;
+
+        std::size_t total = 0;
+        T sx[2] = {T{0}, T{0}};
+        T sy[2] = {T{0}, T{0}};
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            for (std::size_t k = 0; k < 2; ++k) {
+                const T nk = static_cast<T>(parts[i + k].n_);
+                total += parts[i + k].n_;
+                sx[k] += nk * (parts[i + k].mean_x_ - px);
+                sy[k] += nk * (parts[i + k].mean_y_ - py);
+            }
+        }
+        for (; i < count; ++i) {
+            const T nk = static_cast<T>(parts[i].n_);
+            total += parts[i].n_;
+            sx[0] += nk * (parts[i].mean_x_ - px);
+            sy[0] += nk * (parts[i].mean_y_ - py);
+        }
+        OnlineCovariance out;
+        if constexpr (nans == nan_policy::count_and_skip) {
+            for (std::size_t k = 0; k < count; ++k) out.skipped_.add(parts[k].skipped_.value());
+        }
+        if (total == 0) return out;
+        const T inv_total = T{1} / static_cast<T>(total);
+        const T mx = px + (sx[0] + sx[1]) * inv_total;
+        const T my = py + (sy[0] + sy[1]) * inv_total;
+
+        T ax[2] = {T{0}, T{0}};
+        T ay[2] = {T{0}, T{0}};
+        T ac[2] = {T{0}, T{0}};
+        for (i = 0; i + 2 <= count; i += 2) {
+            for (std::size_t k = 0; k < 2; ++k) {
+                const OnlineCovariance& p = parts[i + k];
+                const T nk = static_cast<T>(p.n_);
+                const T dx = p.mean_x_ - mx;
+                const T dy = p.mean_y_ - my;
+                ax[k] += p.m2_x_ + nk * dx * dx;
+                ay[k] += p.m2_y_ + nk * dy * dy;
+                ac[k] += p.c_ + nk * dx * dy;
+            }
+        }
+        for (; i < count; ++i) {
+            const OnlineCovariance& p = parts[i];
+            const T nk = static_cast<T>(p.n_);
+            const T dx = p.mean_x_ - mx;
+            const T dy = p.mean_y_ - my;
+            ax[0] += p.m2_x_ + nk * dx * dx;
+            ay[0] += p.m2_y_ + nk * dy * dy;
+            ac[0] += p.c_ + nk * dx * dy;
+        }
+
+        out.n_ = static_cast<count_type>(total);
+        out.mean_x_ = mx;
+        out.mean_y_ = my;
+        out.m2_x_ = ax[0] + ax[1];
+        out.m2_y_ = ay[0] + ay[1];
+        out.c_ = ac[0] + ac[1];
+        return out;
+    }
+
+    using batch_type = detail::simd::batch<T>;
+
+    // Lane kernel over `load(i, x, y)`, which fills the x / y registers with
+    // pairs [i, i + width). Returns how many leading pairs it consumed; the
+    // caller observes the rest.
+    template <class Load>
+    std::size_t observe_lanes(std::size_t n, Load load) noexcept {
+        using B = batch_type;
+        constexpr std::size_t W = B::width;
+        constexpr std::size_t U = 2;  // five accumulators per set; keep register pressure low
+        constexpr std::size_t L = W * U;
+
+        const std::size_t blocks = n / L;
+        if (blocks > 0) {
+            const B zero = B::broadcast(T{0});
+            B mx[U], my[U], m2x[U], m2y[U], c[U];
+            for (std::size_t u = 0; u < U; ++u) {
+                mx[u] = zero; my[u] = zero; m2x[u] = zero; m2y[u] = zero; c[u] = zero;
+            }
+
+            for (std::size_t k = 0; k < blocks; ++k) {
+                const B inv_n = B::broadcast(T{1} / static_cast<T>(k + 1));
+                const std::size_t off = k * L;
+                for (std::size_t u = 0; u < U; ++u) {
+                    B x, y;
+                    load(off + u * W, x, y);
+                    const B dx = x - mx[u];
+                    const B dy = y - my[u];
+                    mx[u] = fma(dx, inv_n, mx[u]);
+                    my[u] = fma(dy, inv_n, my[u]);
+                    const B dy2 = y - my[u];
+                    m2x[u] = fma(dx, x - mx[u], m2x[u]);
+                    m2y[u] = fma(dy, dy2, m2y[u]);
+                    c[u] = fma(dx, dy2, c[u]);
+                }
+            }
+
+            T lmx[L], lmy[L], lm2x[L], lm2y[L], lc[L];
+            for (std::size_t u = 0; u < U; ++u) {
+                mx[u].store(lmx + u * W);
+                my[u].store(lmy + u * W);
+                m2x[u].store(lm2x + u * W);
+                m2y[u].store(lm2y + u * W);
+                c[u].store(lc + u * W);
+            }
+            OnlineCovariance lanes[L];
+            for (std::size_t i = 0; i < L; ++i) {
+                lanes[i].n_ = static_cast<count_type>(blocks);
+                lanes[i].mean_x_ = lmx[i];
+                lanes[i].mean_y_ = lmy[i];
+                lanes[i].m2_x_ = lm2x[i];
+                lanes[i].m2_y_ = lm2y[i];
+                lanes[i].c_ = lc[i];
+            }
+
+            // Pairwise tree: every level merges equal-count partials.
+            for (std::size_t w = L / 2; w > 0; w /= 2) {
+                for (std::size_t i = 0; i < w; ++i) lanes[i].combine(lanes[i + w]);
+            }
+            combine(lanes[0]);
+        }
+        return blocks * L;
+    }
+
+    // Lane kernel for (x, y, weight) triples from `load(i, x, y, w)`; see
+    // RunningStats::weighted_lanes (weights are truncated to whole counts as
+    // in push()). With `Mask`, triples with a non-finite member get weight 0
+    // and mean-valued x / y, and are counted as skipped.
+    template <bool Mask, class Load>
+    std::size_t weighted_lanes(std::size_t n, Load load) noexcept {
+        using B = batch_type;
+        constexpr std::size_t W = B::width;
+        constexpr std::size_t U = 2;
+        constexpr std::size_t L = W * U;
+
+        const std::size_t blocks = n / L;
+        if (blocks > 0) {
+            const B zero = B::broadcast(T{0});
+            const B one = B::broadcast(T{1});
+            std::size_t rejected = 0;
+            B mx[U], my[U], m2x[U], m2y[U], c[U], wsum[U];
+            count_type ln[L] = {}; // exact lane counts; wsum only feeds w / W
+            for (std::size_t u = 0; u < U; ++u) {
+                mx[u] = zero; my[u] = zero; m2x[u] = zero; m2y[u] = zero; c[u] = zero; wsum[u] = zero;
+            }
+
+            for (std::size_t k = 0; k < blocks; ++k) {
+                const std::size_t off = k * L;
+                for (std::size_t u = 0; u < U; ++u) {
+                    B x, y, w;
+                    load(off + u * W, x, y, w);
+                    if constexpr (Mask) {
+                        const auto ok = ordered((x - x) + (y - y) + (w - w));
+                        rejected += W - B::popcount(ok);
+                        x = select(ok, x, mx[u]);
+                        y = select(ok, y, my[u]);
+                        w = select(ok, w, zero);
+                    }
+                    w = trunc(select(ordered(w), w, zero));
+                    w = select(w < one, zero, w);
+                    wsum[u] = wsum[u] + w;
+                    T wt[W];
+                    w.store(wt);
+                    for (std::size_t l = 0; l < W; ++l) ln[u * W + l] += static_cast<count_type>(wt[l]);
+                    B r = w / wsum[u];
+                    r = select(finite(r), r, zero); // 0 / 0 until the lane's first weight
+                    const B dx = x - mx[u];
+                    const B dy = y - my[u];
+                    mx[u] = fma(dx, r, mx[u]);
+                    my[u] = fma(dy, r, my[u]);
+                    const B wdx = w * dx;
+                    const B dy2 = y - my[u];
+                    m2x[u] = fma(wdx, x - mx[u], m2x[u]);
+                    m2y[u] = fma(w * dy, dy2, m2y[u]);
+                    c[u] = fma(wdx, dy2, c[u]);
+                }
+            }
+
+            T lmx[L], lmy[L], lm2x[L], lm2y[L], lc[L];
+            for (std::size_t u = 0; u < U; ++u) {
+                mx[u].store(lmx + u * W);
+                my[u].store(lmy + u * W);
+                m2x[u].store(lm2x + u * W);
+                m2y[u].store(lm2y + u * W);
+                c[u].store(lc + u * W);
+            }
+            OnlineCovariance lanes[L];
+            for (std::size_t i = 0; i < L; ++i) {
+                if (ln[i] == 0) continue;
+                lanes[i].n_ = ln[i];
+                lanes[i].mean_x_ = lmx[i];
+                lanes[i].mean_y_ = lmy[i];
+                lanes[i].m2_x_ = lm2x[i];
+                lanes[i].m2_y_ = lm2y[i];
+                lanes[i].c_ = lc[i];
+            }
+
+            for (std::size_t w = L / 2; w > 0; w /= 2) {
+                for (std::size_t i = 0; i < w; ++i) lanes[i].combine(lanes[i + w]);
+            }
+            combine(lanes[0]);
+            skipped_.add(rejected);
+        }
+        return blocks * L;
+    }
+
+    count_type n_{0};
     T mean_x_{0};
     T mean_y_{0};
     T m2_x_{0};
     T m2_y_{0};
     T c_{0};
-    T eps_{static_cast<T>(1e-12)};
+    [[no_unique_address]] detail::skip_counter<count_type, nans == nan_policy::count_and_skip> skipped_{};
+
+    static constexpr T eps_ = Policy::template eps<T>;
 };
 
+static_assert(sizeof(OnlineCovariance<double>) == accumulator_size<double, default_policy, 5>);
+static_assert(sizeof(OnlineCovariance<float>) == accumulator_size<float, default_policy, 5>);
+static_assert(sizeof(OnlineCovariance<float, compact_policy>) == accumulator_size<float, compact_policy, 5>);
+
 } // namespace fastnum
@@ -0,0 +1,377 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <fastnum/detail/simd.hpp>
+#include <fastnum/policy.hpp>
+
+namespace fastnum {
+
+namespace detail {
+
+template <typename T, std::size_t D>
+struct cov_matrix_storage {
+    static constexpr std::size_t packed = D * (D + 1) / 2;
+
+    std::array<T, D> mean{};
+    std::array<T, packed> c{};
+
+    [[nodiscard]] constexpr std::size_t dim() const noexcept { return D; }
+};
+
+template <typename T>
+struct cov_matrix_storage<T, std::dynamic_extent> {
+    std::size_t d{0};
+    std::vector<T> mean;
+    std::vector<T> c;
+
+    cov_matrix_storage() = default;
+    explicit cov_matrix_storage(std::size_t dim)
+        : d(dim), mean(dim, T{0}), c(dim * (dim + 1) / 2, T{0}) {}
+
+    [[nodiscard]] std::size_t dim() const noexcept { return d; }
+};
+
+/**
+ * Register-blocked rank-RR update of IR consecutive rows of a packed upper
+ * triangle: `p[ii][j] += sum_rr x[rr][i + ii] * x[rr][j]` for `j >= i + ii`.
+ * `p[ii]` and `x[rr]` are indexed by absolute column.
+ */
+template <std::size_t IR, std::size_t RR, typename T>
+void packed_rank_update(T* const* p, const T* const* x, std::size_t i, std::size_t d) noexcept {
+    using B = simd::batch<T>;
+    constexpr std::size_t W = B::width;
+
+    T a[IR][RR];
+    B va[IR][RR];
+    for (std::size_t ii = 0; ii < IR; ++ii) {
+        for (std::size_t rr = 0; rr < RR; ++rr) {
+            a[ii][rr] = x[rr][i + ii];
+            va[ii][rr] = B::broadcast(a[ii][rr]);
+        }
+    }
+
+    // Leading triangle: columns [i, i + IR - 1) exist only in the upper rows.
+    for (std::size_t ii = 0; ii < IR; ++ii) {
+        for (std::size_t j = i + ii; j < i + IR - 1; ++j) {
+            T acc = p[ii][j];
+            for (std::size_t rr = 0; rr < RR; ++rr) acc += a[ii][rr] * x[rr][j];
+            p[ii][j] = acc;
+        }
+    }
+
+    std::size_t j = i + IR - 1;
+    for (; j + W <= d; j += W) {
+        B xv[RR];
+        for (std::size_t rr = 0; rr < RR; ++rr) xv[rr] = B::load(x[rr] + j);
+        for (std::size_t ii = 0; ii < IR; ++ii) {
+            B y = B::load(p[ii] + j);
+            for (std::size_t rr = 0; rr < RR; ++rr) y = fma(va[ii][rr], xv[rr], y);
+            y.store(p[ii] + j);
+        }
+    }
+    for (; j < d; ++j) {
+        for (std::size_t ii = 0; ii < IR; ++ii) {
+            T acc = p[ii][j];
+            for (std::size_t rr = 0; rr < RR; ++rr) acc += a[ii][rr] * x[rr][j];
+            p[ii][j] = acc;
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Online mean vector and covariance / correlation matrix of D features.
+ *
+ * Replaces D*(D-1)/2 `OnlineCovariance` objects with one accumulator that
+ * stores the D means plus the packed upper triangle (diagonal included) of the
+ * co-moment matrix \f$C = \sum (x - \mu)(x - \mu)^T\f$. The diagonal holds the
+ * per-feature M2, so variances come for free.
+ *
+ * ## Batch ingestion
+ * `observe(rows, n)` takes a row-major `n x D` block and processes it in blocks
+ * of `block_rows` samples. Each block is a rank-k update: the block mean is
+ * computed first, the centered outer products are accumulated straight into
+ * the packed triangle (a register-blocked SIMD micro-kernel updating 4 rows of
+ * C with 2-4 samples per pass, tiled so a band of C stays cache-resident while
+ * the block is streamed), and the block is folded
+ * in with the same Chan formula as `OnlineCovariance::merge`. Within a block
+ * this is an exact two-pass computation.
+ *
+ * ## Dimension
+ * - `OnlineCovarianceMatrix<T, D>`: compile-time D, inline storage, no allocation.
+ * - `OnlineCovarianceMatrix<T>`: runtime D given to the constructor; storage is
+ *   allocated once there and never again.
+ *
+ * ## Readiness / NaN policy
+ * Same as `OnlineCovariance`: variances/covariances need 1 (population) or 2
+ * (sample) observations, otherwise `NaN`. `correlation(i, j)` is `NaN` when
+ * either variance is not above `eps^2`.
+ *
+ * @tparam T Floating-point type.
+ * @tparam D Number of features, or `std::dynamic_extent` for runtime D.
+ */
+template <typename T = double, std::size_t D = std::dynamic_extent>
+class OnlineCovarianceMatrix {
+    static_assert(std::is_floating_point_v<T>, "OnlineCovarianceMatrix requires floating point T");
+
+public:
+    /// Samples per rank-k update in the batch path.
+    static constexpr std::size_t block_rows = 64;
+
+    constexpr OnlineCovarianceMatrix() noexcept requires (D != std::dynamic_extent) = default;
+
+    explicit OnlineCovarianceMatrix(std::size_t dim) requires (D == std::dynamic_extent)
+        : s_(dim), scratch_((RR + 1) * dim, T{0}) {}
+
+    // --- Observe -------------------------------------------------------------
+
+    /// Observe one sample of `dim()` features.
+    void observe(const T* row) noexcept {
+        if (!row) return;
+        observe_block(row, 1, dim());
+    }
+
+    /**
+     * @brief Observe `n_rows` samples from a row-major matrix.
+     *
+     * @param rows   Pointer to the first feature of the first sample.
+     * @param n_rows Number of samples.
+     * @param ld     Distance (in elements) between consecutive samples;
+     *               `0` means densely packed (`ld == dim()`).
+     */
+    void observe(const T* rows, std::size_t n_rows, std::size_t ld = 0) noexcept {
+        if (!rows || n_rows == 0) return;
+        if (ld == 0) ld = dim();
+        assert(ld >= dim());
+        for (std::size_t r = 0; r < n_rows; r += block_rows) {
+            observe_block(rows + r * ld, std::min(block_rows, n_rows - r), ld);
+        }
+    }
+
+    /// Container overload: `c.size()` must be a multiple of `dim()`.
+    template <class Container>
+    auto observe(const Container& c) noexcept
+        -> decltype(c.data(), c.size(), void()) {
+        assert(static_cast<std::size_t>(c.size()) % dim() == 0);
+        observe(c.data(), static_cast<std::size_t>(c.size()) / dim());
+    }
+
+    // --- Basic accessors -----------------------------------------------------
+
+    [[nodiscard]] std::size_t count() const noexcept { return n_; }
+    [[nodiscard]] std::size_t dim() const noexcept { return s_.dim(); }
+    [[nodiscard]] T mean(std::size_t i) const noexcept { return s_.mean[i]; }
+    [[nodiscard]] const T* means() const noexcept { return s_.mean.data(); }
+
+    // --- Variances / Covariance ---------------------------------------------
+
+    [[nodiscard]] T covariance_population(std::size_t i, std::size_t j) const noexcept {
+        if (n_ < 1) return std::numeric_limits<T>::quiet_NaN();
+        return comoment(i, j) / static_cast<T>(n_);
+    }
+
+    [[nodiscard]] T covariance_sample(std::size_t i, std::size_t j) const noexcept {
+        if (n_ < 2) return std::numeric_limits<T>::quiet_NaN();
+        return comoment(i, j) / static_cast<T>(n_ - 1);
+    }
+
+    [[nodiscard]] T variance_population(std::size_t i) const noexcept { return covariance_population(i, i); }
+    [[nodiscard]] T variance_sample(std::size_t i) const noexcept { return covariance_sample(i, i); }
+
+    [[nodiscard]] T correlation(std::size_t i, std::size_t j) const noexcept {
+        if (n_ < 2) return std::numeric_limits<T>::quiet_NaN();
+        const T vi = comoment(i, i);
+        const T vj = comoment(j, j);
+        const T nt = static_cast<T>(n_);
+        if (std::isnan(vi) || std::isnan(vj)) return std::numeric_limits<T>::quiet_NaN();
+        if (vi / nt <= eps_ * eps_ || vj / nt <= eps_ * eps_) return std::numeric_limits<T>::quiet_NaN();
+        return comoment(i, j) / std::sqrt(vi * vj);
+    }
+
+    /// Write the full `dim() x dim()` population covariance matrix (row-major).
+    void covariance_matrix_population(T* out) const noexcept { fill_matrix(out, n_ < 1, static_cast<T>(n_)); }
+
+    /// Write the full `dim() x dim()` sample covariance matrix (row-major).
+    void covariance_matrix_sample(T* out) const noexcept {
+        fill_matrix(out, n_ < 2, static_cast<T>(n_ < 2 ? 0 : n_ - 1));
+    }
+
+    /// Write the full `dim() x dim()` correlation matrix (row-major).
+    void correlation_matrix(T* out) const noexcept {
+        const std::size_t d = dim();
+        for (std::size_t i = 0; i < d; ++i) {
+            for (std::size_t j = i; j < d; ++j) {
+                out[i * d + j] = out[j * d + i] = correlation(i, j);
+            }
+        }
+    }
+
+    // --- Readiness / policy --------------------------------------------------
+
+    [[nodiscard]] bool ready() const noexcept { return n_ >= 2; }
+
+    // --- Reset ---------------------------------------------------------------
+
+    void reset() noexcept {
+        n_ = 0;
+        std::fill(s_.mean.begin(), s_.mean.end(), T{0});
+        std::fill(s_.c.begin(), s_.c.end(), T{0});
+    }
+
+    // --- Merge ---------------------------------------------------------------
+
+    /// Chan et al. pairwise merge; both sides must have the same `dim()`.
+    void merge(const OnlineCovarianceMatrix& other) noexcept {
+        assert(other.dim() == dim());
+        if (other.n_ == 0) return;
+        if (n_ == 0) {
+            *this = other;
+            return;
+        }
+        merge_moments(other.n_, other.s_.mean.data(), other.s_.c.data());
+    }
+
+private:
+    [[nodiscard]] T comoment(std::size_t i, std::size_t j) const noexcept {
+        if (i > j) std::swap(i, j);
+        return s_.c[packed_index(i, j)];
+    }
+
+    [[nodiscard]] std::size_t packed_index(std::size_t i, std::size_t j) const noexcept {
+        // Row i of the packed upper triangle starts after rows 0..i-1,
+        // which hold d + (d-1) + ... + (d-i+1) elements.
+        return i * dim() - i * (i - 1) / 2 + (j - i);
+    }
+
+    void fill_matrix(T* out, bool undefined, T denom) const noexcept {
+        const std::size_t d = dim();
+        for (std::size_t i = 0; i < d; ++i) {
+            for (std::size_t j = i; j < d; ++j) {
+                const T v = undefined ? std::numeric_limits<T>::quiet_NaN() : comoment(i, j) / denom;
+                out[i * d + j] = out[j * d + i] = v;
+            }
+        }
+    }
+
+    // Fold another state (count, means, packed co-moments) into this one.
+    // `other_c == nullptr` means a zero co-moment matrix (single sample).
+    void merge_moments(std::size_t n_b, const T* mean_b, const T* other_c) noexcept {
+        const std::size_t d = dim();
+        const T n_a_t = static_cast<T>(n_);
+        const T n_b_t = static_cast<T>(n_b);
+        const T n_t = n_a_t + n_b_t;
+        const T w = n_a_t * n_b_t / n_t;
+        const T f = n_b_t / n_t;
+
+        T* c = s_.c.data();
+        T* mean = s_.mean.data();
+        for (std::size_t i = 0; i < d; ++i) {
+            const T di = mean_b[i] - mean[i];
+            T* crow = c + packed_index(i, i);
+            const T* orow = other_c ? other_c + packed_index(i, i) : nullptr;
+            const T a = di * w;
+            for (std::size_t j = i; j < d; ++j) {
+                const T dj = mean_b[j] - mean[j];
+                crow[j - i] += (orow ? orow[j - i] : T{0}) + a * dj;
+            }
+        }
+        for (std::size_t i = 0; i < d; ++i) mean[i] += (mean_b[i] - mean[i]) * f;
+        n_ += n_b;
+    }
+
+    void observe_block(const T* rows, std::size_t k, std::size_t ld) noexcept {
+        const std::size_t d = dim();
+
+        if (k == 1) {
+            if (n_ == 0) {
+                std::copy(rows, rows + d, s_.mean.begin());
+                n_ = 1;
+                return;
+            }
+            merge_moments(1, rows, nullptr);
+            return;
+        }
+
+        // Block mean.
+        T* bmean = scratch_.data();
+        std::fill(bmean, bmean + d, T{0});
+        for (std::size_t r = 0; r < k; ++r) {
+            const T* x = rows + r * ld;
+            for (std::size_t j = 0; j < d; ++j) bmean[j] += x[j];
+        }
+        const T inv_k = T{1} / static_cast<T>(k);
+        for (std::size_t j = 0; j < d; ++j) bmean[j] *= inv_k;
+
+        // Merge correction for the block mean first (needs the pre-block
+        // state), then add the block's own centered co-moments.
+        if (n_ == 0) {
+            std::copy(bmean, bmean + d, s_.mean.begin());
+            n_ = k;
+        } else {
+            merge_moments(k, bmean, nullptr);
+        }
+
+        // Rank-k update, tiled over bands of packed rows of C so the band
+        // stays in L1 while the block streams past; RR centered samples are
+        // applied per load/store of C.
+        constexpr std::size_t tile_elems = 4096;
+        const std::size_t band = std::max<std::size_t>(4, tile_elems / d);
+        T* xc = bmean + d;
+        for (std::size_t i0 = 0; i0 < d; i0 += band) {
+            const std::size_t i1 = std::min(d, i0 + band);
+            std::size_t r = 0;
+            for (; r + RR <= k; r += RR) rank_update_band<RR>(rows + r * ld, ld, bmean, xc, i0, i1);
+            for (; r < k; ++r) rank_update_band<1>(rows + r * ld, ld, bmean, xc, i0, i1);
+        }
+    }
+
+    // Center `R` samples over columns [i0, d) into `xc`, then add their outer
+    // products to packed rows [i0, i1).
+    template <std::size_t R>
+    void rank_update_band(const T* rows, std::size_t ld, const T* bmean, T* xc,
+                          std::size_t i0, std::size_t i1) noexcept {
+        const std::size_t d = dim();
+        const T* x[R];
+        for (std::size_t rr = 0; rr < R; ++rr) {
+            T* dst = xc + rr * d;
+            const T* src = rows + rr * ld;
+            for (std::size_t j = i0; j < d; ++j) dst[j] = src[j] - bmean[j];
+            x[rr] = dst;
+        }
+
+        // Row i of the packed triangle, indexed by absolute column.
+        T* c = s_.c.data();
+        const auto row = [&](std::size_t i) { return c + packed_index(i, i) - i; };
+
+        std::size_t i = i0;
+        for (; i + 4 <= i1; i += 4) {
+            T* const p[4] = {row(i), row(i + 1), row(i + 2), row(i + 3)};
+            detail::packed_rank_update<4, R>(p, x, i, d);
+        }
+        for (; i < i1; ++i) {
+            T* const p[1] = {row(i)};
+            detail::packed_rank_update<1, R>(p, x, i, d);
+        }
+    }
+
+    /// Samples per register block: 4 with 32 vector registers, else 2.
+    static constexpr std::size_t RR = detail::simd::registers >= 32 ? 4 : 2;
+
+    static constexpr T eps_ = default_policy::eps<T>;
+
+    std::size_t n_{0};
+    detail::cov_matrix_storage<T, D> s_{};
+    // Batch-path scratch (sized once, reused): block mean, then RR centered samples.
+    std::conditional_t<D == std::dynamic_extent, std::vector<T>, std::array<T, (RR + 1) * D>> scratch_{};
+};
+
+} // namespace fastnum
@@ -1,12 +1,120 @@
 #pragma once
+#include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <span>
 #include <type_traits>
+#include <utility>
 #include <cmath>
+#include <cassert>
+#include <fastnum/policy.hpp>
 #include <fastnum/running_stats.hpp>
+#include <fastnum/detail/parallel.hpp>
+#include <fastnum/detail/simd.hpp>
 
 namespace fastnum {
 
+namespace detail {
+
+/// out[i] = (in[i] - mu) * inv_std. `in == out` is allowed.
+template <typename U>
+void standardize(const U* in, U* out, std::size_t n, U mu, U inv_std) noexcept {
+    using B = simd::batch<U>;
+    constexpr std::size_t W = B::width;
+    const B vmu = B::broadcast(mu);
+    const B vs = B::broadcast(inv_std);
+
+    std::size_t i = 0;
+    for (; i + 4 * W <= n; i += 4 * W) {
+        const B a = B::load(in + i);
+        const B b = B::load(in + i + W);
+        const B c = B::load(in + i + 2 * W);
+        const B d = B::load(in + i + 3 * W);
+        ((a - vmu) * vs).store(out + i);
+        ((b - vmu) * vs).store(out + i + W);
+        ((c - vmu) * vs).store(out + i + 2 * W);
+        ((d - vmu) * vs).store(out + i + 3 * W);
+    }
+    for (; i + W <= n; i += W) ((B::load(in + i) - vmu) * vs).store(out + i);
+    for (; i < n; ++i) out[i] = (in[i] - mu) * inv_std;
+}
+
+template <typename U>
+void fill_nan(U* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) out[i] = std::numeric_limits<U>::quiet_NaN();
+}
+
+} // namespace detail
+
+/**
+ * @brief Immutable snapshot of a fitted `OnlineStandardScaler`.
+ *
+ * Holds only the precomputed mean and `1 / stddev`, so `transform(x)` is a
+ * subtract and a multiply with no readiness check, no `sqrt` and no division.
+ * The object is trivially copyable and two `T`s wide, which makes it cheap to
+ * pass by value and safe to share read-only across threads while the live
+ * scaler keeps observing.
+ *
+ * Results are bit-identical to `OnlineStandardScaler::transform` at the time
+ * of `freeze()`. A snapshot taken from a scaler that was not `ready()` stores
+ * `NaN`s, so every transform yields `NaN` (same policy, no branch).
+ *
+ * @tparam T Floating-point type of the snapshot.
+ */
+template <typename T = double>
+struct FrozenStandardScaler {
+    static_assert(std::is_floating_point_v<T>,
+                  "FrozenStandardScaler requires floating point T");
+
+    T mu{std::numeric_limits<T>::quiet_NaN()};
+    T inv_std{std::numeric_limits<T>::quiet_NaN()};
+
+    /// Whether the snapshot was taken from a ready scaler.
+    [[nodiscard]] constexpr bool ready() const noexcept {
+        return inv_std == inv_std; // false only for NaN
+    }
+
+    /// `(x - mu) * inv_std`
+    [[nodiscard]] constexpr T transform(T x) const noexcept {
+        return (x - mu) * inv_std;
+    }
+
+    /// `z / inv_std + mu`
+    [[nodiscard]] constexpr T inverse_transform(T z) const noexcept {
+        return z / inv_std + mu;
+    }
+
+    /**
+     * @brief Standardize `n` values from `in` into `out` (`in == out` allowed).
+     *
+     * Same SIMD kernel as `OnlineStandardScaler::transform(in, out, n)`.
+     */
+    template <typename U>
+    auto transform(const U* in, U* out, std::size_t n) const noexcept
+        -> std::enable_if_t<std::is_floating_point_v<U>> {
+        if (!in || !out || n == 0) return;
+        detail::standardize(in, out, n, static_cast<U>(mu), static_cast<U>(inv_std));
+    }
+
+    /**
+     * @brief Map `n` z-scores from `in` back to the original scale into `out`.
+     */
+    template <typename U>
+    auto inverse_transform(const U* in, U* out, std::size_t n) const noexcept
+        -> std::enable_if_t<std::is_floating_point_v<U>> {
+        if (!in || !out || n == 0) return;
+        const U m = static_cast<U>(mu);
+        const U s = static_cast<U>(inv_std);
+        for (std::size_t i = 0; i < n; ++i) out[i] = in[i] / s + m;
+    }
+};
+
+/// Which statistics `OnlineStandardScaler::observe_and_transform` standardizes with.
+enum class fused_mode {
+    prequential, ///< each sample with the statistics *before* it (test-then-train, no leakage)
+    post_batch   ///< every sample with the statistics after the whole batch
+};
+
 /**
  * @brief Online (streaming) standardization using running mean/variance.
  *
@@ -26,12 +134,13 @@ namespace fastnum {
  *
  * ## Requirements / Assumptions
  * - `T` must be a floating-point type (`float`, `double`, `long double`).
- * - The underlying `fastnum::RunningStats<T>` must provide:
- *   - `observe(T)`
+ * - The statistics backend `Stats` (default `fastnum::RunningStats<T>`; see
+ *   also `fastnum::ExponentialStats<T>` for drifting streams) must provide:
+ *   - `observe(T)` and batch `observe(const T*, std::size_t)`
  *   - `count() -> std::size_t`
  *   - `mean() -> T`
  *   - `variance_population() -> T`
- *   - `merge(const RunningStats&)`
+ *   - `merge(const Stats&)`
  *   - `reset()`
  *
  * ## Readiness / policy
@@ -39,11 +148,12 @@ namespace fastnum {
  * This class considers itself "ready" when:
  * - at least 2 samples have been observed,
  * - population variance is not NaN,
- * - population variance is larger than `eps_^2`.
+ * - population variance is larger than `eps_^2`, where `eps_` is the
+ *   compile-time epsilon of `Stats::policy_type` (see `fastnum::default_policy`).
  *
  * If not ready:
  * - `transform(x)` returns `NaN`
- * - `transform_inplace(...)` fills outputs with `NaN`
+ * - `transform(in, out, n)` / `transform_inplace(...)` fill outputs with `NaN`
  *
  * This explicit NaN policy makes downstream problems easy to detect
  * (instead of silently returning zeros).
@@ -56,17 +166,33 @@ namespace fastnum {
  * - `observe(x)`: O(1)
  * - `observe(batch)`: O(n)
  * - `transform(x)`: O(1)
- * - `transform_inplace(batch)`: O(n)
- * - `merge(other)`: depends on `RunningStats::merge` (typically O(1))
+ * - `transform(in, out, n)` / `transform_inplace(batch)`: O(n), SIMD
+ * - `merge(other)`: depends on `Stats::merge` (typically O(1))
  *
- * @tparam T Floating-point type for accumulation and output.
+ * @tparam T     Floating-point type for accumulation and output.
+ * @tparam Stats Running mean/variance backend.
  */
-template <typename T = double>
+template <typename T = double, class Stats = RunningStats<T>>
 class OnlineStandardScaler {
     static_assert(std::is_floating_point_v<T>,
                   "OnlineStandardScaler requires floating point T");
 
 public:
+    using value_type = T;
+    using stats_type = Stats;
+    /// As the backend: order-sensitive backends rule out chunked parallel fits.
+    static constexpr bool order_sensitive = detail::order_sensitive_v<Stats>;
+
+    constexpr OnlineStandardScaler() = default;
+
+    /**
+     * @brief Start from a pre-configured (or pre-fitted) statistics backend.
+     *
+     * E.g. `OnlineStandardScaler<double, ExponentialStats<double>>(
+     * ExponentialStats<double>::from_half_life(1000))`.
+     */
+    explicit constexpr OnlineStandardScaler(const Stats& stats) noexcept : stats_(stats) {}
+
     /**
      * @brief Observe a single sample and update running statistics.
      *
@@ -83,14 +209,27 @@ public:
      *
      * Safe no-op if `xs == nullptr` or `n == 0`.
      *
+     * Forwards to the batch kernel of `Stats::observe(const T*, n)`.
+     *
      * @param xs Pointer to first sample.
      * @param n  Number of samples.
      */
     constexpr void observe(const T* xs, std::size_t n) noexcept {
-        if (!xs || n == 0) return;
-        for (std::size_t i = 0; i < n; ++i) {
-            stats_.observe(xs[i]);
-        }
+        stats_.observe(xs, n);
+    }
+
+    /**
+     * @brief Observe narrower inputs (e.g. `float` data into a `double`
+     *        scaler) without an upcast copy.
+     *
+     * Available when `Stats` has the matching mixed-precision batch observe
+     * (e.g. `RunningStats`), which widens the values in registers.
+     */
+    template <class U, class S = Stats>
+        requires (!std::is_same_v<U, T>)
+    constexpr auto observe(const U* xs, std::size_t n) noexcept
+        -> decltype(std::declval<S&>().observe(xs, n), void()) {
+        stats_.observe(xs, n);
     }
 
     /**
@@ -110,6 +249,55 @@ public:
         observe(c.data(), static_cast<std::size_t>(c.size()));
     }
 
+    /**
+     * @brief Observe `xs[0], xs[stride], ..., xs[(n - 1) * stride]`.
+     *
+     * For columns of row-major data, without copying them out first.
+     * Available when `Stats` provides `observe_strided` (e.g. `RunningStats`).
+     *
+     * @param xs     Pointer to first sample.
+     * @param stride Distance between samples, in elements.
+     * @param n      Number of samples.
+     */
+    template <class S = Stats>
+    constexpr auto observe_strided(const T* xs, std::size_t stride, std::size_t n) noexcept
+        -> decltype(std::declval<S&>().observe_strided(xs, stride, n), void()) {
+        stats_.observe_strided(xs, stride, n);
+    }
+
+    /**
+     * @brief Observe `x` with frequency weight `w` (a count), in O(1).
+     *
+     * Same result as `w` calls to `observe(x)`. Available when `Stats`
+     * provides `observe(T, T)` (e.g. `RunningStats`).
+     */
+    template <class S = Stats>
+    constexpr auto observe(T x, T w) noexcept -> decltype(std::declval<S&>().observe(x, w), void()) {
+        stats_.observe(x, w);
+    }
+
+    /**
+     * @brief Observe `n` (value, count) pairs from `xs` / `ws`.
+     *
+     * Forwards to the batch kernel of `Stats::observe(const T*, const T*, n)`.
+     */
+    template <class S = Stats>
+    constexpr auto observe(const T* xs, const T* ws, std::size_t n) noexcept
+        -> decltype(std::declval<S&>().observe(xs, ws, n), void()) {
+        stats_.observe(xs, ws, n);
+    }
+
+    /**
+     * @brief Fold in an already-reduced chunk given by its count, mean and M2.
+     *
+     * Available when `Stats` provides `observe_summary` (e.g. `RunningStats`).
+     */
+    template <class S = Stats>
+    constexpr auto observe_summary(std::size_t count, T mean, T m2) noexcept
+        -> decltype(std::declval<S&>().observe_summary(count, mean, m2), void()) {
+        stats_.observe_summary(count, mean, m2);
+    }
+
     /**
      * @brief Whether the scaler is ready to produce meaningful standardized values.
      *
@@ -133,12 +321,22 @@ public:
         return stats_.count();
     }
 
+    /**
+     * @brief Non-finite inputs dropped by the backend's NaN policy.
+     *
+     * Non-zero only with `nan_policy::count_and_skip` (see `RunningStats`).
+     */
+    template <class S = Stats>
+    [[nodiscard]] constexpr auto skipped() const noexcept -> decltype(std::declval<const S&>().skipped()) {
+        return stats_.skipped();
+    }
+
     /**
      * @brief Current running mean estimate.
      *
      * This value is updated online as samples are observed.
      *
-     * @return Mean of observed samples (as tracked by RunningStats).
+     * @return Mean of observed samples (as tracked by `Stats`).
      */
     [[nodiscard]] constexpr T mean() const noexcept {
         return stats_.mean();
@@ -153,36 +351,107 @@ public:
      * @return Standardized value `(x - mean) / stddev`, or `NaN` if not ready.
      */
     [[nodiscard]] T transform(T x) const noexcept {
-        if (!ready()) return std::numeric_limits<T>::quiet_NaN();
+        if (!ready()) {
+            if constexpr (hooks::enabled) hooks::on_not_ready(1);
+            return std::numeric_limits<T>::quiet_NaN();
+        }
         T inv_std = T{1} / std::sqrt(stats_.variance_population());
         return (x - stats_.mean()) * inv_std;
     }
 
     /**
-     * @brief Standardize a batch of values in-place using pointer + length.
+     * @brief Standardize `n` values from `in` into `out` (out-of-place).
      *
-     * Safe no-op if `xs == nullptr` or `n == 0`.
+     * Computes `(in[i] - mean) * inv_std` with the SIMD kernel. `in` and `out`
+     * may be the same pointer (this is what `transform_inplace` does), but must
+     * not otherwise overlap.
      *
-     * If the scaler is not `ready()`, the batch is filled with `NaN`.
+     * `U` may differ from `T`: e.g. a `double` scaler can standardize `float`
+     * buffers directly. Mean and `1/stddev` are computed in `T`, then rounded
+     * to `U` once; the per-element arithmetic runs in `U`.
      *
-     * @param xs Pointer to first element (modified in-place).
-     * @param n  Number of elements.
+     * Safe no-op if either pointer is null or `n == 0`.
+     * If the scaler is not `ready()`, `out` is filled with `NaN`.
+     *
+     * @param in  Pointer to first input element.
+     * @param out Pointer to first output element.
+     * @param n   Number of elements.
      */
-    void transform_inplace(T* xs, std::size_t n) const noexcept {
-        if (!xs || n == 0) return;
+    template <typename U>
+    auto transform(const U* in, U* out, std::size_t n) const noexcept
+        -> std::enable_if_t<std::is_floating_point_v<U>> {
+        if (!in || !out || n == 0) return;
 
         if (!ready()) {
-            for (std::size_t i = 0; i < n; ++i) {
-                xs[i] = std::numeric_limits<T>::quiet_NaN();
-            }
+            if constexpr (hooks::enabled) hooks::on_not_ready(n);
+            detail::fill_nan(out, n);
             return;
         }
 
         const T mu = stats_.mean();
         const T inv_std = T{1} / std::sqrt(stats_.variance_population());
-        for (std::size_t i = 0; i < n; ++i) {
-            xs[i] = (xs[i] - mu) * inv_std;
+        detail::standardize(in, out, n, static_cast<U>(mu), static_cast<U>(inv_std));
+    }
+
+    /**
+     * @brief Out-of-place standardization split across up to `num_threads` threads.
+     *
+     * Intended for very large buffers: chunks are never smaller than
+     * `parallel_transform_min_chunk` elements, so smaller inputs run on the
+     * calling thread. `num_threads == 0` uses `std::thread::hardware_concurrency()`.
+     * Results are identical to the single-threaded overload.
+     *
+     * @param in          Pointer to first input element.
+     * @param out         Pointer to first output element.
+     * @param n           Number of elements.
+     * @param num_threads Maximum number of threads (including the caller).
+     */
+    template <typename U>
+    auto transform(const U* in, U* out, std::size_t n, std::size_t num_threads) const noexcept
+        -> std::enable_if_t<std::is_floating_point_v<U>> {
+        if (!in || !out || n == 0) return;
+
+        if (!ready()) {
+            if constexpr (hooks::enabled) hooks::on_not_ready(n);
+            detail::fill_nan(out, n);
+            return;
         }
+
+        const U mu = static_cast<U>(stats_.mean());
+        const U inv_std = static_cast<U>(T{1} / std::sqrt(stats_.variance_population()));
+        detail::parallel_chunks(n, num_threads, parallel_transform_min_chunk,
+            [=](std::size_t begin, std::size_t end, std::size_t) {
+                detail::standardize(in + begin, out + begin, end - begin, mu, inv_std);
+            });
+    }
+
+    /**
+     * @brief Out-of-place standardization between contiguous containers.
+     *
+     * `out` must hold at least `in.size()` elements.
+     *
+     * @tparam CIn  Any type supporting `in.data()` and `in.size()`.
+     * @tparam COut Any type supporting `out.data()` and `out.size()`.
+     */
+    template <class CIn, class COut>
+    auto transform(const CIn& in, COut& out) const noexcept
+        -> decltype(in.data(), in.size(), out.data(), out.size(), void()) {
+        assert(static_cast<std::size_t>(out.size()) >= static_cast<std::size_t>(in.size()));
+        transform(in.data(), out.data(), static_cast<std::size_t>(in.size()));
+    }
+
+    /**
+     * @brief Standardize a batch of values in-place using pointer + length.
+     *
+     * Safe no-op if `xs == nullptr` or `n == 0`.
+     *
+     * If the scaler is not `ready()`, the batch is filled with `NaN`.
+     *
+     * @param xs Pointer to first element (modified in-place).
+     * @param n  Number of elements.
+     */
+    void transform_inplace(T* xs, std::size_t n) const noexcept {
+        transform(xs, xs, n);
     }
 
     /**
@@ -201,6 +470,101 @@ public:
         transform_inplace(c.data(), static_cast<std::size_t>(c.size()));
     }
 
+    /**
+     * @brief Observe a batch and write its z-scores to `out` in one call.
+     *
+     * - `fused_mode::prequential` (default): `out[i]` uses the statistics of
+     *   everything observed *before* `in[i]`, exactly like
+     *   `out[i] = transform(in[i]); observe(in[i]);` but in one pass over
+     *   memory. The first samples (and any sample seen while the scaler is
+     *   not ready) yield `NaN`. With a moment backend (`RunningStats`) the
+     *   sweep runs in cache-sized blocks: prefix sums of `x - c` (`c` = mean
+     *   at block start) give every sample's prior count, mean and M2 in
+     *   closed form, so the z-scores are computed with the SIMD kernel.
+     *   Backends that skip non-finite inputs or are compensated first take
+     *   the batch through their own `observe(in, n)`, so their state is
+     *   exactly that of the unfused call; the z-scores then come from the
+     *   prior moments (the prefix sums leave skipped inputs out). Other
+     *   backends use the scalar loop.
+     * - `fused_mode::post_batch`: every `out[i]` uses the statistics after
+     *   the whole batch. Those are only known once all of `in` was read, so
+     *   this is `observe(in, n)` followed by `transform(in, out, n)`.
+     *
+     * `in == out` is allowed. Results match the unfused calls up to rounding.
+     * Hooks see one batch observe and one `on_not_ready` with the number of
+     * `NaN` outputs due to a not-ready state.
+     *
+     * @param in   Pointer to first input element.
+     * @param out  Pointer to first output element.
+     * @param n    Number of elements.
+     * @param mode Statistics used for the transform.
+     */
+    void observe_and_transform(const T* in, T* out, std::size_t n,
+                               fused_mode mode = fused_mode::prequential) noexcept {
+        if (!in || !out || n == 0) return;
+        if (mode == fused_mode::post_batch) {
+            observe(in, n);
+            transform(in, out, n);
+            return;
+        }
+        std::size_t not_ready = 0;
+        if constexpr (has_moments) {
+            std::size_t count = stats_.count();
+            T mean = stats_.mean();
+            T m2 = stats_.m2();
+            if constexpr (!skips && !compensated) {
+                detail::note_observe<hooks>(in, n);
+                not_ready = prequential_blocks<false>(in, out, n, count, mean, m2);
+                stats_ = Stats::from_moments(count, mean, m2);
+            } else {
+                // The backend applies its NaN policy (and drop counter) and
+                // keeps its compensation terms; the z-scores only need the
+                // prior moments.
+                stats_.observe(in, n);
+                not_ready = prequential_blocks<skips>(in, out, n, count, mean, m2);
+            }
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                const T x = in[i];
+                if (ready()) {
+                    out[i] = transform(x);
+                } else {
+                    out[i] = std::numeric_limits<T>::quiet_NaN();
+                    ++not_ready;
+                }
+                observe(x);
+            }
+        }
+        if constexpr (hooks::enabled) {
+            if (not_ready != 0) hooks::on_not_ready(not_ready);
+        }
+    }
+
+    /**
+     * @brief Fused observe and transform between contiguous containers.
+     *
+     * `out` must hold at least `in.size()` elements.
+     */
+    template <class CIn, class COut>
+    auto observe_and_transform(const CIn& in, COut& out, fused_mode mode = fused_mode::prequential) noexcept
+        -> decltype(in.data(), in.size(), out.data(), out.size(), void()) {
+        assert(static_cast<std::size_t>(out.size()) >= static_cast<std::size_t>(in.size()));
+        observe_and_transform(in.data(), out.data(), static_cast<std::size_t>(in.size()), mode);
+    }
+
+    /**
+     * @brief Take an immutable snapshot for the hot transform path.
+     *
+     * The snapshot does not track later `observe`/`merge` calls; call
+     * `freeze()` again to refresh it.
+     *
+     * @return Precomputed `(mean, 1/stddev)`, or NaNs if not `ready()`.
+     */
+    [[nodiscard]] FrozenStandardScaler<T> freeze() const noexcept {
+        if (!ready()) return {};
+        return {stats_.mean(), T{1} / std::sqrt(stats_.variance_population())};
+    }
+
     /**
      * @brief Merge another fitted scaler into this one.
      *
@@ -208,7 +572,7 @@ public:
      * - Fit one scaler per shard/thread/partition
      * - Merge them to obtain global running statistics
      *
-     * Correctness depends on `RunningStats::merge` combining counts, means,
+     * Correctness depends on `Stats::merge` combining counts, means,
      * and variances appropriately.
      *
      * @param other Another scaler to merge into this one.
@@ -217,13 +581,37 @@ public:
         stats_.merge(other.stats_);
     }
 
+    /**
+     * @brief Merge many fitted scalers at once.
+     *
+     * Uses `Stats::merge_many` when the backend has it (the two-pass
+     * reduction of `RunningStats`), fed through a small on-stack staging
+     * buffer, and a pairwise tree of `merge` calls otherwise.
+     *
+     * @param parts Scalers to fold into this one.
+     */
+    void merge_many(std::span<const OnlineStandardScaler> parts) noexcept {
+        constexpr std::size_t stage = 64;
+        Stats buf[stage];
+        for (std::size_t base = 0; base < parts.size(); base += stage) {
+            const std::size_t m = std::min(stage, parts.size() - base);
+            for (std::size_t i = 0; i < m; ++i) buf[i] = parts[base + i].stats_;
+            if constexpr (has_merge_many) {
+                stats_.merge_many(buf, m);
+            } else {
+                detail::tree_merge(buf, m);
+                stats_.merge(buf[0]);
+            }
+        }
+    }
+
     /**
      * @brief Reset state back to "unfitted".
      *
      * After reset:
      * - `count() == 0`
      * - `ready() == false`
-     * - `mean()` and variance are whatever `RunningStats::reset()` defines
+     * - `mean()` and variance are whatever `Stats::reset()` defines
      *
      * Note: `transform`/`transform_inplace` will return/fill NaNs until
      * enough new samples are observed.
@@ -232,17 +620,135 @@ public:
         stats_.reset();
     }
 
+    /// The underlying statistics backend.
+    [[nodiscard]] constexpr const Stats& stats() const noexcept { return stats_; }
+
+    /// Smallest chunk handed to a worker by the multi-threaded `transform`.
+    static constexpr std::size_t parallel_transform_min_chunk = std::size_t{1} << 16;
+
 private:
+    template <class S, class = void>
+    struct merge_many_probe : std::false_type {};
+    template <class S>
+    struct merge_many_probe<S, std::void_t<decltype(std::declval<S&>().merge_many(
+                                   std::declval<const S*>(), std::size_t{}))>> : std::true_type {};
+    static constexpr bool has_merge_many = merge_many_probe<Stats>::value;
+
+    // Instrumentation of the backend's policy; observe / merge events are
+    // reported by the backend itself.
+    using hooks = detail::instrumentation_of_t<detail::policy_of_t<Stats>>;
+
+    // Backends exposing (count, mean, M2) and from_moments, e.g. RunningStats.
+    template <class S, class = void>
+    struct moments_probe : std::false_type {};
+    template <class S>
+    struct moments_probe<S, std::void_t<decltype(std::declval<const S&>().m2()),
+                                        decltype(S::from_moments(std::size_t{}, T{}, T{}))>> : std::true_type {};
+    static constexpr bool has_moments = moments_probe<Stats>::value;
+    static constexpr bool skips = detail::nan_policy_of_v<detail::policy_of_t<Stats>> != nan_policy::propagate;
+    static constexpr bool compensated = detail::compensated_of_v<detail::policy_of_t<Stats>>;
+
+    // Prequential z-scores of in[0, n) from the prior moments (n0, mean, m2),
+    // which are advanced past the batch. With Skips, non-finite inputs leave
+    // the moments unchanged. Returns the number of not-ready outputs (only
+    // counted when hooks are enabled).
+    template <bool Skips>
+    std::size_t prequential_blocks(const T* in, T* out, std::size_t n,
+                                   std::size_t& n0, T& mean, T& m2) const noexcept {
+        using B = detail::simd::batch<T>;
+        constexpr std::size_t W = B::width;
+        constexpr std::size_t block = 256;
+
+        // Prior state of sample j in a block: count cnt[j], and prefix sums
+        // s1[j] = sum (x_k - c), s2[j] = sum (x_k - c)^2 over k < j.
+        T cnt[block], s1[block], s2[block];
+        std::size_t not_ready = 0;
+
+        const T eps2 = eps_ * eps_;
+        const T nan = std::numeric_limits<T>::quiet_NaN();
+        const B one = B::broadcast(T{1});
+        const B veps2 = B::broadcast(eps2);
+        const B vnan = B::broadcast(nan);
+
+        for (std::size_t base = 0; base < n; base += block) {
+            const std::size_t m = std::min(block, n - base);
+            const T* x = in + base;
+            // Shift by the current mean; from an empty state use the first
+            // (counted) sample, so M2 stays exactly 0 after one sample.
+            T c = n0 == 0 ? x[0] : mean;
+            if constexpr (Skips) {
+                if (n0 == 0) {
+                    c = T{0};
+                    for (std::size_t j = 0; j < m; ++j) {
+                        if (x[j] - x[j] == T{0}) { c = x[j]; break; }
+                    }
+                }
+            }
+
+            std::size_t k = n0;
+            T a1 = T{0}, a2 = T{0};
+            for (std::size_t j = 0; j < m; ++j) {
+                cnt[j] = static_cast<T>(k);
+                s1[j] = a1;
+                s2[j] = a2;
+                if constexpr (Skips) {
+                    if (!(x[j] - x[j] == T{0})) continue;
+                }
+                const T y = x[j] - c;
+                ++k;
+                a1 += y;
+                a2 += y * y;
+            }
+
+            // mean_j = c + s1 / n_j, M2_j = M2 + s2 - s1^2 / n_j; NaN / not
+            // ready (also n_j < 2) fails `eps^2 < var`.
+            const B vc = B::broadcast(c);
+            const B vm2 = B::broadcast(m2);
+            std::size_t j = 0;
+            for (; j + W <= m; j += W) {
+                const B inv_n = one / B::load(cnt + j);
+                const B p1 = B::load(s1 + j);
+                const B mu = fma(p1, inv_n, vc);
+                const B var = (vm2 + B::load(s2 + j) - p1 * p1 * inv_n) * inv_n;
+                const B z = (B::load(x + j) - mu) * (one / sqrt(var));
+                const auto ok = veps2 < var;
+                select(ok, z, vnan).store(out + base + j);
+                if constexpr (hooks::enabled) not_ready += W - B::popcount(ok);
+            }
+            for (; j < m; ++j) {
+                const T inv_n = T{1} / cnt[j];
+                const T mu = s1[j] * inv_n + c;
+                const T var = (m2 + s2[j] - s1[j] * s1[j] * inv_n) * inv_n;
+                const bool ok = eps2 < var;
+                out[base + j] = ok ? (x[j] - mu) * (T{1} / std::sqrt(var)) : nan;
+                if constexpr (hooks::enabled) not_ready += ok ? 0u : 1u;
+            }
+
+            n0 = k;
+            if (n0 == 0) continue;
+            const T inv_total = T{1} / static_cast<T>(n0);
+            mean = c + a1 * inv_total;
+            m2 = m2 + a2 - a1 * a1 * inv_total;
+        }
+        return not_ready;
+    }
+
     /// Running statistics accumulator (mean, variance, count).
-    fastnum::RunningStats<T> stats_{};
+    Stats stats_{};
 
     /**
      * @brief Variance floor control.
      *
      * `ready()` requires variance_population() > eps_^2.
      * This avoids division by ~0 in cases of constant/near-constant streams.
+     * Taken from the backend's policy, so it occupies no storage.
      */
-    T eps_{static_cast<T>(1e-12)};
+    static constexpr T eps_ = detail::policy_of_t<Stats>::template eps<T>;
 };
 
+// A scaler is exactly as large as its statistics backend.
+static_assert(sizeof(OnlineStandardScaler<double>) == sizeof(RunningStats<double>));
+static_assert(sizeof(OnlineStandardScaler<float, RunningStats<float, compact_policy>>) ==
+              sizeof(RunningStats<float, compact_policy>));
+
 } // namespace fastnum
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <fastnum/running_stats.hpp>
+#include <fastnum/online_covariance.hpp>
+#include <fastnum/detail/simd.hpp>
+
+namespace fastnum {
+
+/**
+ * @file
+ * @brief Packed state arrays and a bulk reduction operator for collectives.
+ *
+ * `packed_states<Acc>` stores N accumulators (one per feature, say) in
+ * fixed-size tiles of `packed_lanes` states each. Inside a tile every field
+ * is a contiguous array, so merging two buffers element by element runs on
+ * whole SIMD registers: one `packed_merge` replaces N calls to `merge()`.
+ *
+ * The tile is the reduction unit. Collective libraries split a buffer only
+ * at datatype boundaries, so with one tile as the datatype the same function
+ * works as an `MPI_Op` (`packed_reduce_op`) or as the user reduction of any
+ * other collective library (`packed_merge`), however the library chunks or
+ * pipelines the message:
+ *
+ * ```cpp
+ * using Stats = fastnum::RunningStats<double>;
+ * fastnum::packed_states<Stats> local(features);      // fill with set() / observe into objects
+ *
+ * MPI_Datatype tile;
+ * MPI_Type_contiguous(sizeof(fastnum::packed_tile<Stats>), MPI_BYTE, &tile);
+ * MPI_Type_commit(&tile);
+ * MPI_Op op;
+ * MPI_Op_create(&fastnum::packed_reduce_op<Stats, MPI_Datatype>, 1, &op);
+ * MPI_Allreduce(MPI_IN_PLACE, local.data(), static_cast<int>(local.tile_count()), tile, op, comm);
+ * ```
+ *
+ * Tiles are in host byte order with 64-bit counts, and their width does not
+ * depend on the instruction set, so ranks built with different SIMD flags
+ * can reduce together; use `serialization.hpp` for storage or mixed-endian
+ * transport. As with the serialized format, NaN-policy skip tallies are not
+ * part of the packed state, and compensation terms are folded in on `set()`.
+ * Merged counts must stay below 2^52.
+ */
+
+/// States per tile; a multiple of every SIMD width, and fixed across ISAs.
+inline constexpr std::size_t packed_lanes = 16;
+
+/// Tiles needed to hold `n` states.
+[[nodiscard]] constexpr std::size_t packed_tile_count(std::size_t n) noexcept {
+    return (n + packed_lanes - 1) / packed_lanes;
+}
+
+/**
+ * @brief Tile layout and lane-wise merge for one accumulator type.
+ *
+ * Specializations provide `value_type`, a trivially copyable `tile` of
+ * `packed_lanes` states (an all-zero tile holds empty states), `set(tile&,
+ * lane, const Acc&)`, `get(const tile&, lane)`, and `merge(const tile& in,
+ * tile& inout)`, which leaves every lane of `inout` as `merge()` would.
+ */
+template <class Acc>
+struct packed_traits;
+
+namespace detail {
+
+// Counts are converted in registers (see simd::load_counts) and summed as
+// integers afterwards, so the SIMD loads never wait on scalar stores.
+inline void packed_add_counts(const std::uint64_t* in, std::uint64_t* inout) noexcept {
+    for (std::size_t l = 0; l < packed_lanes; ++l) inout[l] += in[l];
+}
+
+} // namespace detail
+
+template <typename T, class P>
+struct packed_traits<RunningStats<T, P>> {
+    using value_type = T;
+
+    struct tile {
+        std::uint64_t n[packed_lanes];
+        T mean[packed_lanes];
+        T m2[packed_lanes];
+    };
+
+    static void set(tile& t, std::size_t lane, const RunningStats<T, P>& s) noexcept {
+        t.n[lane] = static_cast<std::uint64_t>(s.count());
+        t.mean[lane] = s.mean();
+        t.m2[lane] = s.m2();
+    }
+
+    [[nodiscard]] static RunningStats<T, P> get(const tile& t, std::size_t lane) noexcept {
+        return RunningStats<T, P>::from_moments(static_cast<std::size_t>(t.n[lane]), t.mean[lane], t.m2[lane]);
+    }
+
+    // RunningStats::combine with one reciprocal per register; lanes where one
+    // side is empty take the other side unchanged, as combine() does.
+    static void merge(const tile& in, tile& inout) noexcept {
+        using B = detail::simd::batch<T>;
+        const B one = B::broadcast(T{1});
+        for (std::size_t l = 0; l < packed_lanes; l += B::width) {
+            const B na = detail::simd::load_counts<T>(inout.n + l);
+            const B nb = detail::simd::load_counts<T>(in.n + l);
+            const B ma = B::load(inout.mean + l);
+            const B mb = B::load(in.mean + l);
+            const B qa = B::load(inout.m2 + l);
+            const B qb = B::load(in.m2 + l);
+            const B inv = one / (na + nb);
+            const B d = mb - ma;
+            const B mean = (na * ma + nb * mb) * inv;
+            const B m2 = qa + (qb + (d * d) * (na * nb * inv));
+            const auto a_empty = na < one;
+            const auto b_empty = nb < one;
+            select(a_empty, mb, select(b_empty, ma, mean)).store(inout.mean + l);
+            select(a_empty, qb, select(b_empty, qa, m2)).store(inout.m2 + l);
+        }
+        detail::packed_add_counts(in.n, inout.n);
+    }
+};
+
+template <typename T, class P>
+struct packed_traits<OnlineCovariance<T, P>> {
+    using value_type = T;
+
+    struct tile {
+        std::uint64_t n[packed_lanes];
+        T mean_x[packed_lanes];
+        T mean_y[packed_lanes];
+        T m2_x[packed_lanes];
+        T m2_y[packed_lanes];
+        T c[packed_lanes];
+    };
+
+    static void set(tile& t, std::size_t lane, const OnlineCovariance<T, P>& s) noexcept {
+        t.n[lane] = static_cast<std::uint64_t>(s.count());
+        t.mean_x[lane] = s.mean_x();
+        t.mean_y[lane] = s.mean_y();
+        t.m2_x[lane] = s.m2_x();
+        t.m2_y[lane] = s.m2_y();
+        t.c[lane] = s.comoment();
+    }
+
+    [[nodiscard]] static OnlineCovariance<T, P> get(const tile& t, std::size_t lane) noexcept {
+        return OnlineCovariance<T, P>::from_moments(static_cast<std::size_t>(t.n[lane]), t.mean_x[lane],
+                                                    t.mean_y[lane], t.m2_x[lane], t.m2_y[lane], t.c[lane]);
+    }
+
+    // OnlineCovariance::combine, one division per register.
+    static void merge(const tile& in, tile& inout) noexcept {
+        using B = detail::simd::batch<T>;
+        const B one = B::broadcast(T{1});
+        const auto fold = [](auto a_empty, auto b_empty, B a, B b, B merged, T* out) {
+            select(a_empty, b, select(b_empty, a, merged)).store(out);
+        };
+        for (std::size_t l = 0; l < packed_lanes; l += B::width) {
+            const B na = detail::simd::load_counts<T>(inout.n + l);
+            const B nb = detail::simd::load_counts<T>(in.n + l);
+            const B r = nb / (na + nb);
+            const B w = na * r;
+            const auto a_empty = na < one;
+            const auto b_empty = nb < one;
+
+            const B xa = B::load(inout.mean_x + l);
+            const B xb = B::load(in.mean_x + l);
+            const B ya = B::load(inout.mean_y + l);
+            const B yb = B::load(in.mean_y + l);
+            const B dx = xb - xa;
+            const B dy = yb - ya;
+            fold(a_empty, b_empty, xa, xb, xa + dx * r, inout.mean_x + l);
+            fold(a_empty, b_empty, ya, yb, ya + dy * r, inout.mean_y + l);
+
+            const B qxa = B::load(inout.m2_x + l);
+            const B qxb = B::load(in.m2_x + l);
+            fold(a_empty, b_empty, qxa, qxb, qxa + qxb + dx * dx * w, inout.m2_x + l);
+            const B qya = B::load(inout.m2_y + l);
+            const B qyb = B::load(in.m2_y + l);
+            fold(a_empty, b_empty, qya, qyb, qya + qyb + dy * dy * w, inout.m2_y + l);
+            const B ca = B::load(inout.c + l);
+            const B cb = B::load(in.c + l);
+            fold(a_empty, b_empty, ca, cb, ca + cb + dx * dy * w, inout.c + l);
+        }
+        detail::packed_add_counts(in.n, inout.n);
+    }
+};
+
+/// One reduction unit: `packed_lanes` states of type `Acc`.
+template <class Acc>
+using packed_tile = typename packed_traits<Acc>::tile;
+
+/**
+ * @brief Merge `tiles` tiles from `in` into `inout`, lane by lane.
+ *
+ * The bulk form of `merge()` for every state of two packed buffers, e.g. as
+ * the user reduction of a collective library. Neither pointer needs more
+ * than the tile's natural alignment.
+ */
+template <class Acc>
+void packed_merge(const packed_tile<Acc>* in, packed_tile<Acc>* inout, std::size_t tiles) noexcept {
+    static_assert(std::is_trivially_copyable_v<packed_tile<Acc>>);
+    if (!in || !inout) return;
+    for (std::size_t i = 0; i < tiles; ++i) packed_traits<Acc>::merge(in[i], inout[i]);
+}
+
+/**
+ * @brief `MPI_User_function`-compatible form of `packed_merge`.
+ *
+ * `*len` is the number of tiles, so the datatype must be one contiguous tile
+ * (see the file comment). Instantiate with `Datatype = MPI_Datatype` to get
+ * exactly the signature `MPI_Op_create` expects; this header does not
+ * include MPI itself. Merging is commutative, so the op may be created with
+ * `commute = 1`; as for any floating-point reduction, the collective's
+ * reduction order decides the last bits of the result.
+ */
+template <class Acc, class Datatype = void>
+void packed_reduce_op(void* in, void* inout, int* len, std::type_identity_t<Datatype>*) noexcept {
+    if (!len || *len <= 0) return;
+    packed_merge<Acc>(static_cast<const packed_tile<Acc>*>(in), static_cast<packed_tile<Acc>*>(inout),
+                      static_cast<std::size_t>(*len));
+}
+
+/**
+ * @brief N accumulators in one contiguous buffer of tiles.
+ *
+ * State `i` lives in lane `i % packed_lanes` of tile `i / packed_lanes`;
+ * lanes past `size()` in the last tile stay empty and merge as no-ops.
+ * `data()` / `bytes()` give the raw buffer for a collective, `merge()` the
+ * same reduction locally.
+ */
+template <class Acc>
+class packed_states {
+    using traits = packed_traits<Acc>;
+
+public:
+    using tile = packed_tile<Acc>;
+
+    packed_states() = default;
+    explicit packed_states(std::size_t n) : n_(n), tiles_(packed_tile_count(n), tile{}) {}
+
+    /// Pack `accs[0..n)`.
+    packed_states(const Acc* accs, std::size_t n) : packed_states(n) {
+        for (std::size_t i = 0; i < n; ++i) set(i, accs[i]);
+    }
+
+    explicit packed_states(std::span<const Acc> accs) : packed_states(accs.data(), accs.size()) {}
+
+    [[nodiscard]] std::size_t size() const noexcept { return n_; }
+    [[nodiscard]] std::size_t tile_count() const noexcept { return tiles_.size(); }
+    [[nodiscard]] std::size_t bytes() const noexcept { return tiles_.size() * sizeof(tile); }
+    [[nodiscard]] tile* data() noexcept { return tiles_.data(); }
+    [[nodiscard]] const tile* data() const noexcept { return tiles_.data(); }
+
+    /// Store `acc` as state `i` (`i < size()`).
+    void set(std::size_t i, const Acc& acc) noexcept {
+        traits::set(tiles_[i / packed_lanes], i % packed_lanes, acc);
+    }
+
+    /// Unpack state `i` (`i < size()`).
+    [[nodiscard]] Acc operator[](std::size_t i) const noexcept {
+        return traits::get(tiles_[i / packed_lanes], i % packed_lanes);
+    }
+
+    /// Unpack the first `min(n, size())` states into `out`.
+    void unpack(Acc* out, std::size_t n) const noexcept {
+        if (!out) return;
+        for (std::size_t i = 0; i < n && i < n_; ++i) out[i] = (*this)[i];
+    }
+
+    /// Merge state `i` of `other` into state `i`, for `i < min(size(), other.size())`.
+    void merge(const packed_states& other) noexcept {
+        // Padding lanes of `other` are empty, so whole tiles merge exactly;
+        // only states of a larger `other` landing in our padding are undone.
+        const std::size_t m = tile_count() < other.tile_count() ? tile_count() : other.tile_count();
+        packed_merge<Acc>(other.data(), data(), m);
+        if (other.n_ > n_ && m == tile_count() && m > 0) {
+            for (std::size_t l = n_ - (m - 1) * packed_lanes; l < packed_lanes; ++l) {
+                traits::set(tiles_[m - 1], l, Acc{});
+            }
+        }
+    }
+
+    /// Empty every state, keeping the size.
+    void reset() noexcept {
+        for (tile& t : tiles_) t = tile{};
+    }
+
+private:
+    std::size_t n_{0};
+    std::vector<tile> tiles_;
+};
+
+} // namespace fastnum
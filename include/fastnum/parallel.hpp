@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+#include <fastnum/detail/parallel.hpp>
+
+namespace fastnum {
+
+/**
+ * @brief Threading knobs for the `parallel_observe` family.
+ *
+ * - `threads`: maximum number of threads including the caller
+ *   (`0` = `std::thread::hardware_concurrency()`).
+ * - `min_chunk`: smallest number of samples handed to one thread; inputs
+ *   shorter than `2 * min_chunk` are fitted on the calling thread.
+ */
+struct parallel_policy {
+    std::size_t threads{0};
+    std::size_t min_chunk{std::size_t{1} << 16};
+};
+
+/**
+ * @brief Fit `acc` on `xs[0..n)` using several threads.
+ *
+ * The input is split into contiguous chunks, each chunk is fitted into an
+ * empty copy of `acc` (a copy after `reset()`, so configuration such as a
+ * sketch's `k` or a histogram's range carries over) with its batch
+ * `observe(const T*, n)`, and the partial states are combined with a pairwise
+ * tree of `merge()` calls before being merged into `acc`. Works with
+ * `RunningStats`, `OnlineStandardScaler`, `QuantileSketch`, `Histogram` and
+ * any other copyable accumulator exposing batch `observe`, `merge` and
+ * `reset`. Order-sensitive accumulators (`ExponentialStats` and scalers
+ * built on it) are rejected at compile time.
+ *
+ * `acc` may already hold state; the result equals observing `xs` into it
+ * serially, up to floating-point roundoff (for sketches: up to the usual
+ * merge error bound).
+ *
+ * Allocates one `Acc` per chunk (the only possible exception is
+ * `std::bad_alloc`). If a worker thread cannot be started its chunk is fitted
+ * on the caller.
+ */
+template <class Acc, class T>
+void parallel_observe(const parallel_policy& policy, Acc& acc, const T* xs, std::size_t n) {
+    static_assert(!detail::order_sensitive_v<Acc>, "parallel_observe requires an order-insensitive accumulator");
+    if (!xs || n == 0) return;
+
+    const std::size_t chunks = detail::chunk_count(n, policy.threads, policy.min_chunk);
+    if (chunks == 1) {
+        acc.observe(xs, n);
+        return;
+    }
+
+    std::vector<Acc> parts(chunks, detail::empty_like(acc));
+    detail::parallel_chunks(n, policy.threads, policy.min_chunk,
+        [&](std::size_t begin, std::size_t end, std::size_t c) {
+            parts[c].observe(xs + begin, end - begin);
+        });
+
+    detail::tree_merge(parts.data(), chunks);
+    acc.merge(parts[0]);
+}
+
+/// Paired overload for `OnlineCovariance`-style accumulators (`observe(xs, ys, n)`).
+template <class Acc, class T>
+void parallel_observe(const parallel_policy& policy, Acc& acc,
+                      const T* xs, const T* ys, std::size_t n) {
+    static_assert(!detail::order_sensitive_v<Acc>, "parallel_observe requires an order-insensitive accumulator");
+    if (!xs || !ys || n == 0) return;
+
+    const std::size_t chunks = detail::chunk_count(n, policy.threads, policy.min_chunk);
+    if (chunks == 1) {
+        acc.observe(xs, ys, n);
+        return;
+    }
+
+    std::vector<Acc> parts(chunks, detail::empty_like(acc));
+    detail::parallel_chunks(n, policy.threads, policy.min_chunk,
+        [&](std::size_t begin, std::size_t end, std::size_t c) {
+            parts[c].observe(xs + begin, ys + begin, end - begin);
+        });
+
+    detail::tree_merge(parts.data(), chunks);
+    acc.merge(parts[0]);
+}
+
+/// Container overload (`.data()` / `.size()`).
+template <class Acc, class Container>
+auto parallel_observe(const parallel_policy& policy, Acc& acc, const Container& c)
+    -> decltype(c.data(), c.size(), void()) {
+    parallel_observe(policy, acc, c.data(), static_cast<std::size_t>(c.size()));
+}
+
+/// Paired container overload.
+template <class Acc, class CX, class CY>
+auto parallel_observe(const parallel_policy& policy, Acc& acc, const CX& xs, const CY& ys)
+    -> decltype(xs.data(), xs.size(), ys.data(), ys.size(), void()) {
+    assert(static_cast<std::size_t>(xs.size()) == static_cast<std::size_t>(ys.size()));
+    parallel_observe(policy, acc, xs.data(), ys.data(), static_cast<std::size_t>(xs.size()));
+}
+
+} // namespace fastnum
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <fastnum/instrumentation.hpp>
+
+namespace fastnum {
+
+/// What batch and scalar `observe` do with non-finite inputs (NaN, +/-inf).
+enum class nan_policy {
+    propagate,     ///< observe them like any value; results become NaN / inf
+    skip,          ///< drop them (pairwise for two-variable accumulators)
+    count_and_skip ///< drop them and count the drops in `skipped()`
+};
+
+/**
+ * @brief Compile-time configuration shared by the scalar accumulators.
+ *
+ * A policy is a stateless type providing
+ * - `count_type`: unsigned integer holding the sample count, and
+ * - `template <class T> static constexpr T eps`: readiness threshold; a
+ *   quantity counts as ready once its population variance exceeds `eps^2`,
+ * - optionally `instrumentation`: hook type called on observe / merge /
+ *   not-ready transforms (see `no_instrumentation`), and
+ * - optionally `static constexpr nan_policy nans`: handling of non-finite
+ *   inputs (default `nan_policy::propagate`), and
+ * - optionally `static constexpr bool compensated`: Kahan-compensated
+ *   accumulation (default `false`; see `compensated_policy`).
+ *
+ * Nothing is stored per object, so the threshold costs no space and
+ * `sizeof` depends only on `T` and `count_type` (see `accumulator_size`).
+ * Custom policies can derive from one of the predefined ones and override
+ * either member.
+ */
+struct default_policy {
+    using count_type = std::size_t;
+
+    template <class T>
+    static constexpr T eps = static_cast<T>(1e-12);
+
+    using instrumentation = no_instrumentation;
+
+    static constexpr nan_policy nans = nan_policy::propagate;
+};
+
+/**
+ * @brief 32-bit counts: halves the count field, up to `2^32 - 1` samples.
+ *
+ * Pays off with `float` state (`RunningStats<float, compact_policy>` is 12
+ * bytes instead of 16); with `double` state the saved bytes are alignment
+ * padding.
+ */
+struct compact_policy : default_policy {
+    using count_type = std::uint32_t;
+};
+
+/**
+ * @brief `Base` with instrumentation hooks `Hooks`, e.g.
+ *        `instrumented_policy<counting_instrumentation<>>`.
+ */
+template <class Hooks, class Base = default_policy>
+struct instrumented_policy : Base {
+    using instrumentation = Hooks;
+};
+
+/**
+ * @brief `Base` with non-finite input handling `P`, e.g.
+ *        `RunningStats<double, nan_handling_policy<nan_policy::count_and_skip>>`.
+ *
+ * Implemented by `RunningStats` and `OnlineCovariance` (and scalers built on
+ * them); the other accumulators only propagate and reject the skipping
+ * policies at compile time.
+ */
+template <nan_policy P, class Base = default_policy>
+struct nan_handling_policy : Base {
+    static constexpr nan_policy nans = P;
+};
+
+/**
+ * @brief `Base` with Kahan-compensated accumulation, e.g.
+ *        `RunningStats<float, compensated_policy<>>`.
+ *
+ * The mean and M2 recurrences carry a running compensation term each (in the
+ * scalar path and per SIMD lane in the batch kernel), so rounding error stays
+ * at a few ulps instead of growing with the stream length. Worth it for long
+ * single-precision streams: above ~2^24 samples a plain `float` mean stops
+ * moving at all, since `delta / n` falls below half an ulp. Costs two extra
+ * fields and roughly twice the flops; the weighted and NaN-masked kernels are
+ * not compensated. Only `RunningStats` implements it; the other accumulators
+ * reject the policy at compile time rather than silently ignoring it.
+ */
+template <class Base = default_policy>
+struct compensated_policy : Base {
+    static constexpr bool compensated = true;
+};
+
+namespace detail {
+
+template <class Policy, class = void>
+inline constexpr bool compensated_of_v = false;
+
+/// `Policy::compensated` if present, else `false`.
+template <class Policy>
+inline constexpr bool compensated_of_v<Policy, std::void_t<decltype(Policy::compensated)>> = Policy::compensated;
+
+/// Running Kahan compensation of an accumulator's mean and M2; empty when off.
+template <class T, bool On>
+struct kahan_terms {
+    static constexpr T mean() noexcept { return T{0}; }
+    static constexpr T m2() noexcept { return T{0}; }
+    constexpr void clear() noexcept {}
+};
+
+template <class T>
+struct kahan_terms<T, true> {
+    T c_mean{0};
+    T c_m2{0};
+    constexpr T mean() const noexcept { return c_mean; }
+    constexpr T m2() const noexcept { return c_m2; }
+    constexpr void clear() noexcept { c_mean = c_m2 = T{0}; }
+};
+
+/// `sum += t` with Kahan compensation `c` (the low-order part lost so far,
+/// negated); works on scalars and SIMD batches alike.
+template <class V>
+constexpr void kahan_add(V& sum, V& c, V t) noexcept {
+    const V y = t - c;
+    const V s = sum + y;
+    c = (s - sum) - y;
+    sum = s;
+}
+
+template <class Policy, class = void>
+inline constexpr nan_policy nan_policy_of_v = nan_policy::propagate;
+
+/// `Policy::nans` if present, else `nan_policy::propagate`.
+template <class Policy>
+inline constexpr nan_policy nan_policy_of_v<Policy, std::void_t<decltype(Policy::nans)>> = Policy::nans;
+
+/// Drop counter of accumulators with `nan_policy::count_and_skip`; empty otherwise.
+template <class Count, bool Counting>
+struct skip_counter {
+    static constexpr Count value() noexcept { return 0; }
+    constexpr void add(std::size_t) noexcept {}
+};
+
+template <class Count>
+struct skip_counter<Count, true> {
+    Count n = 0;
+    constexpr Count value() const noexcept { return n; }
+    constexpr void add(std::size_t k) noexcept { n += static_cast<Count>(k); }
+};
+
+template <class Policy>
+inline constexpr bool is_policy_v =
+    std::is_unsigned_v<typename Policy::count_type> &&
+    std::is_same_v<std::remove_cv_t<decltype(Policy::template eps<double>)>, double>;
+
+template <class Stats, class = void>
+struct policy_of {
+    using type = default_policy;
+};
+
+template <class Stats>
+struct policy_of<Stats, std::void_t<typename Stats::policy_type>> {
+    using type = typename Stats::policy_type;
+};
+
+/// `Stats::policy_type` if present, else `default_policy`.
+template <class Stats>
+using policy_of_t = typename policy_of<Stats>::type;
+
+} // namespace detail
+
+/**
+ * @brief Guaranteed object size of an accumulator with `k` floating-point
+ *        fields of type `T` and a `count_type` counter.
+ *
+ * Every accumulator static_asserts its `sizeof` against this, so layouts
+ * cannot silently grow.
+ */
+template <class T, class Policy, std::size_t k>
+inline constexpr std::size_t accumulator_size = [] {
+    constexpr std::size_t c = sizeof(typename Policy::count_type);
+    constexpr std::size_t a = alignof(T) > alignof(typename Policy::count_type)
+                                  ? alignof(T)
+                                  : alignof(typename Policy::count_type);
+    constexpr std::size_t raw = (c + alignof(T) - 1) / alignof(T) * alignof(T) + k * sizeof(T);
+    return (raw + a - 1) / a * a;
+}();
+
+} // namespace fastnum
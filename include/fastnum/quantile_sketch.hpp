@@ -0,0 +1,462 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace fastnum {
+
+/**
+ * @brief Bounded-memory, mergeable streaming quantile sketch (KLL).
+ *
+ * Implements the KLL sketch (Karnin, Lang, Liberty 2016) in the compact
+ * single-buffer layout popularized by Apache DataSketches: retained samples
+ * are organized in levels, an item on level `h` stands for `2^h` input
+ * samples, and a level that reaches its capacity is sorted and *compacted*:
+ * every other item (random offset) is promoted to the level above, the rest
+ * are dropped. Level capacities shrink geometrically (factor 2/3) from the
+ * top level down to a floor of 8, so memory is `O(k)` regardless of the
+ * stream length.
+ *
+ * ## Error bound
+ * For a sketch with parameter `k`, the normalized rank error of `rank()` and
+ * `quantile()` is at most `normalized_rank_error(k)` with 99% confidence
+ * (about 1.3% for the default `k = 200`, roughly proportional to `1 / k`),
+ * independent of the data distribution and the number of samples. Merged
+ * sketches keep the bound of the smaller `k`. `min()` / `max()` and
+ * `quantile(0)` / `quantile(1)` are exact.
+ *
+ * ## Memory
+ * The sketch never retains more than `required_capacity(k)` values (about
+ * `3k + 400`). Two modes:
+ * - `QuantileSketch(k)`: owns a buffer of exactly that size, allocated once.
+ * - `QuantileSketch(buffer, capacity)`: allocation-free, uses a caller-owned
+ *   buffer; `k` is the largest value whose `required_capacity` fits. The
+ *   buffer must outlive the sketch. Copying such a sketch yields an owning
+ *   sketch; moving keeps the borrowed buffer.
+ *
+ * ## Conventions
+ * - `observe(x)` / `observe(xs, n)` / `merge(other)` / `reset()` as for the
+ *   moment accumulators, `ready()` once a sample was seen.
+ * - `NaN` inputs are ignored (they have no rank) and are not counted.
+ * - Queries on an empty sketch return `NaN`.
+ * - Queries are `const` but sort the unsorted bottom level in place, so
+ *   concurrent queries on one sketch need external synchronization.
+ * - Results do not depend on batch boundaries: `observe(xs, n)` and `n`
+ *   scalar observes produce identical sketches.
+ *
+ * @tparam T Floating-point type of the samples.
+ */
+template <typename T = double>
+class QuantileSketch {
+    static_assert(std::is_floating_point_v<T>, "QuantileSketch requires floating point T");
+
+public:
+    using value_type = T;
+
+    static constexpr std::size_t default_k = 200;
+    static constexpr std::size_t min_k = 8;
+    static constexpr std::size_t max_k = 65535;
+    /// Enough levels for any `std::size_t` sample count.
+    static constexpr std::size_t max_levels = 64;
+
+    // --- Sizing --------------------------------------------------------------
+
+    /// Values retained at most by a sketch with parameter `k`.
+    [[nodiscard]] static constexpr std::size_t required_capacity(std::size_t k) noexcept {
+        std::size_t total = 0;
+        for (std::size_t d = 0; d < max_levels; ++d) total += level_capacity(k, d);
+        return total;
+    }
+
+    /// Largest `k` whose `required_capacity` fits in `capacity` values (0 if none >= `min_k`).
+    [[nodiscard]] static constexpr std::size_t k_for_capacity(std::size_t capacity) noexcept {
+        if (capacity < required_capacity(min_k)) return 0;
+        std::size_t lo = min_k, hi = max_k;
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo + 1) / 2;
+            if (required_capacity(mid) <= capacity) lo = mid;
+            else hi = mid - 1;
+        }
+        return lo;
+    }
+
+    /// Normalized rank error at 99% confidence (empirical KLL fit, Apache DataSketches).
+    [[nodiscard]] static double normalized_rank_error(std::size_t k) noexcept {
+        return 2.296 / std::pow(static_cast<double>(k), 0.9723);
+    }
+
+    // --- Construction --------------------------------------------------------
+
+    /// Owning sketch; allocates `required_capacity(k)` values once.
+    explicit QuantileSketch(std::size_t k = default_k)
+        : k_(std::clamp(k, min_k, max_k)), storage_(required_capacity(k_)) {
+        attach(storage_.data(), storage_.size());
+    }
+
+    /// Allocation-free sketch on a caller-owned buffer of `capacity` values.
+    QuantileSketch(T* buffer, std::size_t capacity) noexcept : k_(k_for_capacity(capacity)) {
+        assert(buffer && k_ >= min_k && "buffer smaller than required_capacity(min_k)");
+        attach(buffer, std::min(capacity, required_capacity(k_)));
+    }
+
+    QuantileSketch(const QuantileSketch& other) : k_(other.k_), storage_(other.capacity_) {
+        attach(storage_.data(), storage_.size());
+        copy_state(other);
+    }
+
+    QuantileSketch(QuantileSketch&& other) noexcept
+        : k_(other.k_), storage_(std::move(other.storage_)) {
+        data_ = other.data_; // vector moves keep the data pointer
+        capacity_ = other.capacity_;
+        copy_levels(other);
+        other.data_ = nullptr;
+        other.capacity_ = 0;
+        other.num_levels_ = 0;
+    }
+
+    QuantileSketch& operator=(const QuantileSketch& other) {
+        if (this != &other) {
+            QuantileSketch tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    QuantileSketch& operator=(QuantileSketch&& other) noexcept {
+        if (this != &other) {
+            k_ = other.k_;
+            storage_ = std::move(other.storage_);
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            copy_levels(other);
+            other.data_ = nullptr;
+            other.capacity_ = 0;
+            other.num_levels_ = 0;
+        }
+        return *this;
+    }
+
+    ~QuantileSketch() = default;
+
+    // --- Observe -------------------------------------------------------------
+
+    void observe(T x) noexcept {
+        if (std::isnan(x)) return;
+        if (levels_[0] == 0) compress();
+        data_[--levels_[0]] = x;
+        note_minmax(x);
+        ++n_;
+    }
+
+    void observe(const T* xs, std::size_t n) noexcept {
+        if (!xs) return;
+        std::size_t i = 0;
+        while (i < n) {
+            if (levels_[0] == 0) {
+                // Compact only for a value that needs the room, as the
+                // scalar observe does.
+                while (i < n && xs[i] != xs[i]) ++i;
+                if (i == n) break;
+                compress();
+            }
+            // Fill the free space in one go; NaNs are skipped.
+            const std::size_t end = i + std::min<std::size_t>(levels_[0], n - i);
+            std::uint32_t top = levels_[0];
+            T lo = min_, hi = max_;
+            for (; i < end; ++i) {
+                const T x = xs[i];
+                if (x != x) continue;
+                data_[--top] = x;
+                lo = x < lo ? x : lo;
+                hi = x > hi ? x : hi;
+            }
+            n_ += levels_[0] - top;
+            levels_[0] = top;
+            min_ = lo;
+            max_ = hi;
+        }
+    }
+
+    template <class Container>
+    auto observe(const Container& c) noexcept -> decltype(c.data(), c.size(), void()) {
+        observe(c.data(), static_cast<std::size_t>(c.size()));
+    }
+
+    // --- Merge / reset -------------------------------------------------------
+
+    /// Fold `other` in; weights are preserved level by level.
+    void merge(const QuantileSketch& other) {
+        if (other.n_ == 0) return;
+        if (&other == this) {
+            const QuantileSketch copy(other);
+            merge(copy);
+            return;
+        }
+        while (num_levels_ < other.num_levels_) add_level();
+        for (std::size_t h = 0; h < other.num_levels_; ++h) {
+            insert_run(h, other.data_ + other.levels_[h], other.level_size(h));
+        }
+        n_ += other.n_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    /// Forget all samples; keeps `k` and the buffer.
+    void reset() noexcept {
+        n_ = 0;
+        num_levels_ = 1;
+        levels_[0] = levels_[1] = static_cast<std::uint32_t>(capacity_);
+        min_ = std::numeric_limits<T>::infinity();
+        max_ = -std::numeric_limits<T>::infinity();
+    }
+
+    // --- Accessors -----------------------------------------------------------
+
+    [[nodiscard]] std::size_t count() const noexcept { return n_; }
+    [[nodiscard]] std::size_t k() const noexcept { return k_; }
+    [[nodiscard]] bool ready() const noexcept { return n_ > 0; }
+
+    /// Values currently retained (`<= required_capacity(k())`).
+    [[nodiscard]] std::size_t retained() const noexcept { return capacity_ - levels_[0]; }
+
+    [[nodiscard]] T min() const noexcept { return n_ ? min_ : std::numeric_limits<T>::quiet_NaN(); }
+    [[nodiscard]] T max() const noexcept { return n_ ? max_ : std::numeric_limits<T>::quiet_NaN(); }
+
+    /**
+     * @brief Approximate `q`-quantile, `0 <= q <= 1`.
+     *
+     * Returns the smallest retained value whose estimated normalized rank
+     * (fraction of samples `<=` it) is at least `q`.
+     */
+    [[nodiscard]] T quantile(T q) const noexcept {
+        T out;
+        quantiles(&q, &out, 1);
+        return out;
+    }
+
+    /// `out[i] = quantile(qs[i])` in one pass; `qs` must be ascending.
+    void quantiles(const T* qs, T* out, std::size_t m) const noexcept {
+        if (!qs || !out || m == 0) return;
+        if (n_ == 0) {
+            std::fill(out, out + m, std::numeric_limits<T>::quiet_NaN());
+            return;
+        }
+        sort_level0();
+
+        std::uint32_t cur[max_levels];
+        for (std::size_t h = 0; h < num_levels_; ++h) cur[h] = levels_[h];
+
+        const auto n = static_cast<double>(n_);
+        std::uint64_t cum = 0;
+        std::size_t j = 0;
+        T last = min_;
+        while (j < m) {
+            const double q = static_cast<double>(qs[j]);
+            if (q <= 0 || std::isnan(q)) {
+                out[j++] = std::isnan(q) ? std::numeric_limits<T>::quiet_NaN() : min_;
+                continue;
+            }
+            if (q >= 1) {
+                out[j++] = max_;
+                continue;
+            }
+            if (static_cast<double>(cum) >= q * n) {
+                out[j++] = last;
+                continue;
+            }
+            // Advance to the next smallest retained value across all levels.
+            std::size_t best = max_levels;
+            for (std::size_t h = 0; h < num_levels_; ++h) {
+                if (cur[h] < levels_[h + 1] && (best == max_levels || data_[cur[h]] < data_[cur[best]])) best = h;
+            }
+            if (best == max_levels) {
+                out[j++] = max_;
+                continue;
+            }
+            last = data_[cur[best]++];
+            cum += std::uint64_t{1} << best;
+        }
+    }
+
+    /// Estimated fraction of samples `<= x`.
+    [[nodiscard]] T rank(T x) const noexcept {
+        if (n_ == 0 || std::isnan(x)) return std::numeric_limits<T>::quiet_NaN();
+        std::uint64_t weight = 0;
+        for (std::size_t i = levels_[0]; i < levels_[1]; ++i) weight += data_[i] <= x;
+        for (std::size_t h = 1; h < num_levels_; ++h) {
+            const T* b = data_ + levels_[h];
+            const T* e = data_ + levels_[h + 1];
+            weight += static_cast<std::uint64_t>(std::upper_bound(b, e, x) - b) << h;
+        }
+        return static_cast<T>(static_cast<double>(weight) / static_cast<double>(n_));
+    }
+
+private:
+    static constexpr std::size_t min_level_capacity = 8;
+
+    // Capacity of the level `depth` steps below the top: ceil(k (2/3)^depth), floor 8.
+    [[nodiscard]] static constexpr std::size_t level_capacity(std::size_t k, std::size_t depth) noexcept {
+        if (depth > 30) return min_level_capacity;
+        std::uint64_t pow3 = 1;
+        for (std::size_t i = 0; i < depth; ++i) pow3 *= 3;
+        const std::uint64_t num = static_cast<std::uint64_t>(k) << depth;
+        const auto cap = static_cast<std::size_t>((num + pow3 - 1) / pow3);
+        return cap > min_level_capacity ? cap : min_level_capacity;
+    }
+
+    void attach(T* data, std::size_t capacity) noexcept {
+        data_ = data;
+        capacity_ = capacity;
+        reset();
+    }
+
+    void copy_levels(const QuantileSketch& other) noexcept {
+        n_ = other.n_;
+        num_levels_ = other.num_levels_;
+        for (std::size_t h = 0; h <= num_levels_; ++h) levels_[h] = other.levels_[h];
+        min_ = other.min_;
+        max_ = other.max_;
+        rng_ = other.rng_;
+    }
+
+    // Same sizes (copy constructor): the layout can be copied verbatim.
+    void copy_state(const QuantileSketch& other) noexcept {
+        copy_levels(other);
+        std::copy(other.data_ + other.levels_[0], other.data_ + other.capacity_, data_ + levels_[0]);
+    }
+
+    [[nodiscard]] std::uint32_t level_size(std::size_t h) const noexcept { return levels_[h + 1] - levels_[h]; }
+
+    void note_minmax(T x) noexcept {
+        min_ = x < min_ ? x : min_;
+        max_ = x > max_ ? x : max_;
+    }
+
+    void sort_level0() const noexcept {
+        // Logically const: level 0 is an unordered multiset.
+        std::sort(data_ + levels_[0], data_ + levels_[1]);
+    }
+
+    [[nodiscard]] bool random_bit() noexcept {
+        // xorshift64: deterministic, so results are reproducible.
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 7;
+        rng_ ^= rng_ << 17;
+        return rng_ & 1u;
+    }
+
+    void add_level() noexcept {
+        assert(num_levels_ < max_levels);
+        levels_[num_levels_ + 1] = levels_[num_levels_];
+        ++num_levels_;
+    }
+
+    // Compact the lowest level at capacity. A full buffer always has one; when
+    // making room for a merge there may be none, then take the lowest level
+    // holding at least two items.
+    void compress() noexcept {
+        std::size_t h = 0;
+        for (; h < num_levels_; ++h) {
+            if (level_size(h) >= level_capacity(k_, num_levels_ - 1 - h)) break;
+        }
+        if (h == num_levels_) {
+            for (h = 0; h < num_levels_ && level_size(h) < 2; ++h) {}
+            if (h == num_levels_) return;
+        }
+        if (h + 1 == num_levels_) add_level();
+        compact_level(h);
+    }
+
+    void compact_level(std::size_t h) noexcept {
+        const std::uint32_t raw_beg = levels_[h];
+        const std::uint32_t raw_lim = levels_[h + 1];
+        const std::uint32_t pop_above = levels_[h + 2] - raw_lim;
+        const std::uint32_t raw_pop = raw_lim - raw_beg;
+        const std::uint32_t odd = raw_pop & 1u;
+        const std::uint32_t adj_beg = raw_beg + odd;
+        const std::uint32_t half = (raw_pop - odd) / 2;
+
+        if (h == 0) std::sort(data_ + adj_beg, data_ + raw_lim);
+        const std::uint32_t offset = random_bit() ? 1u : 0u;
+        if (pop_above == 0) {
+            // Keep every other item, packed into the upper half [adj_beg + half, raw_lim).
+            for (std::uint32_t i = 0; i < half; ++i) {
+                data_[raw_lim - 1 - i] = data_[raw_lim - 1 - offset - 2 * i];
+            }
+        } else {
+            // Keep every other item in [adj_beg, adj_beg + half), then merge it
+            // with the level above into [adj_beg + half, levels_[h + 2]).
+            for (std::uint32_t i = 0; i < half; ++i) data_[adj_beg + i] = data_[adj_beg + offset + 2 * i];
+            merge_forward(data_ + adj_beg, half, data_ + raw_lim, pop_above, data_ + adj_beg + half);
+        }
+        levels_[h + 1] -= half;
+
+        if (odd) {
+            levels_[h] = levels_[h + 1] - 1;
+            data_[levels_[h]] = data_[raw_beg];
+        } else {
+            levels_[h] = levels_[h + 1];
+        }
+        // Close the gap of `half` slots below level h.
+        if (h > 0) {
+            std::copy_backward(data_ + levels_[0], data_ + raw_beg, data_ + raw_beg + half);
+            for (std::size_t i = 0; i < h; ++i) levels_[i] += half;
+        }
+    }
+
+    // Merge sorted a[0, na) and b[0, nb) into dest, where dest may overlap b
+    // as long as dest + i + j <= b + j (true for the in-place layouts here).
+    static void merge_forward(const T* a, std::uint32_t na, const T* b, std::uint32_t nb, T* dest) noexcept {
+        std::uint32_t i = 0, j = 0, o = 0;
+        while (i < na && j < nb) dest[o++] = b[j] < a[i] ? b[j++] : a[i++];
+        while (i < na) dest[o++] = a[i++];
+        while (j < nb) dest[o++] = b[j++];
+    }
+
+    // Add `cnt` items of weight 2^h (sorted if h > 0), making room first.
+    void insert_run(std::size_t h, const T* src, std::uint32_t cnt) noexcept {
+        const std::uint32_t chunk_max = static_cast<std::uint32_t>(std::max<std::size_t>(1, capacity_ / 4));
+        while (cnt > 0) {
+            const std::uint32_t c = std::min(cnt, chunk_max);
+            while (levels_[0] < c) compress();
+            if (h == 0) {
+                levels_[0] -= c;
+                std::copy(src, src + c, data_ + levels_[0]);
+            } else {
+                const std::uint32_t beg = levels_[h];
+                // Shift levels below h down by c, then merge into level h.
+                std::copy(data_ + levels_[0], data_ + beg, data_ + levels_[0] - c);
+                for (std::size_t i = 0; i < h; ++i) levels_[i] -= c;
+                T* dest = data_ + beg - c;
+                std::uint32_t i = 0, j = 0, o = 0;
+                const std::uint32_t ne = levels_[h + 1] - beg;
+                const T* e = data_ + beg;
+                while (i < c && j < ne) dest[o++] = e[j] < src[i] ? e[j++] : src[i++];
+                while (i < c) dest[o++] = src[i++];
+                levels_[h] = beg - c;
+            }
+            src += c;
+            cnt -= c;
+        }
+    }
+
+    std::size_t k_;
+    std::vector<T> storage_{};
+    T* data_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t n_{0};
+    std::size_t num_levels_{1};
+    // Level h occupies data_[levels_[h], levels_[h + 1]); free space is [0, levels_[0]).
+    std::uint32_t levels_[max_levels + 1]{};
+    T min_{std::numeric_limits<T>::infinity()};
+    T max_{-std::numeric_limits<T>::infinity()};
+    std::uint64_t rng_{0x9E3779B97F4A7C15ull};
+};
+
+} // namespace fastnum
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <fastnum/policy.hpp>
+#include <fastnum/detail/simd.hpp>
+
+namespace fastnum {
+
+/**
+ * @brief Online central moments up to a compile-time order.
+ *
+ * Generalizes `RunningStats` (which is the `Order == 2` case) to the third and
+ * fourth central moment sums `M3 = sum (x - mean)^3`, `M4 = sum (x - mean)^4`
+ * using the one-pass update and pairwise merge formulas of Pébay (2008), so
+ * mean, variance, skewness and kurtosis come out of a single pass.
+ *
+ * `Order` selects what is tracked, and nothing beyond it is stored or
+ * computed:
+ * | Order | state              | accessors                                 |
+ * |-------|--------------------|-------------------------------------------|
+ * | 0     | count              | `count()`                                 |
+ * | 1     | + mean             | `mean()`                                  |
+ * | 2     | + M2               | `variance_*()`, `stddev_*()`              |
+ * | 3     | + M3               | `skewness()`                              |
+ * | 4     | + M4               | `kurtosis()`, `excess_kurtosis()`         |
+ *
+ * Accessors above the configured order fail to compile.
+ *
+ * Batch `observe(const T*, n)` uses the same lane-blocked SIMD scheme as
+ * `RunningStats`: every lane runs its own update with a shared count (one
+ * scalar division per block), and lanes are folded with the pairwise merge.
+ *
+ * @tparam T      Floating-point type.
+ * @tparam Order  Highest central moment tracked (0..4).
+ * @tparam Policy Count type (see `default_policy`).
+ */
+template <typename T = double, std::size_t Order = 4, class Policy = default_policy>
+class RunningMoments {
+    static_assert(std::is_floating_point_v<T>, "RunningMoments requires floating point T");
+    static_assert(Order <= 4, "RunningMoments supports moments up to order 4");
+    static_assert(detail::is_policy_v<Policy>, "RunningMoments requires a fastnum policy");
+    static_assert(!detail::compensated_of_v<Policy>, "RunningMoments does not implement compensated_policy");
+    static_assert(detail::nan_policy_of_v<Policy> == nan_policy::propagate,
+                  "RunningMoments only supports nan_policy::propagate");
+
+public:
+    using value_type = T;
+    using policy_type = Policy;
+    using count_type = typename Policy::count_type;
+    static constexpr std::size_t order = Order;
+
+    // --- Observe -------------------------------------------------------------
+
+    constexpr void observe(T x) noexcept {
+        const T n1 = static_cast<T>(n_);
+        ++n_;
+        if constexpr (Order >= 1) {
+            const T n = static_cast<T>(n_);
+            const T delta = x - m_[0];
+            const T delta_n = delta / n;
+            if constexpr (Order >= 2) {
+                const T term1 = delta * delta_n * n1;
+                if constexpr (Order >= 3) {
+                    const T delta_n2 = delta_n * delta_n;
+                    if constexpr (Order >= 4) {
+                        m_[3] += term1 * delta_n2 * (n * n - T{3} * n + T{3}) + T{6} * delta_n2 * m_[1] -
+                                 T{4} * delta_n * m_[2];
+                    }
+                    m_[2] += term1 * delta_n * (n - T{2}) - T{3} * delta_n * m_[1];
+                }
+                m_[1] += term1;
+            }
+            m_[0] += delta_n;
+        }
+    }
+
+    constexpr void observe(const T* xs, std::size_t n) noexcept {
+        if (!xs || n == 0) return;
+        if constexpr (Order == 0) {
+            n_ += static_cast<count_type>(n);
+        } else {
+            if (std::is_constant_evaluated()) {
+                for (std::size_t i = 0; i < n; ++i) observe(xs[i]);
+                return;
+            }
+            observe_lanes(xs, n);
+        }
+    }
+
+    template <class Container>
+    constexpr auto observe(const Container& c) noexcept
+        -> decltype(c.data(), c.size(), void()) {
+        observe(c.data(), static_cast<std::size_t>(c.size()));
+    }
+
+    // --- Merge / reset -------------------------------------------------------
+
+    constexpr void merge(const RunningMoments& other) noexcept {
+        if (other.n_ == 0) return;
+        if (n_ == 0) {
+            *this = other;
+            return;
+        }
+        if constexpr (Order >= 1) {
+            const T na = static_cast<T>(n_);
+            const T nb = static_cast<T>(other.n_);
+            const T n = na + nb;
+            const T delta = other.m_[0] - m_[0];
+            const T delta_n = delta / n;
+            if constexpr (Order >= 2) {
+                const T nab = na * nb;
+                if constexpr (Order >= 3) {
+                    const T delta_n2 = delta_n * delta_n;
+                    if constexpr (Order >= 4) {
+                        m_[3] += other.m_[3] + delta * delta_n2 * delta_n * nab * (na * na - nab + nb * nb) +
+                                 T{6} * delta_n2 * (na * na * other.m_[1] + nb * nb * m_[1]) +
+                                 T{4} * delta_n * (na * other.m_[2] - nb * m_[2]);
+                    }
+                    m_[2] += other.m_[2] + delta * delta_n2 * nab * (na - nb) +
+                             T{3} * delta_n * (na * other.m_[1] - nb * m_[1]);
+                }
+                m_[1] += other.m_[1] + delta * delta_n * nab;
+            }
+            m_[0] += delta_n * nb;
+        }
+        n_ += other.n_;
+    }
+
+    constexpr void reset() noexcept { *this = RunningMoments{}; }
+
+    // --- Accessors -----------------------------------------------------------
+
+    [[nodiscard]] constexpr std::size_t count() const noexcept { return n_; }
+
+    [[nodiscard]] constexpr T mean() const noexcept {
+        static_assert(Order >= 1, "mean() requires Order >= 1");
+        return m_[0];
+    }
+
+    /// Raw central moment sum `M_k = sum (x - mean)^k`, `2 <= k <= Order`.
+    template <std::size_t K>
+    [[nodiscard]] constexpr T moment_sum() const noexcept {
+        static_assert(K >= 2 && K <= Order, "moment_sum<K>() requires 2 <= K <= Order");
+        return m_[K - 1];
+    }
+
+    [[nodiscard]] constexpr T variance_population() const noexcept {
+        static_assert(Order >= 2, "variance requires Order >= 2");
+        if (n_ < 1) return std::numeric_limits<T>::quiet_NaN();
+        return m_[1] / static_cast<T>(n_);
+    }
+
+    [[nodiscard]] constexpr T variance_sample() const noexcept {
+        static_assert(Order >= 2, "variance requires Order >= 2");
+        if (n_ < 2) return std::numeric_limits<T>::quiet_NaN();
+        return m_[1] / static_cast<T>(n_ - 1);
+    }
+
+    [[nodiscard]] T stddev_population() const noexcept { return std::sqrt(variance_population()); }
+    [[nodiscard]] T stddev_sample() const noexcept { return std::sqrt(variance_sample()); }
+
+    /// Population skewness `sqrt(n) M3 / M2^(3/2)`; NaN for `n < 2` or zero variance.
+    [[nodiscard]] T skewness() const noexcept {
+        static_assert(Order >= 3, "skewness() requires Order >= 3");
+        if (n_ < 2 || !(m_[1] > T{0})) return std::numeric_limits<T>::quiet_NaN();
+        return std::sqrt(static_cast<T>(n_)) * m_[2] / (m_[1] * std::sqrt(m_[1]));
+    }
+
+    /// Population kurtosis `n M4 / M2^2` (3 for a normal distribution).
+    [[nodiscard]] constexpr T kurtosis() const noexcept {
+        static_assert(Order >= 4, "kurtosis() requires Order >= 4");
+        if (n_ < 2 || !(m_[1] > T{0})) return std::numeric_limits<T>::quiet_NaN();
+        return static_cast<T>(n_) * m_[3] / (m_[1] * m_[1]);
+    }
+
+    /// `kurtosis() - 3` (0 for a normal distribution).
+    [[nodiscard]] constexpr T excess_kurtosis() const noexcept { return kurtosis() - T{3}; }
+
+private:
+    // One SIMD lane set per moment; lanes share the count, so inv_n and the
+    // count-dependent coefficients are scalars broadcast once per block.
+    void observe_lanes(const T* xs, std::size_t n) noexcept {
+        using B = detail::simd::batch<T>;
+        constexpr std::size_t W = B::width;
+        constexpr std::size_t U = Order >= 3 ? 2 : 4; // keep all sets in registers
+        constexpr std::size_t L = W * U;
+
+        const std::size_t blocks = n / L;
+        if (blocks > 0) {
+            B m[Order][U];
+            for (std::size_t k = 0; k < Order; ++k)
+                for (std::size_t u = 0; u < U; ++u) m[k][u] = B::broadcast(T{0});
+
+            for (std::size_t b = 0; b < blocks; ++b) {
+                const T nt = static_cast<T>(b + 1);
+                const B inv_n = B::broadcast(T{1} / nt);
+                [[maybe_unused]] const B n1 = B::broadcast(static_cast<T>(b));
+                [[maybe_unused]] const B c3 = B::broadcast(nt - T{2});
+                [[maybe_unused]] const B c4 = B::broadcast(nt * nt - T{3} * nt + T{3});
+                const T* p = xs + b * L;
+                for (std::size_t u = 0; u < U; ++u) {
+                    const B delta = B::load(p + u * W) - m[0][u];
+                    const B delta_n = delta * inv_n;
+                    if constexpr (Order >= 2) {
+                        const B term1 = delta * delta_n * n1;
+                        if constexpr (Order >= 3) {
+                            const B delta_n2 = delta_n * delta_n;
+                            if constexpr (Order >= 4) {
+                                m[3][u] = m[3][u] + term1 * delta_n2 * c4 +
+                                          B::broadcast(T{6}) * delta_n2 * m[1][u] -
+                                          B::broadcast(T{4}) * delta_n * m[2][u];
+                            }
+                            m[2][u] = m[2][u] + term1 * delta_n * c3 - B::broadcast(T{3}) * delta_n * m[1][u];
+                        }
+                        m[1][u] = m[1][u] + term1;
+                    }
+                    m[0][u] = m[0][u] + delta_n;
+                }
+            }
+
+            RunningMoments lanes[L];
+            T buf[W];
+            for (std::size_t k = 0; k < Order; ++k) {
+                for (std::size_t u = 0; u < U; ++u) {
+                    m[k][u].store(buf);
+                    for (std::size_t j = 0; j < W; ++j) lanes[u * W + j].m_[k] = buf[j];
+                }
+            }
+            for (std::size_t i = 0; i < L; ++i) lanes[i].n_ = static_cast<count_type>(blocks);
+
+            // Pairwise tree: every level merges equal-count partials.
+            for (std::size_t w = L / 2; w > 0; w /= 2) {
+                for (std::size_t i = 0; i < w; ++i) lanes[i].merge(lanes[i + w]);
+            }
+            merge(lanes[0]);
+        }
+
+        for (std::size_t i = blocks * L; i < n; ++i) observe(xs[i]);
+    }
+
+    count_type n_{0};
+    // m_[0] = mean, m_[k - 1] = M_k for k >= 2 (one unused slot when Order == 0).
+    T m_[Order == 0 ? 1 : Order]{};
+};
+
+static_assert(sizeof(RunningMoments<double, 2>) == accumulator_size<double, default_policy, 2>);
+static_assert(sizeof(RunningMoments<double, 4>) == accumulator_size<double, default_policy, 4>);
+static_assert(sizeof(RunningMoments<float, 4, compact_policy>) == accumulator_size<float, compact_policy, 4>);
+
+} // namespace fastnum
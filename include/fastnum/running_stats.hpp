@@ -3,47 +3,169 @@
 #include <cstddef>
 #include <limits>
 #include <cmath>
+#include <span>
 #include <type_traits>
+#include <fastnum/policy.hpp>
+#include <fastnum/detail/simd.hpp>
 
 namespace fastnum {
 
-    template <typename T = double>
+    // Policy supplies the count type and readiness epsilon; see policy.hpp.
+    template <typename T = double, class Policy = default_policy>
     class RunningStats {
+        static_assert(detail::is_policy_v<Policy>, "RunningStats requires a fastnum policy");
+
     public:
+    using value_type = T;
+    using policy_type = Policy;
+    using count_type = typename Policy::count_type;
+    static constexpr nan_policy nans = detail::nan_policy_of_v<Policy>;
+    static constexpr bool compensated = detail::compensated_of_v<Policy>;
+
+    // Rebuild an accumulator from its raw moments (count, mean, M2), e.g. a
+    // partial state shipped from another process.
+    [[nodiscard]] static constexpr RunningStats from_moments(std::size_t n, T mean, T m2) noexcept {
+        RunningStats rs;
+        rs.n_ = static_cast<count_type>(n);
+        rs.mean_ = n == 0 ? T{0} : mean;
+        rs.m2_ = n == 0 ? T{0} : m2;
+        return rs;
+    }
+
     constexpr void observe(T x) noexcept {
-        ++n_;
-        const T delta = x - mean_;
-        mean_ += delta / static_cast<T>(n_);
-        const T delta2 = x - mean_;
-        m2_ += delta * delta2;
+        detail::note_observe<hooks>(x);
+        put(x);
+    }
+
+    // Batch observe. Keeps independent Welford accumulators per SIMD lane
+    // (all lanes share the same count, so the division is one scalar per
+    // block) and folds them in with merge(). When the NaN policy skips
+    // non-finite values, clean data still takes this kernel; from the first
+    // chunk holding a non-finite value on, such values are masked to weight 0
+    // in the weighted lane kernel, so skipping needs no filtering pass.
+    constexpr void observe(const T* xs, std::size_t n) noexcept {
+        if (!xs || n == 0) return;
+        detail::note_observe<hooks>(xs, n);
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < n; ++i) put(xs[i]);
+            return;
+        }
+        observe_batch(n, [xs](std::size_t i) { return batch_type::load(xs + i); },
+                      [xs](std::size_t i) { return xs[i]; });
+    }
+
+    // Mixed-precision batch observe: narrower inputs (e.g. float data into
+    // double state) are widened in registers by the loads of the same
+    // kernel, so there is no upcast copy and the state keeps full precision.
+    template <class U>
+        requires (std::is_floating_point_v<U> && sizeof(U) < sizeof(T))
+    constexpr void observe(const U* xs, std::size_t n) noexcept {
+        if (!xs || n == 0) return;
+        detail::note_observe<hooks>(xs, n);
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < n; ++i) put(static_cast<T>(xs[i]));
+            return;
+        }
+        observe_batch(n, [xs](std::size_t i) { return detail::simd::load_widened<T>(xs + i); },
+                      [xs](std::size_t i) { return static_cast<T>(xs[i]); });
+    }
+
+    // Batch observe of `xs[0], xs[stride], ..., xs[(n - 1) * stride]`, e.g. a
+    // column of a row-major matrix, without copying it out first.
+    constexpr void observe_strided(const T* xs, std::size_t stride, std::size_t n) noexcept {
+        if (stride == 1) { observe(xs, n); return; }
+        if (!xs || n == 0) return;
+        detail::note_observe<hooks>(xs, n, stride);
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < n; ++i) put(xs[i * stride]);
+            return;
+        }
+        observe_batch(n, [xs, stride](std::size_t i) { return detail::simd::load_strided(xs + i * stride, stride); },
+                      [xs, stride](std::size_t i) { return xs[i * stride]; });
+    }
+
+    template <class Container>
+    constexpr auto observe(const Container& c) noexcept
+        -> decltype(c.data(), c.size(), void()) {
+        observe(c.data(), static_cast<std::size_t>(c.size()));
+    }
+
+    // Frequency-weighted observe: same result as `w` calls to observe(x), in
+    // O(1) (West's weighted update). Weights are counts because the state
+    // keeps an integral count: a fractional part is truncated and `w < 1` is
+    // a no-op, here and in the batch form alike.
+    constexpr void observe(T x, T w) noexcept {
+        detail::note_observe<hooks>(x);
+        put(x, w);
+    }
+
+    // Batch of (value, count) pairs. Lanes keep their own weight sums, so the
+    // ratio w / W is a vector division rather than a shared scalar.
+    constexpr void observe(const T* xs, const T* ws, std::size_t n) noexcept {
+        if (!xs || !ws || n == 0) return;
+        detail::note_observe<hooks>(xs, n);
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < n; ++i) put(xs[i], ws[i]);
+            return;
+        }
+        const std::size_t done = weighted_lanes<skips>(n, [xs, ws](std::size_t i, batch_type& x, batch_type& w) {
+            x = batch_type::load(xs + i);
+            w = batch_type::load(ws + i);
+        });
+        for (std::size_t i = done; i < n; ++i) put(xs[i], ws[i]);
+    }
+
+    // Inject an already-reduced chunk given by its count, mean and M2.
+    constexpr void observe_summary(std::size_t count, T mean, T m2) noexcept {
+        merge(from_moments(count, mean, m2));
     }
 
     // Merge another accumulator into this one (parallel-friendly).
     constexpr void merge(const RunningStats& other) noexcept {
-        if (other.n_ == 0) return;
-        if (n_ == 0) { *this = other; return; }
+        if constexpr (hooks::enabled) hooks::on_merge(1);
+        combine(other);
+    }
 
-        const T n_a = static_cast<T>(n_);
-        const T n_b = static_cast<T>(other.n_);
-        const T n_total = n_a + n_b;
+    // Fold many partial states at once. Parts are reduced in L1-sized blocks
+    // with two passes each: global count and mean first, then
+    // M2 = sum(m2_i) + sum(n_i (mean_i - mean)^2). One division per block, no
+    // serial dependency on the running state, and empty states contribute
+    // zeros instead of taking a branch. Blocks are combined with merge().
+    constexpr void merge_many(const RunningStats* parts, std::size_t count) noexcept {
+        if (!parts) return;
+        if constexpr (hooks::enabled) hooks::on_merge(count);
+        constexpr std::size_t block = 32768 / sizeof(RunningStats);
+        for (std::size_t base = 0; base < count; base += block) {
+            combine(reduce_block(parts + base, count - base < block ? count - base : block));
+        }
+    }
 
-        const T delta = other.mean_ - mean_;
-        mean_ = (n_a * mean_ + n_b * other.mean_) / n_total;
-        m2_ += other.m2_ + (delta * delta) * (n_a * n_b / n_total);
-        n_ += other.n_;
+    constexpr void merge_many(std::span<const RunningStats> parts) noexcept {
+        merge_many(parts.data(), parts.size());
     }
 
     [[nodiscard]] constexpr std::size_t count() const noexcept { return n_; }
-    [[nodiscard]] constexpr T mean() const noexcept { return mean_; }
+    [[nodiscard]] constexpr T mean() const noexcept {
+        if constexpr (compensated) return mean_ - comp_.mean();
+        else return mean_;
+    }
+    // Sum of squared deviations from the mean (Welford's M2).
+    [[nodiscard]] constexpr T m2() const noexcept {
+        if constexpr (compensated) return m2_ - comp_.m2();
+        else return m2_;
+    }
+    // Non-finite inputs dropped so far; always 0 unless the policy uses
+    // nan_policy::count_and_skip.
+    [[nodiscard]] constexpr std::size_t skipped() const noexcept { return skipped_.value(); }
 
     [[nodiscard]] constexpr T variance_population() const noexcept {
         if (n_ < 1) return std::numeric_limits<T>::quiet_NaN();
-        return m2_ / static_cast<T>(n_);
+        return m2() / static_cast<T>(n_);
     }
 
     [[nodiscard]] constexpr T variance_sample() const noexcept {
         if (n_ < 2) return std::numeric_limits<T>::quiet_NaN();
-        return m2_ / static_cast<T>(n_ - 1);
+        return m2() / static_cast<T>(n_ - 1);
     }
 
     [[nodiscard]] T stddev_population() const noexcept {
@@ -60,12 +182,317 @@ namespace fastnum {
         n_ = 0;
         mean_ = T{0};
         m2_ = T{0};
+        comp_.clear();
+        skipped_ = {};
     }
 
     private:
-    std::size_t n_{0};
+    using batch_type = detail::simd::batch<T>;
+    using hooks = detail::instrumentation_of_t<Policy>;
+    static constexpr bool skips = nans != nan_policy::propagate;
+
+    // Single updates under the NaN policy.
+    constexpr void put(T x) noexcept {
+        if constexpr (skips) {
+            if (!(x - x == T{0})) { skipped_.add(1); return; }
+        }
+        push(x);
+    }
+
+    constexpr void put(T x, T w) noexcept {
+        if constexpr (skips) {
+            if (!((x - x) + (w - w) == T{0})) { skipped_.add(1); return; }
+        }
+        push(x, w);
+    }
+
+    // Uninstrumented updates behind the public entry points.
+    constexpr void push(T x) noexcept {
+        ++n_;
+        const T delta = x - mean_;
+        if constexpr (compensated) {
+            detail::kahan_add(mean_, comp_.c_mean, delta / static_cast<T>(n_));
+            detail::kahan_add(m2_, comp_.c_m2, delta * (x - mean_));
+        } else {
+            mean_ += delta / static_cast<T>(n_);
+            const T delta2 = x - mean_;
+            m2_ += delta * delta2;
+        }
+    }
+
+    constexpr void push(T x, T w) noexcept {
+        if (!(w >= T{1})) return;
+        const auto c = static_cast<count_type>(w);
+        n_ += c;
+        const T cw = static_cast<T>(c);
+        const T delta = x - mean_;
+        mean_ += delta * cw / static_cast<T>(n_);
+        m2_ += cw * delta * (x - mean_);
+    }
+
+    // Fold the compensation terms into mean / M2, e.g. before a merge.
+    constexpr void settle() noexcept {
+        mean_ = mean();
+        m2_ = m2();
+        comp_.clear();
+    }
+
+    constexpr void combine(const RunningStats& other) noexcept {
+        if constexpr (compensated) {
+            settle();
+            if (other.comp_.mean() != T{0} || other.comp_.m2() != T{0}) {
+                RunningStats settled = other;
+                settled.settle();
+                combine(settled);
+                return;
+            }
+        }
+        skipped_.add(other.skipped_.value());
+        if (other.n_ == 0) return;
+        if (n_ == 0) {
+            n_ = other.n_;
+            mean_ = other.mean_;
+            m2_ = other.m2_;
+            return;
+        }
+
+        const T n_a = static_cast<T>(n_);
+        const T n_b = static_cast<T>(other.n_);
+        const T n_total = n_a + n_b;
+
+        const T delta = other.mean_ - mean_;
+        mean_ = (n_a * mean_ + n_b * other.mean_) / n_total;
+        m2_ += other.m2_ + (delta * delta) * (n_a * n_b / n_total);
+        n_ += other.n_;
+    }
+
+    [[nodiscard]] static constexpr RunningStats reduce_block(const RunningStats* parts, std::size_t count) noexcept {
+        // Shift by a representative mean so the first pass sums small values.
+        // Moments go through mean() / m2(), which fold in any compensation
+        // terms, as combine() does via settle().
+        const T pivot = parts[0].mean();
+
+        std::size_t total = 0;
+        T s[4] = {T{0}, T{0}, T{0}, T{0}};
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            for (std::size_t k = 0; k < 4; ++k) {
+                total += parts[i + k].n_;
+                s[k] += static_cast<T>(parts[i + k].n_) * (parts[i + k].mean() - pivot);
+            }
+        }
+        for (; i < count; ++i) {
+            total += parts[i].n_;
+            s[0] += static_cast<T>(parts[i].n_) * (parts[i].mean() - pivot);
+        }
+        RunningStats out;
+        if constexpr (nans == nan_policy::count_and_skip) {
+            for (i = 0; i < count; ++i) out.skipped_.add(parts[i].skipped_.value());
+        }
+        if (total == 0) return out;
+        const T mean = pivot + ((s[0] + s[1]) + (s[2] + s[3])) / static_cast<T>(total);
+
+        T m[4] = {T{0}, T{0}, T{0}, T{0}};
+        for (i = 0; i + 4 <= count; i += 4) {
+            for (std::size_t k = 0; k < 4; ++k) {
+                const T d = parts[i + k].mean() - mean;
+                m[k] += parts[i + k].m2() + static_cast<T>(parts[i + k].n_) * d * d;
+            }
+        }
+        for (; i < count; ++i) {
+            const T d = parts[i].mean() - mean;
+            m[0] += parts[i].m2() + static_cast<T>(parts[i].n_) * d * d;
+        }
+
+        out.n_ = static_cast<count_type>(total);
+        out.mean_ = mean;
+        out.m2_ = (m[0] + m[1]) + (m[2] + m[3]);
+        return out;
+    }
+
+    // Batch update over `load(i)` (elements [i, i + width)) and `at(i)`.
+    template <class Load, class At>
+    void observe_batch(std::size_t n, Load load, At at) noexcept {
+        std::size_t done = 0;
+        if constexpr (skips) {
+            // Chunks take the unmasked kernel while the data is clean (the
+            // common case). Once a chunk's result comes out non-finite, it
+            // and the rest of the batch go through the masked kernel, so a
+            // dirty batch costs at most one extra chunk. Dropping only
+            // non-finite inputs, the redo matches the masked result even if
+            // the first attempt merely overflowed.
+            using B = batch_type;
+            constexpr std::size_t C = 8192;
+            const auto masked = [&](std::size_t off, std::size_t m) {
+                return weighted_lanes<true>(m, [&load, off](std::size_t i, B& x, B& w) {
+                    x = load(off + i);
+                    w = B::broadcast(T{1});
+                });
+            };
+            for (; done + C <= n; done += C) {
+                RunningStats chunk;
+                chunk.observe_lanes(C, [&load, off = done](std::size_t i) { return load(off + i); });
+                if (!(chunk.m2_ - chunk.m2_ == T{0})) break;
+                combine(chunk);
+            }
+            done += masked(done, n - done);
+        } else {
+            done = observe_lanes(n, load);
+        }
+        for (std::size_t i = done; i < n; ++i) put(at(i));
+    }
+
+    // Lane kernel over `load(i)`, which returns elements [i, i + width).
+    // Returns how many leading elements it consumed; the caller observes the rest.
+    template <class Load>
+    std::size_t observe_lanes(std::size_t n, Load load) noexcept {
+        using B = batch_type;
+        constexpr std::size_t W = B::width;
+        // Independent register sets per step; halved when each also carries
+        // two compensation registers.
+        constexpr std::size_t U = compensated ? 2 : 4;
+        constexpr std::size_t L = W * U;
+
+        const std::size_t blocks = n / L;
+        if (blocks > 0) {
+            B mean[U];
+            B m2[U];
+            B c_mean[U];
+            B c_m2[U];
+            for (std::size_t u = 0; u < U; ++u) {
+                mean[u] = B::broadcast(T{0});
+                m2[u] = B::broadcast(T{0});
+                c_mean[u] = B::broadcast(T{0});
+                c_m2[u] = B::broadcast(T{0});
+            }
+
+            for (std::size_t k = 0; k < blocks; ++k) {
+                const B inv_n = B::broadcast(T{1} / static_cast<T>(k + 1));
+                const std::size_t off = k * L;
+                for (std::size_t u = 0; u < U; ++u) {
+                    const B x = load(off + u * W);
+                    const B delta = x - mean[u];
+                    if constexpr (compensated) {
+                        detail::kahan_add(mean[u], c_mean[u], delta * inv_n);
+                        detail::kahan_add(m2[u], c_m2[u], delta * (x - mean[u]));
+                    } else {
+                        mean[u] = fma(delta, inv_n, mean[u]);
+                        m2[u] = fma(delta, x - mean[u], m2[u]);
+                    }
+                }
+            }
+
+            RunningStats lanes[L];
+            T lane_mean[L];
+            T lane_m2[L];
+            for (std::size_t u = 0; u < U; ++u) {
+                if constexpr (compensated) {
+                    mean[u] = mean[u] - c_mean[u];
+                    m2[u] = m2[u] - c_m2[u];
+                }
+                mean[u].store(lane_mean + u * W);
+                m2[u].store(lane_m2 + u * W);
+            }
+            for (std::size_t i = 0; i < L; ++i) {
+                lanes[i].n_ = static_cast<count_type>(blocks);
+                lanes[i].mean_ = lane_mean[i];
+                lanes[i].m2_ = lane_m2[i];
+            }
+
+            // Pairwise tree: every level merges equal-count partials.
+            for (std::size_t w = L / 2; w > 0; w /= 2) {
+                for (std::size_t i = 0; i < w; ++i) lanes[i].combine(lanes[i + w]);
+            }
+            combine(lanes[0]);
+        }
+        return blocks * L;
+    }
+
+    // Lane kernel for (value, weight) pairs from `load(i, x, w)`; lanes keep
+    // their own weight sums. With `Mask`, pairs whose value or weight is not
+    // finite get weight 0 and a mean-valued x, i.e. leave the lane unchanged,
+    // and are counted as skipped. Returns how many leading pairs it consumed.
+    template <bool Mask, class Load>
+    std::size_t weighted_lanes(std::size_t n, Load load) noexcept {
+        using B = batch_type;
+        constexpr std::size_t W = B::width;
+        constexpr std::size_t U = 4;
+        constexpr std::size_t L = W * U;
+
+        const std::size_t blocks = n / L;
+        if (blocks > 0) {
+            const B zero = B::broadcast(T{0});
+            const B one = B::broadcast(T{1});
+            std::size_t rejected = 0;
+            B mean[U], m2[U], wsum[U];
+            count_type lane_n[L] = {};
+            for (std::size_t u = 0; u < U; ++u) {
+                mean[u] = zero;
+                m2[u] = zero;
+                wsum[u] = zero;
+            }
+
+            for (std::size_t k = 0; k < blocks; ++k) {
+                const std::size_t off = k * L;
+                for (std::size_t u = 0; u < U; ++u) {
+                    B x, w;
+                    load(off + u * W, x, w);
+                    if constexpr (Mask) {
+                        const auto ok = ordered((x - x) + (w - w));
+                        rejected += W - B::popcount(ok);
+                        x = select(ok, x, mean[u]);
+                        w = select(ok, w, zero);
+                    }
+                    // Whole counts as in push(): truncate, and drop weights below 1.
+                    w = trunc(select(ordered(w), w, zero));
+                    w = select(w < one, zero, w);
+                    wsum[u] = wsum[u] + w;
+                    // Exact per-lane counts; the T sums above only feed the
+                    // ratio w / W and are not exact beyond 2^24 for float.
+                    T wt[W];
+                    w.store(wt);
+                    for (std::size_t l = 0; l < W; ++l) lane_n[u * W + l] += static_cast<count_type>(wt[l]);
+                    B r = w / wsum[u];
+                    r = select(finite(r), r, zero); // 0 / 0 until the lane's first weight
+                    const B delta = x - mean[u];
+                    mean[u] = fma(delta, r, mean[u]);
+                    m2[u] = fma(w * delta, x - mean[u], m2[u]);
+                }
+            }
+
+            RunningStats lanes[L];
+            T lane_mean[L];
+            T lane_m2[L];
+            for (std::size_t u = 0; u < U; ++u) {
+                mean[u].store(lane_mean + u * W);
+                m2[u].store(lane_m2 + u * W);
+            }
+            for (std::size_t i = 0; i < L; ++i) {
+                if (lane_n[i] == 0) continue;
+                lanes[i].n_ = lane_n[i];
+                lanes[i].mean_ = lane_mean[i];
+                lanes[i].m2_ = lane_m2[i];
+            }
+
+            for (std::size_t w = L / 2; w > 0; w /= 2) {
+                for (std::size_t i = 0; i < w; ++i) lanes[i].combine(lanes[i + w]);
+            }
+            combine(lanes[0]);
+            skipped_.add(rejected);
+        }
+        return blocks * L;
+    }
+
+    count_type n_{0};
     T mean_{0};
     T m2_{0};
+    [[no_unique_address]] detail::kahan_terms<T, compensated> comp_{};
+    [[no_unique_address]] detail::skip_counter<count_type, nans == nan_policy::count_and_skip> skipped_{};
     };
 
+    static_assert(sizeof(RunningStats<double>) == accumulator_size<double, default_policy, 2>);
+    static_assert(sizeof(RunningStats<float>) == accumulator_size<float, default_policy, 2>);
+    static_assert(sizeof(RunningStats<float, compact_policy>) == accumulator_size<float, compact_policy, 2>);
+    static_assert(sizeof(RunningStats<float, compensated_policy<>>) == accumulator_size<float, default_policy, 4>);
+
 }  // namespace fastnum
@@ -0,0 +1,381 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <fastnum/running_stats.hpp>
+#include <fastnum/online_covariance.hpp>
+#include <fastnum/detail/parallel.hpp>
+
+namespace fastnum {
+
+/**
+ * @file
+ * @brief Fixed-layout binary state format for shipping partial accumulators.
+ *
+ * A serialized blob is a 32-byte `state_header` followed by `count` fixed-size
+ * records, one per accumulator, with no gaps:
+ *
+ * | offset | size | field                                               |
+ * |--------|------|-----------------------------------------------------|
+ * | 0      | 4    | magic `"FNST"`                                      |
+ * | 4      | 2    | format version (`state_format_version`)             |
+ * | 6      | 1    | `state_kind` of the accumulator                     |
+ * | 7      | 1    | `sizeof(T)` of the floating-point fields            |
+ * | 8      | 4    | record size in bytes                                |
+ * | 12     | 4    | flags (bit 0: checksum present)                     |
+ * | 16     | 8    | record count                                        |
+ * | 24     | 8    | checksum over the record bytes (0 if absent)        |
+ *
+ * Counts are always stored as 64-bit, so states written with one policy can
+ * be read with another (decoding narrows to the reader's `count_type`).
+ *
+ * Every field, in the header and in the records, is little-endian regardless
+ * of the host. On little-endian hosts the records are exactly the in-memory
+ * `state_traits<Acc>::record` structs, so a reducer can map a file of
+ * millions of states and merge them straight from the mapping via
+ * `state_view` without any parsing step.
+ */
+
+/// Layout version written by `to_bytes`; readers reject any other version.
+inline constexpr std::uint16_t state_format_version = 1;
+
+/// Accumulator type tag stored in the header.
+enum class state_kind : std::uint8_t {
+    running_stats = 1,
+    online_covariance = 2,
+};
+
+/// Outcome of decoding a serialized blob.
+enum class state_error {
+    none,          ///< Decoded successfully.
+    truncated,     ///< Buffer smaller than the header or the records it announces.
+    bad_magic,     ///< Not a fastnum state blob.
+    bad_version,   ///< Written by an incompatible format version.
+    kind_mismatch, ///< Different accumulator type, scalar type or record size.
+    bad_checksum,  ///< Checksum present and does not match the records.
+    capacity,      ///< Output array too small for the records.
+};
+
+struct state_header {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint8_t kind;
+    std::uint8_t scalar_bytes;
+    std::uint32_t record_bytes;
+    std::uint32_t flags;
+    std::uint64_t count;
+    std::uint64_t checksum;
+
+    static constexpr std::uint32_t magic_value = 0x54534E46u; // "FNST" read as little-endian
+    static constexpr std::uint32_t flag_checksum = 1u;
+};
+static_assert(sizeof(state_header) == 32 && std::is_trivially_copyable_v<state_header>);
+
+namespace detail {
+
+template <class U>
+[[nodiscard]] constexpr U to_little_endian(U v) noexcept {
+    static_assert(std::is_trivially_copyable_v<U>);
+    if constexpr (std::endian::native == std::endian::little || sizeof(U) == 1) {
+        return v;
+    } else {
+        auto bytes = std::bit_cast<std::array<unsigned char, sizeof(U)>>(v);
+        for (std::size_t i = 0; i < sizeof(U) / 2; ++i) std::swap(bytes[i], bytes[sizeof(U) - 1 - i]);
+        return std::bit_cast<U>(bytes);
+    }
+}
+
+// Field-wise access straight into / out of the (unaligned) buffer: building a
+// record on the stack and copying it whole defeats store-to-load forwarding.
+template <class U>
+void store_le(unsigned char* dst, U v) noexcept {
+    v = to_little_endian(v);
+    std::memcpy(dst, &v, sizeof(U));
+}
+
+template <class U>
+[[nodiscard]] U load_le(const unsigned char* src) noexcept {
+    U v;
+    std::memcpy(&v, src, sizeof(U));
+    return to_little_endian(v);
+}
+
+/**
+ * @brief 64-bit hash of a byte range; detects corruption, not tampering.
+ *
+ * Four independent multiply-xorshift lanes over consecutive 8-byte words keep
+ * the multiplier busy instead of serializing on one dependency chain.
+ */
+[[nodiscard]] inline std::uint64_t state_checksum(const unsigned char* p, std::size_t n) noexcept {
+    constexpr std::uint64_t k = 0x9E3779B97F4A7C15ull;
+    const auto word = [p](std::size_t i) {
+        std::uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        return to_little_endian(w);
+    };
+    const auto mix = [](std::uint64_t h, std::uint64_t w) {
+        h = (h ^ w) * k;
+        return h ^ (h >> 29);
+    };
+
+    std::uint64_t h[4] = {0xCBF29CE484222325ull, 0x84222325CBF29CE4ull, 0x100000001B3ull, n * k};
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        for (std::size_t l = 0; l < 4; ++l) h[l] = mix(h[l], word(i + 8 * l));
+    }
+    for (; i + 8 <= n; i += 8) h[0] = mix(h[0], word(i));
+    std::uint64_t tail = 0;
+    for (std::size_t j = 0; i + j < n; ++j) tail |= static_cast<std::uint64_t>(p[i + j]) << (8 * j);
+
+    std::uint64_t r = mix(h[0], tail);
+    for (std::size_t l = 1; l < 4; ++l) r = mix(r, h[l]);
+    return r ^ (r >> 32);
+}
+
+} // namespace detail
+
+/**
+ * @brief Record layout and conversion for one accumulator type.
+ *
+ * Specializations provide `value_type`, `kind`, a trivially copyable
+ * `record` describing the on-disk layout, and `encode(const Acc&, dst)` /
+ * `decode(src)` converting between an accumulator and `sizeof(record)`
+ * little-endian bytes at an arbitrarily aligned address.
+ */
+template <class Acc>
+struct state_traits;
+
+template <typename T, class P>
+struct state_traits<RunningStats<T, P>> {
+    using value_type = T;
+    static constexpr state_kind kind = state_kind::running_stats;
+
+    struct record {
+        std::uint64_t n;
+        T mean;
+        T m2;
+    };
+
+    static void encode(const RunningStats<T, P>& s, unsigned char* dst) noexcept {
+        std::memset(dst, 0, sizeof(record));
+        detail::store_le(dst + offsetof(record, n), static_cast<std::uint64_t>(s.count()));
+        detail::store_le(dst + offsetof(record, mean), s.mean());
+        detail::store_le(dst + offsetof(record, m2), s.m2());
+    }
+
+    [[nodiscard]] static RunningStats<T, P> decode(const unsigned char* src) noexcept {
+        return RunningStats<T, P>::from_moments(
+            static_cast<std::size_t>(detail::load_le<std::uint64_t>(src + offsetof(record, n))),
+            detail::load_le<T>(src + offsetof(record, mean)), detail::load_le<T>(src + offsetof(record, m2)));
+    }
+};
+
+template <typename T, class P>
+struct state_traits<OnlineCovariance<T, P>> {
+    using value_type = T;
+    static constexpr state_kind kind = state_kind::online_covariance;
+
+    struct record {
+        std::uint64_t n;
+        T mean_x;
+        T mean_y;
+        T m2_x;
+        T m2_y;
+        T c;
+    };
+
+    static void encode(const OnlineCovariance<T, P>& s, unsigned char* dst) noexcept {
+        std::memset(dst, 0, sizeof(record)); // padding is part of the checksummed bytes
+        detail::store_le(dst + offsetof(record, n), static_cast<std::uint64_t>(s.count()));
+        detail::store_le(dst + offsetof(record, mean_x), s.mean_x());
+        detail::store_le(dst + offsetof(record, mean_y), s.mean_y());
+        detail::store_le(dst + offsetof(record, m2_x), s.m2_x());
+        detail::store_le(dst + offsetof(record, m2_y), s.m2_y());
+        detail::store_le(dst + offsetof(record, c), s.comoment());
+    }
+
+    [[nodiscard]] static OnlineCovariance<T, P> decode(const unsigned char* src) noexcept {
+        using detail::load_le;
+        return OnlineCovariance<T, P>::from_moments(
+            static_cast<std::size_t>(load_le<std::uint64_t>(src + offsetof(record, n))),
+            load_le<T>(src + offsetof(record, mean_x)), load_le<T>(src + offsetof(record, mean_y)),
+            load_le<T>(src + offsetof(record, m2_x)), load_le<T>(src + offsetof(record, m2_y)),
+            load_le<T>(src + offsetof(record, c)));
+    }
+};
+
+/// Bytes needed to serialize `count` accumulators of type `Acc`.
+template <class Acc>
+[[nodiscard]] constexpr std::size_t serialized_size(std::size_t count) noexcept {
+    return sizeof(state_header) + count * sizeof(typename state_traits<Acc>::record);
+}
+
+/**
+ * @brief Serialize `count` accumulators into `out`.
+ *
+ * @return Bytes written (`serialized_size<Acc>(count)`), or 0 if `capacity`
+ *         is too small. `out` needs no particular alignment.
+ */
+template <class Acc>
+std::size_t to_bytes(const Acc* accs, std::size_t count, void* out, std::size_t capacity,
+                     bool checksum = true) noexcept {
+    using traits = state_traits<Acc>;
+    using record = typename traits::record;
+    static_assert(std::is_trivially_copyable_v<record>);
+
+    const std::size_t total = serialized_size<Acc>(count);
+    if (!out || capacity < total || (count > 0 && !accs)) return 0;
+
+    auto* bytes = static_cast<unsigned char*>(out);
+    unsigned char* body = bytes + sizeof(state_header);
+    for (std::size_t i = 0; i < count; ++i) traits::encode(accs[i], body + i * sizeof(record));
+
+    state_header h;
+    h.magic = detail::to_little_endian(state_header::magic_value);
+    h.version = detail::to_little_endian(state_format_version);
+    h.kind = static_cast<std::uint8_t>(traits::kind);
+    h.scalar_bytes = static_cast<std::uint8_t>(sizeof(typename traits::value_type));
+    h.record_bytes = detail::to_little_endian(static_cast<std::uint32_t>(sizeof(record)));
+    h.flags = detail::to_little_endian(checksum ? state_header::flag_checksum : 0u);
+    h.count = detail::to_little_endian(static_cast<std::uint64_t>(count));
+    h.checksum = detail::to_little_endian(
+        checksum ? detail::state_checksum(body, count * sizeof(record)) : std::uint64_t{0});
+    std::memcpy(bytes, &h, sizeof h);
+    return total;
+}
+
+/// Serialize a single accumulator; see the array overload.
+template <class Acc>
+std::size_t to_bytes(const Acc& acc, void* out, std::size_t capacity, bool checksum = true) noexcept {
+    return to_bytes(&acc, 1, out, capacity, checksum);
+}
+
+/**
+ * @brief Read-only view over a serialized blob, e.g. a memory-mapped file.
+ *
+ * Construction validates the header (and, optionally, the checksum) but
+ * copies nothing. Records are decoded on access; on little-endian hosts with
+ * a suitably aligned buffer `records()` also exposes them in place.
+ *
+ * The underlying buffer must outlive the view.
+ */
+template <class Acc>
+class state_view {
+    using traits = state_traits<Acc>;
+
+public:
+    using record = typename traits::record;
+
+    state_view(const void* data, std::size_t size, bool verify_checksum = true) noexcept
+        : error_(validate(data, size, verify_checksum)) {}
+
+    [[nodiscard]] state_error error() const noexcept { return error_; }
+    [[nodiscard]] bool ok() const noexcept { return error_ == state_error::none; }
+
+    /// Number of records (0 unless `ok()`).
+    [[nodiscard]] std::size_t size() const noexcept { return count_; }
+
+    /// Decode record `i` (`i < size()`).
+    [[nodiscard]] Acc operator[](std::size_t i) const noexcept { return traits::decode(body_ + i * sizeof(record)); }
+
+    /// The records in place, or `nullptr` on big-endian hosts / misaligned buffers.
+    [[nodiscard]] const record* records() const noexcept {
+        if constexpr (std::endian::native != std::endian::little) return nullptr;
+        if (!ok() || reinterpret_cast<std::uintptr_t>(body_) % alignof(record) != 0) return nullptr;
+        return reinterpret_cast<const record*>(body_);
+    }
+
+    /**
+     * @brief Merge every record into `acc`.
+     *
+     * Records are decoded in small stack blocks and combined with a pairwise
+     * tree per block, so rounding error stays close to a full tree merge
+     * without materializing all states.
+     */
+    void merge_into(Acc& acc) const noexcept {
+        constexpr std::size_t block = 64;
+        Acc part[block];
+        for (std::size_t off = 0; off < count_; off += block) {
+            const std::size_t m = count_ - off < block ? count_ - off : block;
+            for (std::size_t i = 0; i < m; ++i) part[i] = (*this)[off + i];
+            detail::tree_merge(part, m);
+            acc.merge(part[0]);
+        }
+    }
+
+    /// Merge of all records.
+    [[nodiscard]] Acc merged() const noexcept {
+        Acc acc{};
+        merge_into(acc);
+        return acc;
+    }
+
+private:
+    state_error validate(const void* data, std::size_t size, bool verify_checksum) noexcept {
+        if (!data || size < sizeof(state_header)) return state_error::truncated;
+        const auto* bytes = static_cast<const unsigned char*>(data);
+
+        state_header h;
+        std::memcpy(&h, bytes, sizeof h);
+        if (detail::to_little_endian(h.magic) != state_header::magic_value) return state_error::bad_magic;
+        if (detail::to_little_endian(h.version) != state_format_version) return state_error::bad_version;
+        if (h.kind != static_cast<std::uint8_t>(traits::kind) ||
+            h.scalar_bytes != sizeof(typename traits::value_type) ||
+            detail::to_little_endian(h.record_bytes) != sizeof(record)) {
+            return state_error::kind_mismatch;
+        }
+
+        const std::uint64_t count = detail::to_little_endian(h.count);
+        if (count > (size - sizeof(state_header)) / sizeof(record)) return state_error::truncated;
+        const auto n = static_cast<std::size_t>(count);
+        const unsigned char* body = bytes + sizeof(state_header);
+
+        if (verify_checksum && (detail::to_little_endian(h.flags) & state_header::flag_checksum) &&
+            detail::state_checksum(body, n * sizeof(record)) != detail::to_little_endian(h.checksum)) {
+            return state_error::bad_checksum;
+        }
+
+        body_ = body;
+        count_ = n;
+        return state_error::none;
+    }
+
+    // Filled in by validate(), which runs in error_'s initializer.
+    const unsigned char* body_{nullptr};
+    std::size_t count_{0};
+    state_error error_;
+};
+
+/**
+ * @brief Decode up to `capacity` accumulators from `data`.
+ *
+ * @param count Receives the number of records in the blob (also on
+ *              `state_error::capacity`); may be `nullptr`.
+ */
+template <class Acc>
+state_error from_bytes(const void* data, std::size_t size, Acc* out, std::size_t capacity,
+                       std::size_t* count = nullptr) noexcept {
+    const state_view<Acc> view(data, size);
+    if (count) *count = view.size();
+    if (!view.ok()) return view.error();
+    if (view.size() > capacity || (view.size() > 0 && !out)) return state_error::capacity;
+    for (std::size_t i = 0; i < view.size(); ++i) out[i] = view[i];
+    return state_error::none;
+}
+
+/// Decode a blob holding exactly one accumulator.
+template <class Acc>
+state_error from_bytes(const void* data, std::size_t size, Acc& out) noexcept {
+    const state_view<Acc> view(data, size);
+    if (!view.ok()) return view.error();
+    if (view.size() != 1) return state_error::capacity;
+    out = view[0];
+    return state_error::none;
+}
+
+} // namespace fastnum
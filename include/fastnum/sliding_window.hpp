@@ -0,0 +1,236 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <fastnum/running_stats.hpp>
+#include <fastnum/online_covariance.hpp>
+
+namespace fastnum {
+
+/**
+ * @brief Statistics over the most recent `Buckets` time buckets.
+ *
+ * Time is cut into buckets of `bucket_width()` units; the window is the
+ * bucket holding the newest timestamp plus the `Buckets - 1` before it, e.g.
+ * `SlidingWindow<RunningStats<>, 300>(1'000'000'000)` over nanosecond
+ * timestamps is "the last 5 minutes" at 1 s resolution. Every bucket is one
+ * accumulator, so memory is fixed by `Buckets` and independent of the
+ * sample rate, and nothing is allocated.
+ *
+ * ## Two-stack aggregation
+ * Closed buckets form a queue kept as two stacks: the older part stores
+ * suffix aggregates (bucket `i` merged with every newer bucket of that
+ * part), the newer part a single running aggregate. Closing a bucket is
+ * one merge into the running aggregate; expiring one drops its suffix
+ * entry. When the older part runs empty, the newer part is turned into suffix aggregates in one pass of
+ * `Buckets` merges, which every closed bucket pays for once, so sliding is
+ * amortized O(1). `aggregate()` merges the oldest suffix, the running
+ * aggregate and the open bucket: two merges, whatever the window length.
+ *
+ * Merging is exact up to roundoff, unlike subtracting expired buckets
+ * (inverse Welford), which cancels catastrophically once the window mean
+ * drifts away from an expired bucket's mean.
+ *
+ * ## Notes
+ * - Timestamps must be non-decreasing; the window slides forward only.
+ *   Timestamps inside the open bucket cost one comparison.
+ * - A jump of `Buckets` or more buckets clears the window in O(Buckets)
+ *   rather than stepping through every empty bucket.
+ * - New buckets start as a copy of the prototype given to the constructor;
+ *   `Acc` need not be default-constructible (e.g. `Histogram`) when a
+ *   prototype is passed.
+ * - Not thread-safe.
+ *
+ * @tparam Acc     Accumulator with `merge(const Acc&)`, e.g. `RunningStats`.
+ * @tparam Buckets Buckets per window (the open one included), `>= 1`.
+ * @tparam Time    Arithmetic timestamp type; integral times bucket by floor division.
+ */
+template <class Acc, std::size_t Buckets, class Time = std::int64_t>
+class SlidingWindow {
+    static_assert(Buckets >= 1, "SlidingWindow needs at least one bucket");
+    static_assert(std::is_arithmetic_v<Time>, "SlidingWindow requires an arithmetic Time");
+
+public:
+    using accumulator_type = Acc;
+    using time_type = Time;
+
+    /// Buckets per window, the open one included.
+    static constexpr std::size_t buckets = Buckets;
+
+    explicit SlidingWindow(Time bucket_width, Acc prototype = Acc{})
+        : width_(bucket_width),
+          prototype_(std::move(prototype)),
+          open_(prototype_),
+          back_(prototype_),
+          raw_(filled(std::make_index_sequence<capacity>{})),
+          suffix_(filled(std::make_index_sequence<capacity>{})) {
+        assert(bucket_width > Time{0});
+    }
+
+    // --- Observe -------------------------------------------------------------
+
+    /// Slide to `t`, then forward `args` to the open bucket's `observe`,
+    /// e.g. `observe(t, x)`, `observe(t, x, y)` or `observe(t, xs, n)`.
+    template <class... Args>
+    void observe(Time t, Args&&... args) {
+        advance(t);
+        open_.observe(std::forward<Args>(args)...);
+    }
+
+    /// Slide the window so that its newest bucket holds `t`.
+    void advance(Time t) {
+        if (started_ && t < next_) return; // still in the open bucket: no division
+        const std::int64_t id = bucket_of(t);
+        if (!started_) {
+            started_ = true;
+            set_newest(id);
+            return;
+        }
+        assert(id >= newest_ && "timestamps must be non-decreasing");
+        if (id <= newest_) return;
+
+        const std::uint64_t steps = static_cast<std::uint64_t>(id - newest_);
+        set_newest(id);
+        if (steps >= Buckets) { // everything expired, the open bucket included
+            clear_closed();
+            open_ = prototype_;
+            return;
+        }
+        push(open_);
+        for (std::uint64_t s = 1; s < steps; ++s) push(prototype_);
+        open_ = prototype_;
+    }
+
+    /// The bucket currently being filled, for direct (e.g. batch) updates.
+    [[nodiscard]] Acc& open_bucket() noexcept { return open_; }
+    [[nodiscard]] const Acc& open_bucket() const noexcept { return open_; }
+
+    /// Forget every bucket; the next timestamp starts a new window.
+    void clear() {
+        clear_closed();
+        open_ = prototype_;
+        started_ = false;
+    }
+
+    // --- Query ---------------------------------------------------------------
+
+    /// Merged state of every bucket in the window.
+    [[nodiscard]] Acc aggregate() const {
+        Acc out = front_ > 0 ? suffix_[head_] : prototype_;
+        out.merge(back_);
+        out.merge(open_);
+        return out;
+    }
+
+    [[nodiscard]] Time bucket_width() const noexcept { return width_; }
+
+    /// Index `floor(t / bucket_width())` of the newest bucket (0 before any observation).
+    [[nodiscard]] std::int64_t newest_bucket() const noexcept { return started_ ? newest_ : 0; }
+
+    /// Start time of the oldest bucket in the window.
+    [[nodiscard]] Time window_begin() const noexcept {
+        return static_cast<Time>(newest_bucket() - static_cast<std::int64_t>(Buckets - 1)) * width_;
+    }
+
+    /// Closed buckets still in the window (at most `Buckets - 1`).
+    [[nodiscard]] std::size_t closed_buckets() const noexcept { return size_; }
+
+private:
+    static constexpr std::size_t capacity = Buckets - 1 > 0 ? Buckets - 1 : 1;
+
+    [[nodiscard]] std::int64_t bucket_of(Time t) const noexcept {
+        if constexpr (std::is_integral_v<Time>) {
+            const std::int64_t q = static_cast<std::int64_t>(t / width_);
+            if constexpr (std::is_signed_v<Time>) {
+                if (t % width_ < Time{0}) return q - 1; // round towards -inf
+            }
+            return q;
+        } else {
+            return static_cast<std::int64_t>(std::floor(t / width_));
+        }
+    }
+
+    void set_newest(std::int64_t id) noexcept {
+        newest_ = id;
+        next_ = static_cast<Time>(id + 1) * width_;
+    }
+
+    // Every slot a copy of the prototype, so Acc needs no default constructor.
+    template <std::size_t... I>
+    [[nodiscard]] std::array<Acc, capacity> filled(std::index_sequence<I...>) const {
+        return {{((void)I, prototype_)...}};
+    }
+
+    [[nodiscard]] static constexpr std::size_t wrap(std::size_t i) noexcept {
+        return i >= capacity ? i - capacity : i;
+    }
+
+    // Append a closed bucket, expiring the oldest when the window is full.
+    void push(const Acc& bucket) {
+        if constexpr (Buckets == 1) {
+            (void)bucket;
+        } else {
+            if (size_ == capacity) pop();
+            raw_[wrap(head_ + size_)] = bucket;
+            ++size_;
+            back_.merge(bucket);
+        }
+    }
+
+    void pop() {
+        if (front_ == 0) flip();
+        head_ = wrap(head_ + 1);
+        --size_;
+        --front_;
+    }
+
+    // Turn the newer part into suffix aggregates: suffix_[i] = raw_[i] merged
+    // with every closed bucket after it.
+    void flip() {
+        std::size_t i = wrap(head_ + size_ - 1);
+        suffix_[i] = raw_[i];
+        for (std::size_t k = 1; k < size_; ++k) {
+            const std::size_t next = i;
+            i = i == 0 ? capacity - 1 : i - 1;
+            suffix_[i] = raw_[i];
+            suffix_[i].merge(suffix_[next]);
+        }
+        front_ = size_;
+        back_ = prototype_;
+    }
+
+    void clear_closed() {
+        head_ = 0;
+        size_ = 0;
+        front_ = 0;
+        back_ = prototype_;
+    }
+
+    Time width_;
+    Acc prototype_;
+    Acc open_;
+    Acc back_;                         // merge of the closed buckets in the newer part
+    std::array<Acc, capacity> raw_;    // closed buckets, oldest at head_
+    std::array<Acc, capacity> suffix_; // suffix aggregates of the older part
+    std::size_t head_{0};
+    std::size_t size_{0};  // closed buckets
+    std::size_t front_{0}; // closed buckets in the older (suffix) part
+    std::int64_t newest_{0};
+    Time next_{0}; // start of the bucket after the open one
+    bool started_{false};
+};
+
+/// Windowed `RunningStats` (mean / variance over the last `Buckets` buckets).
+template <std::size_t Buckets, typename T = double, class Time = std::int64_t>
+using WindowedRunningStats = SlidingWindow<RunningStats<T>, Buckets, Time>;
+
+/// Windowed `OnlineCovariance` (covariance / correlation over the last `Buckets` buckets).
+template <std::size_t Buckets, typename T = double, class Time = std::int64_t>
+using WindowedCovariance = SlidingWindow<OnlineCovariance<T>, Buckets, Time>;
+
+} // namespace fastnum
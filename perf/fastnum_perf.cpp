@@ -0,0 +1,588 @@
+// fastnum_perf: end-to-end scaling harness.
+//
+// Sweeps thread counts and problem sizes over whole workloads (parallel fit,
+// keyed accumulation, multi-feature transform, cross-shard merge) and reports
+// throughput, scaling efficiency, peak RSS and optionally hardware counters,
+// next to the naive reference implementations used by the tests. Run
+// `fastnum_perf --help` for the options; `--csv` gives a machine-readable
+// table for tracking scaling limits across releases.
+
+#include "perf_harness.hpp"
+
+#include <fastnum/keyed_accumulator.hpp>
+#include <fastnum/multi_standard_scaler.hpp>
+#include <fastnum/packed_state.hpp>
+#include <fastnum/parallel.hpp>
+#include <fastnum/running_stats.hpp>
+#include <fastnum/detail/parallel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using Stats = fastnum::RunningStats<double>;
+
+std::vector<double> make_data(std::size_t n, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(10.0, 3.0);
+    std::vector<double> xs(n);
+    for (double& x : xs) x = dist(rng);
+    return xs;
+}
+
+template <class T>
+void release(std::vector<T>& v) {
+    std::vector<T>().swap(v);
+}
+
+// Relative difference, with an absolute floor for values near zero.
+double rel_err(double value, double ref) {
+    return std::abs(value - ref) / std::max(std::abs(ref), 1.0);
+}
+
+// --- Naive references (as in the tests) --------------------------------------
+
+double naive_mean(const double* xs, std::size_t n) {
+    return std::accumulate(xs, xs + n, 0.0) / static_cast<double>(n);
+}
+
+double naive_m2(const double* xs, std::size_t n) {
+    const double mu = naive_mean(xs, n);
+    double sum = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double d = xs[i] - mu;
+        sum += d * d;
+    }
+    return sum;
+}
+
+// --- Workloads ---------------------------------------------------------------
+
+class workload {
+public:
+    virtual ~workload() = default;
+    [[nodiscard]] virtual const char* name() const = 0;
+    [[nodiscard]] virtual const char* unit() const = 0;
+    // Build the inputs for problem size `n`; returns the items one run processes.
+    virtual std::size_t setup(std::size_t n) = 0;
+    virtual void run(std::size_t threads) = 0;
+    virtual void run_naive() = 0;
+    // Largest relative difference between the last run() and run_naive().
+    [[nodiscard]] virtual double error() const = 0;
+    virtual void teardown() = 0;
+};
+
+// parallel_observe of n samples into one RunningStats.
+class fit_workload final : public workload {
+public:
+    const char* name() const override { return "fit"; }
+    const char* unit() const override { return "samples"; }
+
+    std::size_t setup(std::size_t n) override {
+        xs_ = make_data(n, 1);
+        return n;
+    }
+
+    void run(std::size_t threads) override {
+        Stats s;
+        fastnum::parallel_observe(fastnum::parallel_policy{threads, std::size_t{1} << 14}, s, xs_);
+        result_ = s;
+    }
+
+    void run_naive() override {
+        mean_ = naive_mean(xs_.data(), xs_.size());
+        m2_ = naive_m2(xs_.data(), xs_.size());
+    }
+
+    double error() const override {
+        return std::max(rel_err(result_.mean(), mean_), rel_err(result_.m2(), m2_));
+    }
+
+    void teardown() override { release(xs_); }
+
+private:
+    std::vector<double> xs_;
+    Stats result_;
+    double mean_{0};
+    double m2_{0};
+};
+
+// Bulk per-key observe into one table per thread, then key-wise merge.
+class keyed_workload final : public workload {
+public:
+    const char* name() const override { return "keyed"; }
+    const char* unit() const override { return "samples"; }
+
+    std::size_t setup(std::size_t n) override {
+        xs_ = make_data(n, 2);
+        keys_.resize(n);
+        std::mt19937 rng(3);
+        std::uniform_int_distribution<std::uint32_t> key(0, distinct_keys - 1);
+        for (auto& k : keys_) k = key(rng);
+        return n;
+    }
+
+    void run(std::size_t threads) override {
+        const std::size_t n = xs_.size();
+        std::vector<table> parts(fastnum::detail::chunk_count(n, threads, min_chunk));
+        fastnum::detail::parallel_chunks(n, threads, min_chunk, [&](std::size_t b, std::size_t e, std::size_t c) {
+            parts[c].observe(keys_.data() + b, xs_.data() + b, e - b);
+        });
+        for (std::size_t c = 1; c < parts.size(); ++c) parts[0].merge(parts[c]);
+        result_ = std::move(parts[0]);
+    }
+
+    void run_naive() override {
+        std::unordered_map<std::uint32_t, std::vector<double>> groups;
+        for (std::size_t i = 0; i < xs_.size(); ++i) groups[keys_[i]].push_back(xs_[i]);
+        ref_.clear();
+        for (const auto& [k, v] : groups) ref_[k] = {naive_mean(v.data(), v.size()), naive_m2(v.data(), v.size())};
+    }
+
+    double error() const override {
+        if (result_.size() != ref_.size()) return HUGE_VAL;
+        double err = 0.0;
+        for (const auto& [k, moments] : ref_) {
+            const Stats* s = result_.find(k);
+            if (!s) return HUGE_VAL;
+            err = std::max({err, rel_err(s->mean(), moments[0]), rel_err(s->m2(), moments[1])});
+        }
+        return err;
+    }
+
+    void teardown() override {
+        release(xs_);
+        release(keys_);
+        result_.clear();
+        ref_ = {};
+    }
+
+private:
+    using table = fastnum::KeyedRunningStats<std::uint32_t>;
+    static constexpr std::uint32_t distinct_keys = 1u << 14;
+    static constexpr std::size_t min_chunk = std::size_t{1} << 15;
+
+    std::vector<double> xs_;
+    std::vector<std::uint32_t> keys_;
+    table result_;
+    std::unordered_map<std::uint32_t, std::array<double, 2>> ref_;
+};
+
+// MultiStandardScaler::transform_rows over n values (n / 64 rows of 64
+// features), rows split across threads.
+class transform_workload final : public workload {
+public:
+    const char* name() const override { return "transform"; }
+    const char* unit() const override { return "values"; }
+
+    std::size_t setup(std::size_t n) override {
+        rows_ = std::max<std::size_t>(n / features, 2);
+        in_ = make_data(rows_ * features, 4);
+        out_.assign(in_.size(), 0.0);
+        ref_.assign(in_.size(), 0.0);
+        scaler_ = fastnum::MultiStandardScaler<double>(features);
+        scaler_.observe_rows(in_.data(), rows_);
+
+        // Two-pass per-column statistics for the reference.
+        mean_.assign(features, 0.0);
+        std_.assign(features, 0.0);
+        std::vector<double> col(rows_);
+        for (std::size_t j = 0; j < features; ++j) {
+            for (std::size_t r = 0; r < rows_; ++r) col[r] = in_[r * features + j];
+            mean_[j] = naive_mean(col.data(), rows_);
+            std_[j] = std::sqrt(naive_m2(col.data(), rows_) / static_cast<double>(rows_));
+        }
+        return in_.size();
+    }
+
+    void run(std::size_t threads) override {
+        fastnum::detail::parallel_chunks(rows_, threads, min_rows, [&](std::size_t b, std::size_t e, std::size_t) {
+            scaler_.transform_rows(in_.data() + b * features, out_.data() + b * features, e - b);
+        });
+    }
+
+    void run_naive() override {
+        for (std::size_t r = 0; r < rows_; ++r) {
+            for (std::size_t j = 0; j < features; ++j) {
+                const std::size_t i = r * features + j;
+                ref_[i] = (in_[i] - mean_[j]) / std_[j];
+            }
+        }
+    }
+
+    double error() const override {
+        double err = 0.0;
+        for (std::size_t i = 0; i < out_.size(); ++i) err = std::max(err, rel_err(out_[i], ref_[i]));
+        return err;
+    }
+
+    void teardown() override {
+        release(in_);
+        release(out_);
+        release(ref_);
+        scaler_ = fastnum::MultiStandardScaler<double>(0);
+    }
+
+private:
+    static constexpr std::size_t features = 64;
+    static constexpr std::size_t min_rows = 1024;
+
+    std::size_t rows_{0};
+    std::vector<double> in_, out_, ref_, mean_, std_;
+    fastnum::MultiStandardScaler<double> scaler_{0};
+};
+
+// Reduce 8 shards of n / 8 per-feature states: packed_merge over tile ranges
+// split across threads, vs one merge() per feature and shard.
+class merge_workload final : public workload {
+public:
+    const char* name() const override { return "merge"; }
+    const char* unit() const override { return "states"; }
+
+    std::size_t setup(std::size_t n) override {
+        const std::size_t features = std::max<std::size_t>(n / shards, 1);
+        const auto xs = make_data(3 * features, 5);
+        objects_.assign(shards, std::vector<Stats>(features));
+        packed_.clear();
+        for (std::size_t s = 0; s < shards; ++s) {
+            for (std::size_t f = 0; f < features; ++f) {
+                // Shards see different amounts of data per feature; some none.
+                const std::size_t k = (f + s) % 4;
+                objects_[s][f].observe(xs.data() + 3 * f, k < 3 ? k + 1 : 0);
+            }
+            packed_.emplace_back(objects_[s].data(), features);
+        }
+        result_ = fastnum::packed_states<Stats>(features);
+        return features * shards;
+    }
+
+    void run(std::size_t threads) override {
+        fastnum::detail::parallel_chunks(result_.tile_count(), threads, min_tiles,
+            [&](std::size_t b, std::size_t e, std::size_t) {
+                // All shards per L1-sized block of the result.
+                for (std::size_t lo = b; lo < e; lo += block_tiles) {
+                    const std::size_t m = std::min(block_tiles, e - lo);
+                    std::copy(packed_[0].data() + lo, packed_[0].data() + lo + m, result_.data() + lo);
+                    for (std::size_t s = 1; s < shards; ++s) {
+                        fastnum::packed_merge<Stats>(packed_[s].data() + lo, result_.data() + lo, m);
+                    }
+                }
+            });
+    }
+
+    void run_naive() override {
+        ref_ = objects_[0];
+        for (std::size_t s = 1; s < shards; ++s) {
+            for (std::size_t f = 0; f < ref_.size(); ++f) ref_[f].merge(objects_[s][f]);
+        }
+    }
+
+    double error() const override {
+        double err = 0.0;
+        for (std::size_t f = 0; f < ref_.size(); ++f) {
+            const Stats s = result_[f];
+            if (s.count() != ref_[f].count()) return HUGE_VAL;
+            err = std::max({err, rel_err(s.mean(), ref_[f].mean()), rel_err(s.m2(), ref_[f].m2())});
+        }
+        return err;
+    }
+
+    void teardown() override {
+        objects_ = {};
+        packed_ = {};
+        release(ref_);
+        result_ = {};
+    }
+
+private:
+    static constexpr std::size_t shards = 8;
+    static constexpr std::size_t min_tiles = 256;
+    static constexpr std::size_t block_tiles = 32;
+
+    std::vector<std::vector<Stats>> objects_;
+    std::vector<fastnum::packed_states<Stats>> packed_;
+    fastnum::packed_states<Stats> result_;
+    std::vector<Stats> ref_;
+};
+
+std::unique_ptr<workload> make_workload(const std::string& name) {
+    if (name == "fit") return std::make_unique<fit_workload>();
+    if (name == "keyed") return std::make_unique<keyed_workload>();
+    if (name == "transform") return std::make_unique<transform_workload>();
+    if (name == "merge") return std::make_unique<merge_workload>();
+    return nullptr;
+}
+
+// --- Options -----------------------------------------------------------------
+
+struct options {
+    std::vector<std::string> workloads{"fit", "keyed", "transform", "merge"};
+    std::vector<std::size_t> sizes{std::size_t{1} << 16, std::size_t{1} << 20, std::size_t{1} << 22};
+    std::vector<std::size_t> threads;
+    std::size_t reps{5};
+    bool counters{false};
+    bool csv{false};
+    bool naive{true};
+};
+
+void usage(std::FILE* out) {
+    std::fputs(
+        "usage: fastnum_perf [options]\n"
+        "  --workloads LIST  comma-separated subset of fit,keyed,transform,merge (default: all)\n"
+        "  --sizes LIST      problem sizes, k/M/G suffixes allowed (default: 64k,1M,4M)\n"
+        "  --threads LIST    thread counts (default: 1,2,4,... up to the hardware threads)\n"
+        "  --reps N          timed repetitions per point; the median is reported (default: 5)\n"
+        "  --counters        report IPC and cache misses via perf_event (Linux)\n"
+        "  --no-naive        skip the naive reference runs and the accuracy check\n"
+        "  --csv             print CSV instead of a table\n",
+        out);
+}
+
+bool parse_size(const std::string& s, std::size_t& out) {
+    char* end = nullptr;
+    const unsigned long long v = std::strtoull(s.c_str(), &end, 10);
+    if (end == s.c_str()) return false;
+    std::size_t scale = 1;
+    if (*end == 'k' || *end == 'K') scale = std::size_t{1} << 10;
+    else if (*end == 'm' || *end == 'M') scale = std::size_t{1} << 20;
+    else if (*end == 'g' || *end == 'G') scale = std::size_t{1} << 30;
+    else if (*end != '\0') return false;
+    if (scale != 1 && end[1] != '\0') return false;
+    out = static_cast<std::size_t>(v) * scale;
+    return out > 0;
+}
+
+std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> parts;
+    std::size_t begin = 0;
+    while (begin <= s.size()) {
+        const std::size_t end = std::min(s.find(',', begin), s.size());
+        if (end > begin) parts.push_back(s.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return parts;
+}
+
+bool parse_sizes(const std::string& s, std::vector<std::size_t>& out) {
+    out.clear();
+    for (const auto& part : split(s)) {
+        std::size_t v = 0;
+        if (!parse_size(part, v)) return false;
+        out.push_back(v);
+    }
+    return !out.empty();
+}
+
+// Returns 0 on success, 1 to exit successfully (--help), 2 on bad usage.
+int parse_options(int argc, char** argv, options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") {
+            usage(stdout);
+            return 1;
+        } else if (arg == "--workloads" && has_value) {
+            opt.workloads = split(argv[++i]);
+            for (const auto& w : opt.workloads) {
+                if (!make_workload(w)) {
+                    std::fprintf(stderr, "fastnum_perf: unknown workload '%s'\n", w.c_str());
+                    return 2;
+                }
+            }
+        } else if (arg == "--sizes" && has_value) {
+            if (!parse_sizes(argv[++i], opt.sizes)) return 2;
+        } else if (arg == "--threads" && has_value) {
+            if (!parse_sizes(argv[++i], opt.threads)) return 2;
+        } else if (arg == "--reps" && has_value) {
+            if (!parse_size(argv[++i], opt.reps)) return 2;
+        } else if (arg == "--counters") {
+            opt.counters = true;
+        } else if (arg == "--no-naive") {
+            opt.naive = false;
+        } else if (arg == "--csv") {
+            opt.csv = true;
+        } else {
+            std::fprintf(stderr, "fastnum_perf: bad argument '%s'\n", arg.c_str());
+            return 2;
+        }
+    }
+    if (opt.threads.empty()) {
+        const std::size_t hw = fastnum::detail::resolve_threads(0);
+        for (std::size_t t = 1; t < hw; t *= 2) opt.threads.push_back(t);
+        opt.threads.push_back(hw);
+    }
+    std::sort(opt.threads.begin(), opt.threads.end());
+    opt.threads.erase(std::unique(opt.threads.begin(), opt.threads.end()), opt.threads.end());
+    return 0;
+}
+
+// --- Reporting ---------------------------------------------------------------
+
+struct point {
+    const char* workload;
+    const char* impl;
+    const char* unit;
+    std::size_t n;
+    std::size_t threads;
+    double seconds;
+    std::size_t items;
+    double speedup;    // vs the smallest thread count; NaN for the reference
+    double efficiency; // speedup per added thread
+    double vs_naive;   // naive time / this time; NaN without a reference run
+    double peak_rss_mib;
+    double error;      // NaN for the reference row or without a reference run
+    fastnum_perf::counter_sample counters;
+    std::size_t runs;  // timed + warm-up calls the counters cover
+};
+
+class reporter {
+public:
+    reporter(bool csv, bool counters) : csv_(csv), counters_(counters) {}
+
+    void header() const {
+        if (csv_) {
+            std::printf("workload,impl,unit,n,threads,time_ms,mitems_per_s,speedup,efficiency,vs_naive,"
+                        "peak_rss_mib,max_rel_err%s\n",
+                        counters_ ? ",ipc,cache_misses_per_kitem" : "");
+            return;
+        }
+        std::printf("%-10s %-8s %10s %7s %11s %10s %8s %6s %9s %9s %9s", "workload", "impl", "n", "threads",
+                    "time_ms", "Mitems/s", "speedup", "eff", "vs_naive", "rss_MiB", "max_err");
+        if (counters_) std::printf(" %6s %13s", "IPC", "miss/kitem");
+        std::printf("\n");
+    }
+
+    void row(const point& p) const {
+        const double ms = p.seconds * 1e3;
+        const double rate = static_cast<double>(p.items) / p.seconds / 1e6;
+        const bool counted = counters_ && p.counters.valid && p.counters.cycles > 0;
+        const double ipc = counted ? static_cast<double>(p.counters.instructions) / p.counters.cycles : NAN;
+        const double misses = counted ? static_cast<double>(p.counters.cache_misses) /
+                                            (static_cast<double>(p.items) * p.runs / 1e3)
+                                      : NAN;
+        if (csv_) {
+            std::printf("%s,%s,%s,%zu,%zu,%.4f,%.3f,%.3f,%.3f,%.3f,%.1f,%.3g", p.workload, p.impl, p.unit, p.n,
+                        p.threads, ms, rate, p.speedup, p.efficiency, p.vs_naive, p.peak_rss_mib, p.error);
+            if (counters_) std::printf(",%.3f,%.3f", ipc, misses);
+            std::printf("\n");
+            return;
+        }
+        std::printf("%-10s %-8s %10zu %7zu %11.3f %10.1f %8s %6s %9s %9.1f %9s", p.workload, p.impl, p.n,
+                    p.threads, ms, rate, fmt(p.speedup, "%.2fx").c_str(), fmt(p.efficiency, "%.2f").c_str(),
+                    fmt(p.vs_naive, "%.2fx").c_str(), p.peak_rss_mib, fmt(p.error, "%.1e").c_str());
+        if (counters_) std::printf(" %6s %13s", fmt(ipc, "%.2f").c_str(), fmt(misses, "%.2f").c_str());
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+private:
+    static std::string fmt(double v, const char* f) {
+        if (std::isnan(v)) return "-";
+        char buf[32];
+        std::snprintf(buf, sizeof buf, f, v);
+        return buf;
+    }
+
+    bool csv_;
+    bool counters_;
+};
+
+// Time `fn` (median of reps) with the peak-RSS window and counters around it.
+template <class Fn>
+point measure(const options& opt, fastnum_perf::hw_counters& hw, Fn&& fn) {
+    point p{};
+    fastnum_perf::reset_peak_rss();
+    if (hw.ok()) hw.start();
+    p.seconds = fastnum_perf::median_seconds(opt.reps, fn);
+    if (hw.ok()) p.counters = hw.stop();
+    p.runs = opt.reps + 1;
+    p.peak_rss_mib = static_cast<double>(fastnum_perf::peak_rss_bytes()) / (1024.0 * 1024.0);
+    return p;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    options opt;
+    if (const int rc = parse_options(argc, argv, opt); rc != 0) {
+        if (rc == 2) usage(stderr);
+        return rc == 1 ? 0 : rc;
+    }
+
+    fastnum_perf::hw_counters hw;
+    if (opt.counters && !hw.open()) {
+        std::fprintf(stderr, "fastnum_perf: perf_event counters unavailable; omitting them\n");
+        opt.counters = false;
+    }
+    const bool rss_window = fastnum_perf::reset_peak_rss();
+    if (!opt.csv) {
+        std::printf("# fastnum_perf: hardware threads %zu, SIMD lanes (double) %zu, peak RSS %s, reps %zu\n",
+                    fastnum::detail::resolve_threads(0), fastnum::detail::simd::batch<double>::width,
+                    rss_window ? "per measurement" : "process lifetime", opt.reps);
+    }
+
+    // Merged results must match the references to this; anything looser is
+    // a correctness regression, not noise.
+    constexpr double tolerance = 1e-9;
+    bool accurate = true;
+
+    const reporter out(opt.csv, opt.counters);
+    out.header();
+    for (const auto& name : opt.workloads) {
+        const auto w = make_workload(name);
+        for (const std::size_t n : opt.sizes) {
+            const std::size_t items = w->setup(n);
+            const auto base = [&](point p, const char* impl, std::size_t threads) {
+                p.workload = w->name();
+                p.impl = impl;
+                p.unit = w->unit();
+                p.n = n;
+                p.threads = threads;
+                p.items = items;
+                p.speedup = p.efficiency = p.vs_naive = p.error = NAN;
+                return p;
+            };
+
+            double naive_seconds = NAN;
+            if (opt.naive) {
+                point p = base(measure(opt, hw, [&] { w->run_naive(); }), "naive", 1);
+                naive_seconds = p.seconds;
+                p.vs_naive = 1.0;
+                out.row(p);
+            }
+
+            double first_seconds = NAN;
+            for (const std::size_t threads : opt.threads) {
+                point p = base(measure(opt, hw, [&] { w->run(threads); }), "fastnum", threads);
+                if (std::isnan(first_seconds)) first_seconds = p.seconds;
+                p.speedup = first_seconds / p.seconds;
+                p.efficiency = p.speedup * static_cast<double>(opt.threads.front()) / static_cast<double>(threads);
+                p.vs_naive = naive_seconds / p.seconds;
+                if (opt.naive) {
+                    p.error = w->error();
+                    if (!(p.error <= tolerance)) {
+                        accurate = false;
+                        std::fprintf(stderr, "fastnum_perf: %s n=%zu threads=%zu differs from the reference by %g\n",
+                                     w->name(), n, threads, p.error);
+                    }
+                }
+                out.row(p);
+            }
+            w->teardown();
+        }
+    }
+    return accurate ? 0 : 1;
+}
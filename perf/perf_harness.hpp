@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <sys/resource.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#  define FASTNUM_PERF_HAS_PERF_EVENT 1
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+// Measurement utilities for fastnum_perf: wall-clock timing, peak resident
+// set size and (on Linux) hardware counters via perf_event.
+namespace fastnum_perf {
+
+using perf_clock = std::chrono::steady_clock;
+
+// Median of `reps` timed calls of `fn`, in seconds, after one untimed warm-up.
+template <class Fn>
+double median_seconds(std::size_t reps, Fn&& fn) {
+    fn();
+    std::vector<double> t(reps);
+    for (double& s : t) {
+        const auto start = perf_clock::now();
+        fn();
+        s = std::chrono::duration<double>(perf_clock::now() - start).count();
+    }
+    std::nth_element(t.begin(), t.begin() + static_cast<std::ptrdiff_t>(reps / 2), t.end());
+    return t[reps / 2];
+}
+
+// Starts a new peak-RSS window where the kernel allows it (Linux clears
+// VmHWM on "5" > /proc/self/clear_refs). Returns false if peaks can only be
+// read as the process-lifetime maximum.
+inline bool reset_peak_rss() noexcept {
+#if defined(__linux__)
+    if (std::FILE* f = std::fopen("/proc/self/clear_refs", "w")) {
+        const bool ok = std::fputs("5", f) >= 0;
+        return std::fclose(f) == 0 && ok;
+    }
+#endif
+    return false;
+}
+
+// Peak resident set size in bytes since the last successful reset_peak_rss()
+// (otherwise since process start); 0 if unknown.
+inline std::uint64_t peak_rss_bytes() noexcept {
+#if defined(__linux__)
+    if (std::FILE* f = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        std::uint64_t kib = 0;
+        while (std::fgets(line, sizeof line, f)) {
+            if (std::strncmp(line, "VmHWM:", 6) == 0) {
+                kib = std::strtoull(line + 6, nullptr, 10);
+                break;
+            }
+        }
+        std::fclose(f);
+        if (kib) return kib * 1024;
+    }
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+    rusage ru{};
+    if (getrusage(RUSAGE_SELF, &ru) == 0) {
+#  if defined(__APPLE__)
+        return static_cast<std::uint64_t>(ru.ru_maxrss); // bytes
+#  else
+        return static_cast<std::uint64_t>(ru.ru_maxrss) * 1024; // KiB
+#  endif
+    }
+#endif
+    return 0;
+}
+
+struct counter_sample {
+    bool valid{false};
+    std::uint64_t cycles{0};
+    std::uint64_t instructions{0};
+    std::uint64_t cache_misses{0};
+};
+
+/**
+ * @brief Cycles, instructions and last-level cache misses of this process.
+ *
+ * User-space only and inherited by threads created while counting, so the
+ * worker threads of the parallel workloads are included once they have been
+ * joined. `open()` fails without `perf_event` support or permission
+ * (`/proc/sys/kernel/perf_event_paranoid`); the harness then omits the
+ * counter columns.
+ */
+class hw_counters {
+public:
+    hw_counters() = default;
+    hw_counters(const hw_counters&) = delete;
+    hw_counters& operator=(const hw_counters&) = delete;
+    ~hw_counters() { close(); }
+
+    bool open() noexcept {
+#if defined(FASTNUM_PERF_HAS_PERF_EVENT)
+        const std::uint64_t events[3] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                         PERF_COUNT_HW_CACHE_MISSES};
+        for (std::size_t i = 0; i < 3; ++i) {
+            perf_event_attr attr{};
+            attr.size = sizeof attr;
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = events[i];
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fd_[i] < 0) {
+                close();
+                return false;
+            }
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    [[nodiscard]] bool ok() const noexcept { return fd_[0] >= 0; }
+
+    void start() noexcept {
+#if defined(FASTNUM_PERF_HAS_PERF_EVENT)
+        for (int fd : fd_) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    [[nodiscard]] counter_sample stop() noexcept {
+        counter_sample s;
+#if defined(FASTNUM_PERF_HAS_PERF_EVENT)
+        if (!ok()) return s;
+        std::uint64_t v[3] = {0, 0, 0};
+        s.valid = true;
+        for (std::size_t i = 0; i < 3; ++i) {
+            ioctl(fd_[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_[i], &v[i], sizeof v[i]) != static_cast<ssize_t>(sizeof v[i])) s.valid = false;
+        }
+        s.cycles = v[0];
+        s.instructions = v[1];
+        s.cache_misses = v[2];
+#endif
+        return s;
+    }
+
+private:
+    void close() noexcept {
+#if defined(FASTNUM_PERF_HAS_PERF_EVENT)
+        for (int& fd : fd_) {
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+        }
+#endif
+    }
+
+    int fd_[3] = {-1, -1, -1};
+};
+
+} // namespace fastnum_perf
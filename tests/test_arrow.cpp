@@ -0,0 +1,147 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/arrow.hpp>
+#include <fastnum/exponential_stats.hpp>
+#include <fastnum/online_covariance.hpp>
+#include <fastnum/running_stats.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+// A nullable float64 column: values under nulls are NaN garbage.
+struct nullable_column {
+    std::vector<double> values;
+    std::vector<std::uint8_t> bits;
+
+    bool valid(std::size_t i) const { return (bits[i / 8] >> (i % 8)) & 1; }
+};
+
+// Long clean stretches, then a stretch of dense nulls, then a sparse tail.
+nullable_column make_column(std::size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(20.0, 4.0);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    nullable_column c{std::vector<double>(n), std::vector<std::uint8_t>((n + 7) / 8, 0)};
+    for (std::size_t i = 0; i < n; ++i) {
+        const double p_null = i < n / 3 ? 0.001 : i < 2 * n / 3 ? 0.6 : 0.02;
+        const bool valid = u(rng) >= p_null;
+        c.values[i] = valid ? dist(rng) : std::numeric_limits<double>::quiet_NaN();
+        if (valid) c.bits[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+    }
+    return c;
+}
+
+void no_release(ArrowArray*) {}
+void no_release(ArrowSchema*) {}
+
+} // namespace
+
+TEST_CASE("observe_arrow drops nulls in place", "[arrow]") {
+    const auto c = make_column(20000, 701);
+    // Odd offsets exercise unaligned bitmap words.
+    for (std::size_t offset : {std::size_t{0}, std::size_t{5}, std::size_t{67}}) {
+        const std::size_t len = c.values.size() - offset - 3;
+        fastnum::RunningStats<double> ref;
+        fastnum::ExponentialStats<double> ref_ew(0.01);
+        for (std::size_t i = offset; i < offset + len; ++i) {
+            if (!c.valid(i)) continue;
+            ref.observe(c.values[i]);
+            ref_ew.observe(c.values[i]);
+        }
+
+        const fastnum::arrow_column<double> col{c.values.data(), c.bits.data(), offset, len};
+        fastnum::RunningStats<double> stats;
+        fastnum::ExponentialStats<double> ew(0.01);
+        fastnum::observe_arrow(stats, col);
+        fastnum::observe_arrow(ew, col);
+        REQUIRE(stats.count() == ref.count());
+        REQUIRE(stats.mean() == Catch::Approx(ref.mean()).epsilon(1e-12));
+        REQUIRE(stats.variance_sample() == Catch::Approx(ref.variance_sample()).epsilon(1e-10));
+        // Order-sensitive: valid values arrive in input order.
+        REQUIRE(ew.mean() == Catch::Approx(ref_ew.mean()).epsilon(1e-12));
+    }
+
+    // No bitmap: plain batch observe.
+    const std::vector<double> xs = {1.0, 2.0, 3.0, 4.0};
+    fastnum::RunningStats<double> plain;
+    fastnum::observe_arrow(plain, fastnum::arrow_column<double>{xs.data(), nullptr, 1, 3});
+    REQUIRE(plain.count() == 3);
+    REQUIRE(plain.mean() == 3.0);
+}
+
+TEST_CASE("observe_arrow pairs need both sides valid", "[arrow]") {
+    const auto x = make_column(9000, 702);
+    auto y = make_column(9001, 703);
+    for (std::size_t i = 0; i < 9000; ++i) y.values[i + 1] += 0.5 * (std::isnan(x.values[i]) ? 0.0 : x.values[i]);
+
+    const fastnum::arrow_column<double> cx{x.values.data(), x.bits.data(), 0, 9000};
+    const fastnum::arrow_column<double> cy{y.values.data(), y.bits.data(), 1, 9000};
+    fastnum::OnlineCovariance<double> ref;
+    for (std::size_t i = 0; i < 9000; ++i) {
+        if (x.valid(i) && y.valid(i + 1)) ref.observe(x.values[i], y.values[i + 1]);
+    }
+
+    fastnum::OnlineCovariance<double> cov;
+    REQUIRE(fastnum::observe_arrow(cov, cx, cy) == fastnum::arrow_error::none);
+    REQUIRE(cov.count() == ref.count());
+    REQUIRE(cov.covariance_sample() == Catch::Approx(ref.covariance_sample()).epsilon(1e-10));
+    REQUIRE(cov.correlation() == Catch::Approx(ref.correlation()).epsilon(1e-10));
+
+    const fastnum::arrow_column<double> same_y{y.values.data(), nullptr, 0, 9000};
+    fastnum::OnlineCovariance<double> one_sided;
+    REQUIRE(fastnum::observe_arrow(one_sided, cx, same_y) == fastnum::arrow_error::none);
+    std::size_t valid_x = 0;
+    for (std::size_t i = 0; i < 9000; ++i) valid_x += x.valid(i);
+    REQUIRE(one_sided.count() == valid_x);
+    REQUIRE(fastnum::observe_arrow(one_sided, cx, fastnum::arrow_column<double>{y.values.data(), nullptr, 0, 10}) ==
+            fastnum::arrow_error::length_mismatch);
+}
+
+TEST_CASE("observe_arrow imports C data interface arrays", "[arrow]") {
+    // [1, null, 3, 4, null, 6] sliced at offset 1: [null, 3, 4, null, 6].
+    const double values[6] = {1.0, -1.0, 3.0, 4.0, -1.0, 6.0};
+    const std::uint8_t bits[1] = {0b101101};
+    const void* buffers[2] = {bits, values};
+    ArrowArray array{5, 2, 1, 2, 0, buffers, nullptr, nullptr, &no_release, nullptr};
+    ArrowSchema schema{"g", "x", nullptr, ARROW_FLAG_NULLABLE, 0, nullptr, nullptr, &no_release, nullptr};
+
+    fastnum::RunningStats<double> stats;
+    REQUIRE(fastnum::observe_arrow(stats, schema, array) == fastnum::arrow_error::none);
+    REQUIRE(stats.count() == 3);
+    REQUIRE(stats.mean() == Catch::Approx(13.0 / 3.0));
+
+    fastnum::RunningStats<float> wrong_type;
+    REQUIRE(fastnum::observe_arrow(wrong_type, schema, array) == fastnum::arrow_error::type_mismatch);
+
+    // A record batch {x: float64, y: float64} of length 4 at offset 1.
+    const double ys[6] = {0.0, 9.0, 2.0, 8.0, 7.0, 12.0};
+    const void* y_buffers[2] = {nullptr, ys};
+    ArrowArray y_array{6, 0, 0, 2, 0, y_buffers, nullptr, nullptr, &no_release, nullptr};
+    ArrowArray x_array = array;
+    x_array.length = 6;
+    x_array.offset = 0;
+    ArrowArray* children[2] = {&x_array, &y_array};
+    ArrowSchema y_schema = schema;
+    ArrowSchema* child_schemas[2] = {&schema, &y_schema};
+    ArrowArray batch{4, 0, 1, 1, 2, buffers, children, nullptr, &no_release, nullptr};
+    ArrowSchema batch_schema{"+s", "", nullptr, 0, 2, child_schemas, nullptr, &no_release, nullptr};
+
+    // Rows 1..4: x = [null, 3, 4, null], y = [9, 2, 8, 7] -> pairs (3, 2), (4, 8).
+    fastnum::OnlineCovariance<double> cov;
+    REQUIRE(fastnum::observe_arrow(cov, batch_schema, batch, 0, 1) == fastnum::arrow_error::none);
+    REQUIRE(cov.count() == 2);
+    REQUIRE(cov.mean_x() == 3.5);
+    REQUIRE(cov.mean_y() == 5.0);
+    REQUIRE(fastnum::observe_arrow(cov, batch_schema, batch, 0, 2) == fastnum::arrow_error::bad_layout);
+
+    array.release = nullptr;
+    REQUIRE(fastnum::observe_arrow(stats, schema, array) == fastnum::arrow_error::released);
+    REQUIRE(stats.count() == 3);
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/buffered.hpp>
+#include <fastnum/exponential_stats.hpp>
+#include <fastnum/online_standard_scaler.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("BufferedRunningStats matches scalar observes", "[buffered]") {
+    std::mt19937 rng(401);
+    std::normal_distribution<double> dist(1e3, 5.0);
+
+    fastnum::BufferedRunningStats<double, 64> buffered;
+    fastnum::RunningStats<double> ref;
+    for (int i = 0; i < 1000; ++i) {
+        const double x = dist(rng);
+        buffered.observe(x);
+        ref.observe(x);
+        if (i == 500) {
+            // Queries flush whatever is pending.
+            REQUIRE(buffered.pending() == 501 % 64);
+            REQUIRE(buffered.count() == ref.count());
+            REQUIRE(buffered.pending() == 0);
+        }
+    }
+    REQUIRE(buffered.pending() == (1000 - 501) % 64);
+    REQUIRE(buffered.mean() == Catch::Approx(ref.mean()).epsilon(1e-12));
+    REQUIRE(buffered.variance_sample() == Catch::Approx(ref.variance_sample()).epsilon(1e-10));
+    REQUIRE(buffered->stddev_sample() == Catch::Approx(ref.stddev_sample()).epsilon(1e-10));
+    REQUIRE(buffered.get().count() == 1000);
+}
+
+TEST_CASE("Buffered forwards batches and non-buffered observes in order", "[buffered]") {
+    fastnum::Buffered<fastnum::ExponentialStats<double>, 8> buffered(fastnum::ExponentialStats<double>(0.1));
+    fastnum::ExponentialStats<double> ref(0.1);
+
+    const std::vector<double> xs = {4.0, 5.0, 6.0};
+    buffered.observe(1.0);
+    buffered.observe(2.0f); // converted, still buffered
+    REQUIRE(buffered.pending() == 2);
+    buffered.observe(xs);   // order-sensitive accumulator: flush comes first
+    buffered.observe(xs.data(), xs.size());
+    REQUIRE(buffered.pending() == 0);
+    buffered.observe(7.0);
+
+    ref.observe(1.0);
+    ref.observe(2.0);
+    for (int r = 0; r < 2; ++r) ref.observe(xs);
+    ref.observe(7.0);
+    REQUIRE(buffered.mean() == Catch::Approx(ref.mean()).epsilon(1e-12));
+    REQUIRE(buffered->weight() == Catch::Approx(ref.weight()).epsilon(1e-12));
+
+    fastnum::BufferedRunningStats<double, 4> weighted;
+    weighted.observe(1.0);
+    weighted.observe(3.0, 3.0); // observe(x, count): flush, then forward
+    REQUIRE(weighted.count() == 4);
+    REQUIRE(weighted.mean() == Catch::Approx(2.5));
+}
+
+TEST_CASE("BufferedCovariance buffers interleaved pairs", "[buffered]") {
+    std::mt19937 rng(402);
+    std::normal_distribution<double> dist(0.0, 1.0);
+
+    fastnum::BufferedCovariance<double, 32> buffered;
+    fastnum::OnlineCovariance<double> ref;
+    for (int i = 0; i < 777; ++i) {
+        const double x = dist(rng);
+        const double y = x - 0.25 * dist(rng);
+        buffered.observe(x, y);
+        ref.observe(x, y);
+    }
+    REQUIRE(buffered.pending() == 777 % 32);
+    REQUIRE(buffered.count() == ref.count());
+    REQUIRE(buffered->covariance_sample() == Catch::Approx(ref.covariance_sample()).epsilon(1e-10));
+    REQUIRE(buffered->correlation() == Catch::Approx(ref.correlation()).epsilon(1e-10));
+
+    fastnum::BufferedCovariance<double, 32> other;
+    other.observe(1.0, 2.0);
+    other.observe(2.0, 4.0);
+    buffered.merge(other);
+    REQUIRE(buffered.count() == ref.count() + 2);
+    REQUIRE(other.pending() == 0);
+
+    buffered.reset();
+    REQUIRE(buffered.count() == 0);
+}
+
+TEST_CASE("Buffered scaler flushes before transform", "[buffered]") {
+    fastnum::Buffered<fastnum::OnlineStandardScaler<double>, 16> scaler;
+    STATIC_REQUIRE(std::is_same_v<decltype(scaler)::value_type, double>);
+    REQUIRE(!scaler.ready());
+    for (double x : {1.0, 2.0, 3.0, 4.0}) scaler.observe(x);
+    REQUIRE(scaler.pending() == 4);
+    REQUIRE(scaler.ready());
+    REQUIRE(scaler.transform(2.5) == Catch::Approx(0.0).margin(1e-12));
+    REQUIRE(scaler.transform(2.5 + std::sqrt(1.25)) == Catch::Approx(1.0));
+}
@@ -0,0 +1,181 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/column_file.hpp>
+#include <fastnum/exponential_stats.hpp>
+#include <fastnum/histogram.hpp>
+#include <fastnum/online_covariance.hpp>
+#include <fastnum/online_standard_scaler.hpp>
+#include <fastnum/running_stats.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct temp_path {
+    std::string path;
+    explicit temp_path(const char* name)
+        : path((std::filesystem::temp_directory_path() / name).string()) {}
+    ~temp_path() { std::remove(path.c_str()); }
+};
+
+template <typename T>
+std::vector<T> make_column(std::size_t n, double mean, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(mean, 2.0);
+    std::vector<T> xs(n);
+    for (T& x : xs) x = static_cast<T>(dist(rng));
+    return xs;
+}
+
+} // namespace
+
+TEST_CASE("column_file streams columns into batch observe", "[column_file]") {
+    const temp_path tmp("fastnum_test_columns.fncf");
+    // Odd row count: column 1 starts mid-page, chunks end mid-page.
+    const std::size_t n = 100003;
+    const auto a = make_column<double>(n, 1e3, 601);
+    auto b = make_column<double>(n, -5.0, 602);
+    for (std::size_t i = 0; i < n; ++i) b[i] += 0.5 * a[i];
+    const double* cols[2] = {a.data(), b.data()};
+    REQUIRE(fastnum::write_column_file(tmp.path.c_str(), cols, 2, n) == fastnum::column_error::none);
+
+    const fastnum::column_file<double> f(tmp.path.c_str());
+    REQUIRE(f.ok());
+    REQUIRE(f.columns() == 2);
+    REQUIRE(f.rows() == n);
+    REQUIRE(f.column(1)[7] == b[7]);
+
+    fastnum::RunningStats<double> ref;
+    ref.observe(b.data(), n);
+    fastnum::OnlineCovariance<double> ref_cov;
+    ref_cov.observe(a.data(), b.data(), n);
+
+    fastnum::column_stream_options opt;
+    opt.chunk_bytes = 3000; // rounds up to one page
+    for (std::size_t threads : {std::size_t{1}, std::size_t{3}}) {
+        opt.threads = threads;
+        opt.min_chunk = 1000;
+
+        fastnum::RunningStats<double> stats;
+        fastnum::observe_column(stats, f, 1, opt);
+        REQUIRE(stats.count() == n);
+        REQUIRE(stats.mean() == Catch::Approx(ref.mean()).epsilon(1e-12));
+        REQUIRE(stats.variance_sample() == Catch::Approx(ref.variance_sample()).epsilon(1e-10));
+
+        fastnum::OnlineCovariance<double> cov;
+        fastnum::observe_columns(cov, f, 0, 1, opt);
+        REQUIRE(cov.count() == n);
+        REQUIRE(cov.covariance_sample() == Catch::Approx(ref_cov.covariance_sample()).epsilon(1e-10));
+        REQUIRE(cov.correlation() == Catch::Approx(ref_cov.correlation()).epsilon(1e-10));
+    }
+
+    // Dropped pages are re-read from the file on the next pass.
+    fastnum::OnlineStandardScaler<double> scaler;
+    scaler.observe(a.data(), 10);
+    fastnum::observe_column(scaler, f, 0);
+    fastnum::observe_column(scaler, f, 0);
+    REQUIRE(scaler.count() == 2 * n + 10);
+    fastnum::observe_column(scaler, f, 2); // no such column
+    REQUIRE(scaler.count() == 2 * n + 10);
+}
+
+TEST_CASE("column_file threaded fits keep the configuration of acc", "[column_file]") {
+    const temp_path tmp("fastnum_test_columns_config.fncf");
+    const std::size_t n = 50001;
+    const auto a = make_column<double>(n, 0.0, 603);
+    const double* cols[1] = {a.data()};
+    REQUIRE(fastnum::write_column_file(tmp.path.c_str(), cols, 1, n) == fastnum::column_error::none);
+    const fastnum::column_file<double> f(tmp.path.c_str());
+    REQUIRE(f.ok());
+
+    fastnum::column_stream_options opt;
+    opt.threads = 4;
+    opt.min_chunk = 1000;
+
+    // Per-thread histograms take acc's range (Histogram has no default one).
+    fastnum::Histogram<double, 16> ref(-4.0, 4.0), hist(-4.0, 4.0);
+    ref.observe(a.data(), n);
+    fastnum::observe_column(hist, f, 0, opt);
+    for (std::size_t i = 0; i < 16; ++i) REQUIRE(hist.bin_count(i) == ref.bin_count(i));
+
+    // Decayed state is order-sensitive: streamed serially, same as one batch.
+    fastnum::ExponentialStats<double> ewm_ref(0.01), ewm(0.01);
+    ewm_ref.observe(a.data(), n);
+    fastnum::observe_column(ewm, f, 0, opt);
+    REQUIRE(ewm.mean() == Catch::Approx(ewm_ref.mean()).epsilon(1e-12).margin(1e-12));
+    REQUIRE(ewm.variance_population() == Catch::Approx(ewm_ref.variance_population()).epsilon(1e-10));
+}
+
+TEST_CASE("column_file reads raw headerless columns", "[column_file]") {
+    const temp_path tmp("fastnum_test_raw.f32");
+    const auto xs = make_column<float>(5000, 3.0, 603);
+    std::FILE* out = std::fopen(tmp.path.c_str(), "wb");
+    REQUIRE(out);
+    REQUIRE(std::fwrite(xs.data(), sizeof(float), xs.size(), out) == xs.size());
+    std::fclose(out);
+
+    const fastnum::column_file<float> f(tmp.path.c_str(), fastnum::column_format::raw);
+    REQUIRE(f.ok());
+    REQUIRE(f.columns() == 1);
+    REQUIRE(f.rows() == xs.size());
+
+    fastnum::RunningStats<float> stats, ref;
+    ref.observe(xs.data(), xs.size());
+    fastnum::observe_column(stats, f, 0);
+    REQUIRE(stats.count() == xs.size());
+    REQUIRE(stats.mean() == Catch::Approx(ref.mean()).epsilon(1e-6));
+
+    // The same bytes are 2500 doubles; the reader trusts the caller's T.
+    const fastnum::column_file<double> wide(tmp.path.c_str(), fastnum::column_format::raw);
+    REQUIRE(wide.ok());
+    REQUIRE(wide.rows() == 2500);
+}
+
+TEST_CASE("column_file rejects malformed files", "[column_file]") {
+    using fastnum::column_error;
+    using fastnum::column_format;
+    REQUIRE(fastnum::column_file<double>("/nonexistent/fastnum.fncf").error() == column_error::open_failed);
+
+    const temp_path tmp("fastnum_test_bad.fncf");
+    const std::vector<double> xs = {1.0, 2.0, 3.0};
+    const double* cols[1] = {xs.data()};
+    REQUIRE(fastnum::write_column_file(tmp.path.c_str(), cols, 1, xs.size()) == column_error::none);
+    REQUIRE(fastnum::column_file<float>(tmp.path.c_str()).error() == column_error::type_mismatch);
+    {
+        const fastnum::column_file<double> f(tmp.path.c_str());
+        REQUIRE(f.ok());
+        fastnum::RunningStats<double> stats;
+        fastnum::observe_column(stats, f, 0);
+        REQUIRE(stats.mean() == 2.0);
+    }
+
+    // Announce more rows than the file holds.
+    std::FILE* io = std::fopen(tmp.path.c_str(), "r+b");
+    REQUIRE(io);
+    fastnum::column_file_header h{};
+    REQUIRE(std::fread(&h, sizeof h, 1, io) == 1);
+    h.rows = 4;
+    std::fseek(io, 0, SEEK_SET);
+    std::fwrite(&h, sizeof h, 1, io);
+    std::fclose(io);
+    REQUIRE(fastnum::column_file<double>(tmp.path.c_str()).error() == column_error::truncated);
+
+    // A raw file with a partial trailing value.
+    io = std::fopen(tmp.path.c_str(), "wb");
+    REQUIRE(io);
+    std::fwrite("0123456789", 1, 10, io);
+    std::fclose(io);
+    REQUIRE(fastnum::column_file<double>(tmp.path.c_str(), column_format::raw).error() == column_error::truncated);
+    REQUIRE(fastnum::column_file<double>(tmp.path.c_str()).error() == column_error::truncated);
+    io = std::fopen(tmp.path.c_str(), "ab");
+    REQUIRE(io);
+    std::fwrite("0123456789012345678901234567890123456789", 1, 40, io);
+    std::fclose(io);
+    REQUIRE(fastnum::column_file<double>(tmp.path.c_str()).error() == column_error::bad_magic);
+}
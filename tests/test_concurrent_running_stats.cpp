@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/concurrent_running_stats.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ConcurrentRunningStats merges writer shards", "[concurrent]") {
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kPerThread = 20000;
+
+    fastnum::ConcurrentRunningStats<double> stats(kThreads);
+    REQUIRE(stats.shards() == kThreads);
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&stats, t] {
+            auto w = stats.make_writer();
+            for (std::size_t i = 0; i < kPerThread; ++i) {
+                w.observe(static_cast<double>(t * kPerThread + i));
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    fastnum::RunningStats<double> ref;
+    for (std::size_t i = 0; i < kThreads * kPerThread; ++i) ref.observe(static_cast<double>(i));
+
+    const auto snap = stats.snapshot();
+    REQUIRE(snap.count() == ref.count());
+    REQUIRE(snap.mean() == Catch::Approx(ref.mean()).epsilon(1e-12));
+    REQUIRE(snap.variance_sample() == Catch::Approx(ref.variance_sample()).epsilon(1e-10));
+}
+
+TEST_CASE("ConcurrentRunningStats snapshots are consistent while writers run", "[concurrent]") {
+    constexpr std::size_t kThreads = 3;
+    fastnum::ConcurrentRunningStats<double> stats(kThreads);
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> writers;
+    for (std::size_t t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&] {
+            auto w = stats.make_writer();
+            const double batch[4] = {1.0, 1.0, 1.0, 1.0};
+            while (!stop.load(std::memory_order_relaxed)) w.observe(batch, 4);
+        });
+    }
+
+    std::size_t last = 0;
+    for (int i = 0; i < 2000; ++i) {
+        const auto snap = stats.snapshot();
+        // Every published state is a whole number of batches of ones.
+        REQUIRE(snap.count() % 4 == 0);
+        REQUIRE(snap.count() >= last);
+        if (snap.count() > 0) {
+            REQUIRE(snap.mean() == 1.0);
+            REQUIRE(snap.variance_population() == 0.0);
+        }
+        last = snap.count();
+    }
+    stop = true;
+    for (auto& th : writers) th.join();
+}
+
+TEST_CASE("ConcurrentRunningStats shard ownership and persistence", "[concurrent]") {
+    fastnum::ConcurrentRunningStats<double> stats(1);
+    {
+        auto w = stats.make_writer();
+        REQUIRE_FALSE(stats.try_make_writer().has_value());
+        w.observe(1.0);
+        w.observe(3.0);
+        REQUIRE(w.local().count() == 2);
+    }
+    {
+        auto w = stats.try_make_writer();
+        REQUIRE(w.has_value());
+        w->observe(5.0);
+        REQUIRE(w->local().count() == 3);
+    }
+    REQUIRE(stats.snapshot().mean() == Catch::Approx(3.0));
+
+    stats.reset();
+    REQUIRE(stats.snapshot().count() == 0);
+}
+
+TEST_CASE("ConcurrentCovariance accepts paired and batch updates", "[concurrent][covariance]") {
+    fastnum::ConcurrentCovariance<double> cov(2);
+    const std::vector<double> xs{1.0, 2.0, 3.0, 4.0};
+    const std::vector<double> ys{2.0, 4.0, 6.0, 8.0};
+
+    std::thread a([&] { auto w = cov.make_writer(); w.observe(xs.data(), ys.data(), 2); });
+    std::thread b([&] { auto w = cov.make_writer(); w.observe(xs[2], ys[2]); w.observe(xs[3], ys[3]); });
+    a.join();
+    b.join();
+
+    const auto snap = cov.snapshot();
+    REQUIRE(snap.count() == 4);
+    REQUIRE(snap.correlation() == Catch::Approx(1.0));
+}
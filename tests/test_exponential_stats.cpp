@@ -0,0 +1,143 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/exponential_stats.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// --- Naive reference: explicit weights d^(n-1-i) ---
+
+struct NaiveEwm {
+    double mean;
+    double var_pop;
+};
+
+static NaiveEwm naive_ewm(const std::vector<double>& xs, double d) {
+    const std::size_t n = xs.size();
+    double w = 0.0, wx = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double wi = std::pow(d, static_cast<double>(n - 1 - i));
+        w += wi;
+        wx += wi * xs[i];
+    }
+    const double mean = wx / w;
+    double s = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double wi = std::pow(d, static_cast<double>(n - 1 - i));
+        s += wi * (xs[i] - mean) * (xs[i] - mean);
+    }
+    return {mean, s / w};
+}
+
+TEST_CASE("ExponentialStats matches explicitly weighted reference", "[ewm]") {
+    std::mt19937 rng(71);
+    std::normal_distribution<double> dist(2.0, 3.0);
+
+    for (double alpha : {0.01, 0.1, 0.5}) {
+        std::vector<double> xs(500);
+        for (double& x : xs) x = dist(rng);
+
+        fastnum::ExponentialStats<double> ew(alpha);
+        for (double x : xs) ew.observe(x);
+
+        const auto ref = naive_ewm(xs, 1.0 - alpha);
+        REQUIRE(ew.count() == xs.size());
+        REQUIRE(ew.mean() == Catch::Approx(ref.mean).epsilon(1e-10));
+        REQUIRE(ew.variance_population() == Catch::Approx(ref.var_pop).epsilon(1e-10));
+    }
+}
+
+TEST_CASE("ExponentialStats batch observe equals scalar observe", "[ewm][batch]") {
+    std::mt19937 rng(72);
+    std::normal_distribution<double> dist(-1.0, 2.0);
+
+    for (std::size_t n : {1u, 3u, 17u, 1024u, 1025u, 5000u}) {
+        std::vector<double> head(13), xs(n);
+        for (double& x : head) x = dist(rng);
+        for (double& x : xs) x = dist(rng);
+
+        auto stream = fastnum::ExponentialStats<double>::from_half_life(200.0);
+        auto batch = stream;
+        for (double x : head) {
+            stream.observe(x);
+            batch.observe(x);
+        }
+        for (double x : xs) stream.observe(x);
+        batch.observe(xs);
+
+        REQUIRE(batch.count() == stream.count());
+        REQUIRE(batch.weight() == Catch::Approx(stream.weight()).epsilon(1e-12));
+        REQUIRE(batch.effective_count() == Catch::Approx(stream.effective_count()).epsilon(1e-10));
+        REQUIRE(batch.mean() == Catch::Approx(stream.mean()).epsilon(1e-10));
+        REQUIRE(batch.variance_population() == Catch::Approx(stream.variance_population()).epsilon(1e-9));
+    }
+}
+
+TEST_CASE("ExponentialStats tracks a level shift", "[ewm]") {
+    auto ew = fastnum::ExponentialStats<double>::from_half_life(10.0);
+    for (int i = 0; i < 1000; ++i) ew.observe(0.0);
+    for (int i = 0; i < 200; ++i) ew.observe(100.0);
+    REQUIRE(ew.mean() == Catch::Approx(100.0).epsilon(1e-4));
+
+    // Half-life: after 10 further samples the old level holds half the weight.
+    auto h = fastnum::ExponentialStats<double>::from_half_life(10.0);
+    for (int i = 0; i < 100000; ++i) h.observe(0.0);
+    for (int i = 0; i < 10; ++i) h.observe(1.0);
+    REQUIRE(h.mean() == Catch::Approx(0.5).epsilon(1e-3));
+}
+
+TEST_CASE("ExponentialStats time-based decay", "[ewm]") {
+    auto ew = fastnum::ExponentialStats<double>::from_time_half_life(5.0);
+    ew.observe_at(10.0, 0.0);
+    ew.observe_at(20.0, 5.0); // first sample now weighs 0.5
+    REQUIRE(ew.weight() == Catch::Approx(1.5));
+    REQUIRE(ew.mean() == Catch::Approx((0.5 * 10.0 + 20.0) / 1.5));
+
+    // Same timestamp: no additional decay.
+    ew.observe_at(20.0, 5.0);
+    REQUIRE(ew.weight() == Catch::Approx(2.5));
+
+    const double xs[] = {1.0, 2.0};
+    const double ts[] = {15.0, 15.0};
+    ew.observe_at(xs, ts, 2);
+    REQUIRE(ew.weight() == Catch::Approx(2.5 * 0.25 + 2.0));
+}
+
+TEST_CASE("ExponentialStats merge and readiness", "[ewm][merge]") {
+    fastnum::ExponentialStats<double> a(0.2), b(0.2);
+    REQUIRE(std::isnan(a.variance_population()));
+    a.observe(1.0);
+    REQUIRE(std::isnan(a.variance_sample()));
+    a.observe(3.0);
+    b.observe(5.0);
+    b.observe(7.0);
+
+    fastnum::ExponentialStats<double> m = a;
+    m.merge(b);
+    REQUIRE(m.count() == 4);
+    REQUIRE(m.weight() == Catch::Approx(a.weight() + b.weight()));
+    REQUIRE(m.mean() == Catch::Approx((a.weight() * a.mean() + b.weight() * b.mean()) / m.weight()));
+
+    m.reset();
+    REQUIRE(m.count() == 0);
+    REQUIRE(m.decay_factor() == Catch::Approx(0.8));
+}
+
+TEST_CASE("ExponentialStandardScaler standardizes with decayed stats", "[ewm][scaler]") {
+    fastnum::ExponentialStandardScaler<double> scaler(fastnum::ExponentialStats<double>(0.05));
+    REQUIRE_FALSE(scaler.ready());
+
+    std::mt19937 rng(73);
+    std::normal_distribution<double> dist(50.0, 2.0);
+    std::vector<double> xs(2000);
+    for (double& x : xs) x = dist(rng);
+    scaler.observe(xs);
+
+    REQUIRE(scaler.ready());
+    const auto& st = scaler.stats();
+    REQUIRE(scaler.transform(st.mean()) == Catch::Approx(0.0).margin(1e-12));
+    REQUIRE(scaler.freeze().transform(st.mean() + st.stddev_population()) == Catch::Approx(1.0));
+}
@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/histogram.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+// --- Naive reference: floor + bounds checks ---
+
+struct NaiveHistogram {
+    std::vector<std::uint64_t> bins;
+    std::uint64_t under = 0, over = 0, nan = 0;
+};
+
+static NaiveHistogram naive_linear(const std::vector<double>& xs, double lo, double hi, std::size_t nbins) {
+    NaiveHistogram h{std::vector<std::uint64_t>(nbins)};
+    for (double x : xs) {
+        if (std::isnan(x)) ++h.nan;
+        else if (x < lo) ++h.under;
+        else if (x >= hi) ++h.over;
+        else ++h.bins[std::min(nbins - 1, static_cast<std::size_t>(std::floor((x - lo) / (hi - lo) * nbins)))];
+    }
+    return h;
+}
+
+static std::vector<double> normal_data(std::size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(0.0, 3.0);
+    std::vector<double> xs(n);
+    for (double& x : xs) x = dist(rng);
+    return xs;
+}
+
+TEST_CASE("Histogram linear bins match floor-based binning", "[histogram]") {
+    // Power-of-two range: bin edges are exact, so the reference agrees everywhere.
+    auto xs = normal_data(20003, 601);
+    xs[5] = std::numeric_limits<double>::quiet_NaN();
+    xs[6] = std::numeric_limits<double>::infinity();
+    xs[7] = -std::numeric_limits<double>::infinity();
+    xs[8] = -8.0; // lower edge -> bin 0
+    xs[9] = 8.0;  // upper edge -> overflow
+    const auto ref = naive_linear(xs, -8.0, 8.0, 64);
+
+    fastnum::Histogram<double, 64> batch(-8.0, 8.0), scalar(-8.0, 8.0);
+    batch.observe(xs);
+    for (double x : xs) scalar.observe(x);
+
+    REQUIRE(batch.count() == xs.size());
+    REQUIRE(batch.nan_count() == 1);
+    REQUIRE(batch.underflow() == ref.under);
+    REQUIRE(batch.overflow() == ref.over);
+    for (std::size_t i = 0; i < 64; ++i) {
+        REQUIRE(batch.bin_count(i) == ref.bins[i]);
+        REQUIRE(scalar.bin_count(i) == ref.bins[i]);
+    }
+    REQUIRE(scalar.underflow() == ref.under);
+    REQUIRE(scalar.overflow() == ref.over);
+    REQUIRE(batch.bin_lower(0) == -8.0);
+    REQUIRE(batch.bin_upper(63) == 8.0);
+    REQUIRE(batch.bin_lower(16) == -4.0);
+}
+
+TEST_CASE("Histogram float batch matches scalar", "[histogram]") {
+    const auto xd = normal_data(4099, 602);
+    std::vector<float> xs(xd.begin(), xd.end());
+
+    fastnum::Histogram<float, 100> a(-5.0f, 7.0f), b(-5.0f, 7.0f);
+    a.observe(xs.data(), xs.size());
+    for (float x : xs) b.observe(x);
+    for (std::size_t i = 0; i < 100; ++i) REQUIRE(a.bin_count(i) == b.bin_count(i));
+    REQUIRE(a.underflow() == b.underflow());
+    REQUIRE(a.overflow() == b.overflow());
+    REQUIRE(a.count() == xs.size());
+}
+
+TEST_CASE("Histogram log bins use exact edges", "[histogram]") {
+    using H = fastnum::Histogram<double, 6, fastnum::bin_scale::log>;
+    H h(1.0, 1e6);
+    REQUIRE(h.bin_lower(0) == 1.0);
+    REQUIRE(h.bin_lower(3) == Catch::Approx(1e3));
+    REQUIRE(h.bin_upper(5) == 1e6);
+
+    const std::vector<double> xs = {0.5, -1.0, 1.0, 5.0, 50.0, h.bin_lower(3), 999999.0, 1e6, 1e9,
+                                    std::numeric_limits<double>::quiet_NaN()};
+    h.observe(xs);
+    REQUIRE(h.underflow() == 2);
+    REQUIRE(h.bin_count(0) == 2);
+    REQUIRE(h.bin_count(1) == 1);
+    REQUIRE(h.bin_count(3) == 1); // exactly on an edge: upper bin
+    REQUIRE(h.bin_count(5) == 1);
+    REQUIRE(h.overflow() == 2);
+    REQUIRE(h.nan_count() == 1);
+    REQUIRE(h.count() == xs.size());
+
+    // Against log10 binning on random data away from the edges.
+    std::mt19937 rng(603);
+    std::uniform_real_distribution<double> e(-1.0, 7.0);
+    H g(1.0, 1e6);
+    std::vector<std::uint64_t> ref(6);
+    std::uint64_t under = 0, over = 0;
+    for (int i = 0; i < 10000; ++i) {
+        const double x = std::pow(10.0, e(rng));
+        g.observe(x);
+        if (x < 1.0) ++under;
+        else if (x >= 1e6) ++over;
+        else ++ref[static_cast<std::size_t>(std::log10(x))];
+    }
+    REQUIRE(g.underflow() == under);
+    REQUIRE(g.overflow() == over);
+    for (std::size_t i = 0; i < 6; ++i) REQUIRE(g.bin_count(i) == ref[i]);
+}
+
+TEST_CASE("Histogram merge adds counts and reset clears them", "[histogram]") {
+    const auto xs = normal_data(10000, 604);
+    fastnum::Histogram<double, 32> whole(-6.0, 6.0), a(-6.0, 6.0), b(-6.0, 6.0);
+    whole.observe(xs);
+    a.observe(xs.data(), 3333);
+    b.observe(xs.data() + 3333, xs.size() - 3333);
+    a.merge(b);
+    for (std::size_t i = 0; i < 32; ++i) REQUIRE(a.bin_count(i) == whole.bin_count(i));
+    REQUIRE(a.underflow() == whole.underflow());
+    REQUIRE(a.overflow() == whole.overflow());
+
+    a.reset();
+    REQUIRE_FALSE(a.ready());
+    REQUIRE(a.count() == 0);
+    REQUIRE(a.lo() == -6.0);
+}
+
+TEST_CASE("Histogram with many bins skips the sub-histograms", "[histogram]") {
+    auto xs = normal_data(5000, 605);
+    fastnum::Histogram<double, 20000> a(-10.0, 10.0), b(-10.0, 10.0);
+    a.observe(xs);
+    for (double x : xs) b.observe(x);
+    for (std::size_t i = 0; i < 20000; ++i) REQUIRE(a.bin_count(i) == b.bin_count(i));
+    REQUIRE(a.count() == xs.size());
+}
+
+TEST_CASE("Histogram batch observe matches scalar around the sub-histogram cutoff", "[histogram]") {
+    // 2000 bins fit the sub-histograms; they are used only from
+    // 4 * (2000 + 3) samples on, and then kept across all blocks of a call.
+    using H = fastnum::Histogram<double, 2000>;
+    for (const std::size_t n : {std::size_t{100}, std::size_t{8011}, std::size_t{8012}, std::size_t{50001}}) {
+        auto xs = normal_data(n, 606);
+        xs[n / 2] = std::numeric_limits<double>::quiet_NaN();
+        H a(-4.0, 4.0), b(-4.0, 4.0);
+        a.observe(5.0);
+        b.observe(5.0);
+        a.observe(xs);
+        a.observe(xs.data(), 7);
+        for (double x : xs) b.observe(x);
+        for (std::size_t i = 0; i < 7; ++i) b.observe(xs[i]);
+        for (std::size_t i = 0; i < H::bins; ++i) REQUIRE(a.bin_count(i) == b.bin_count(i));
+        REQUIRE(a.underflow() == b.underflow());
+        REQUIRE(a.overflow() == b.overflow());
+        REQUIRE(a.nan_count() == 1);
+        REQUIRE(a.count() == n + 8);
+    }
+}
@@ -0,0 +1,83 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/ingest_pipeline.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST_CASE("IngestPipeline single producer matches inline observes", "[ingest]") {
+    // A tiny ring forces wrap-around and producer back-pressure.
+    fastnum::IngestRunningStats<double> pipeline({1, 8, std::chrono::microseconds{10}});
+    fastnum::RunningStats<double> ref;
+    {
+        auto p = pipeline.make_producer();
+        for (int i = 0; i < 20000; ++i) {
+            const double x = 1e4 + static_cast<double>(i % 97) * 0.5;
+            p.observe(x);
+            ref.observe(x);
+        }
+    }
+    const auto got = pipeline.flush();
+    REQUIRE(got.count() == ref.count());
+    REQUIRE(pipeline.consumed() == 20000);
+    REQUIRE(got.mean() == Catch::Approx(ref.mean()).epsilon(1e-12));
+    REQUIRE(got.variance_sample() == Catch::Approx(ref.variance_sample()).epsilon(1e-10));
+    REQUIRE(pipeline.snapshot().count() == 20000);
+}
+
+TEST_CASE("IngestPipeline merges several producer lanes", "[ingest]") {
+    constexpr std::size_t producers = 4;
+    constexpr std::size_t per_producer = 50000;
+    fastnum::IngestRunningStats<double> pipeline({producers, 1024, std::chrono::microseconds{10}});
+    REQUIRE(pipeline.lanes() == producers);
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < producers; ++t) {
+        threads.emplace_back([&pipeline, t] {
+            auto p = pipeline.make_producer();
+            for (std::size_t i = 0; i < per_producer; ++i) p.observe(static_cast<double>(t * per_producer + i));
+            // Flush from a producer sees at least its own samples.
+            REQUIRE(pipeline.flush().count() >= per_producer);
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    const auto got = pipeline.flush();
+    const double n = static_cast<double>(producers * per_producer);
+    REQUIRE(got.count() == producers * per_producer);
+    REQUIRE(got.mean() == Catch::Approx((n - 1.0) / 2.0).epsilon(1e-12));
+    REQUIRE(got.variance_population() == Catch::Approx((n * n - 1.0) / 12.0).epsilon(1e-10));
+}
+
+TEST_CASE("IngestPipeline lanes, try_observe and pair accumulators", "[ingest]") {
+    fastnum::IngestCovariance<double> pipeline({2, 4, std::chrono::microseconds{10}});
+    auto a = pipeline.try_make_producer();
+    auto b = pipeline.try_make_producer();
+    REQUIRE(a.has_value());
+    REQUIRE(b.has_value());
+    REQUIRE(!pipeline.try_make_producer().has_value());
+
+    std::size_t accepted = 0;
+    for (int i = 0; i < 1000; ++i) {
+        const double x = static_cast<double>(i);
+        if (a->try_observe(x, 2.0 * x + 1.0)) ++accepted;
+    }
+    REQUIRE(accepted >= 4);
+    b->observe(-1.0, -1.0);
+
+    const auto got = pipeline.flush();
+    REQUIRE(got.count() == accepted + 1);
+    REQUIRE(got.correlation() == Catch::Approx(1.0));
+
+    b.reset(); // releasing a handle frees its lane
+    REQUIRE(pipeline.try_make_producer().has_value());
+
+    fastnum::RunningStats<double> seeded;
+    seeded.observe(5.0);
+    fastnum::IngestRunningStats<double> resumed({}, seeded);
+    REQUIRE(resumed.snapshot().count() == 1);
+}
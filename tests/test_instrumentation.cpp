@@ -0,0 +1,193 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/instrumentation.hpp>
+#include <fastnum/running_stats.hpp>
+#include <fastnum/online_covariance.hpp>
+#include <fastnum/online_standard_scaler.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct stats_tag {};
+struct cov_tag {};
+struct scaler_tag {};
+struct skip_tag {};
+
+template <class Tag>
+using counting_policy = fastnum::instrumented_policy<fastnum::counting_instrumentation<Tag>>;
+
+struct recording_exporter {
+    std::vector<std::pair<std::string, std::uint64_t>> counters;
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> buckets;
+
+    void counter(std::string_view name, std::uint64_t value) { counters.emplace_back(std::string(name), value); }
+    void bucket(std::string_view name, std::uint64_t upper, std::uint64_t count) {
+        REQUIRE(name == "fastnum_batch_size");
+        buckets.emplace_back(upper, count);
+    }
+};
+
+} // namespace
+
+TEST_CASE("Default policies carry no instrumentation", "[instrumentation]") {
+    STATIC_REQUIRE(std::is_same_v<fastnum::detail::instrumentation_of_t<fastnum::default_policy>,
+                                  fastnum::no_instrumentation>);
+    STATIC_REQUIRE(std::is_same_v<fastnum::detail::instrumentation_of_t<fastnum::compact_policy>,
+                                  fastnum::no_instrumentation>);
+    STATIC_REQUIRE(!fastnum::no_instrumentation::enabled);
+
+    // Hooks are static: instrumented accumulators keep their layout.
+    STATIC_REQUIRE(sizeof(fastnum::RunningStats<double, counting_policy<stats_tag>>) ==
+                   sizeof(fastnum::RunningStats<double>));
+    STATIC_REQUIRE(sizeof(fastnum::OnlineCovariance<float, counting_policy<cov_tag>>) ==
+                   sizeof(fastnum::OnlineCovariance<float>));
+}
+
+TEST_CASE("counting_instrumentation tallies RunningStats events", "[instrumentation]") {
+    using hooks = fastnum::counting_instrumentation<stats_tag>;
+    using Stats = fastnum::RunningStats<double, counting_policy<stats_tag>>;
+    hooks::reset();
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> xs(100);
+    for (std::size_t i = 0; i < xs.size(); ++i) xs[i] = i % 20 == 0 ? nan : static_cast<double>(i);
+
+    Stats rs;
+    fastnum::RunningStats<double> plain;
+    rs.observe(1.0);
+    rs.observe(nan);
+    rs.observe(xs);
+    plain.observe(1.0);
+    plain.observe(nan);
+    plain.observe(xs);
+
+    Stats other;
+    other.observe(2.0);
+    rs.merge(other);
+    std::vector<Stats> parts(10, other);
+    rs.merge_many(parts);
+
+    const auto s = hooks::snapshot();
+    REQUIRE(s.samples == 1 + 1 + 100 + 1);
+    REQUIRE(s.observe_calls == 4);
+    REQUIRE(s.nans == 1 + 5);
+    REQUIRE(s.merges == 1 + 10); // internal lane merges are not reported
+    REQUIRE(s.not_ready_transforms == 0);
+    REQUIRE(s.batch_sizes[1] == 3);
+    REQUIRE(s.batch_sizes[7] == 1); // 64 <= 100 < 128
+
+    // Instrumentation does not change results.
+    REQUIRE(rs.count() == plain.count() + 11);
+    REQUIRE(std::isnan(rs.mean()));
+
+    hooks::reset();
+    REQUIRE(hooks::snapshot().samples == 0);
+    REQUIRE(hooks::snapshot().batch_sizes[7] == 0);
+}
+
+TEST_CASE("counting_instrumentation tallies covariance and scaler events", "[instrumentation]") {
+    using cov_hooks = fastnum::counting_instrumentation<cov_tag>;
+    using scaler_hooks = fastnum::counting_instrumentation<scaler_tag>;
+    cov_hooks::reset();
+    scaler_hooks::reset();
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> xs(40, 1.0), ys(40, 2.0), xy(80, 3.0);
+    ys[3] = nan;
+    xy[0] = nan;
+    xy[1] = nan;
+
+    fastnum::OnlineCovariance<double, counting_policy<cov_tag>> cov;
+    cov.observe(xs, ys);
+    cov.observe_interleaved(xy);
+    cov.observe_strided(xs.data(), 2, ys.data(), 2, 20);
+    cov.observe(1.0, nan, 3.0);
+
+    auto c = cov_hooks::snapshot();
+    REQUIRE(c.samples == 40 + 40 + 20 + 1);
+    REQUIRE(c.observe_calls == 4);
+    REQUIRE(c.nans == 1 + 2 + 0 + 1); // ys[3] sits at an odd index
+    REQUIRE(c.merges == 0);
+    REQUIRE(scaler_hooks::snapshot().samples == 0); // tags are independent
+
+    using Scaler = fastnum::OnlineStandardScaler<double, fastnum::RunningStats<double, counting_policy<scaler_tag>>>;
+    Scaler scaler;
+    std::vector<double> out(16);
+    REQUIRE(std::isnan(scaler.transform(1.0)));
+    scaler.transform(xs.data(), out.data(), out.size());
+    scaler.transform_inplace(out);
+    REQUIRE(scaler_hooks::snapshot().not_ready_transforms == 1 + 16 + 16);
+
+    std::vector<double> in = {1.0, 2.0, 3.0, 4.0};
+    scaler.observe_and_transform(in, out);
+    REQUIRE(scaler.ready());
+    REQUIRE(std::isfinite(scaler.transform(1.0)));
+
+    const auto s = scaler_hooks::snapshot();
+    REQUIRE(s.not_ready_transforms == 33 + 2); // the first two fused outputs
+    REQUIRE(s.samples == 4);
+    REQUIRE(s.observe_calls == 1);
+}
+
+TEST_CASE("observe_and_transform reports one batch event with a skipping backend", "[instrumentation]") {
+    using hooks = fastnum::counting_instrumentation<skip_tag>;
+    using Policy = fastnum::instrumented_policy<
+        hooks, fastnum::nan_handling_policy<fastnum::nan_policy::count_and_skip>>;
+    hooks::reset();
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> in(300);
+    for (std::size_t i = 0; i < in.size(); ++i) in[i] = static_cast<double>(i % 7);
+    in[0] = nan;
+    in[2] = nan;
+    in[100] = nan;
+
+    fastnum::OnlineStandardScaler<double, fastnum::RunningStats<double, Policy>> scaler;
+    std::vector<double> out(in.size());
+    scaler.observe_and_transform(in, out);
+    REQUIRE(scaler.count() == 297);
+    REQUIRE(scaler.skipped() == 3);
+
+    // in[0..4] = NaN, 1, NaN, 3, 4: in[4] is the first to follow two
+    // counted samples; the later NaN meets a ready scaler.
+    const auto s = hooks::snapshot();
+    REQUIRE(s.observe_calls == 1);
+    REQUIRE(s.samples == 300);
+    REQUIRE(s.nans == 3);
+    REQUIRE(s.not_ready_transforms == 4);
+    REQUIRE(out[4] == (4.0 - 2.0) / 1.0);
+    REQUIRE(std::isnan(out[100]));
+}
+
+TEST_CASE("export_metrics reports totals and non-empty batch buckets", "[instrumentation]") {
+    fastnum::instrumentation_snapshot s;
+    s.samples = 1030;
+    s.observe_calls = 3;
+    s.nans = 2;
+    s.merges = 4;
+    s.not_ready_transforms = 5;
+    s.batch_sizes[1] = 2;  // n == 1
+    s.batch_sizes[11] = 1; // 1024 <= n <= 2047
+    s.batch_sizes[64] = 7;
+
+    recording_exporter e;
+    fastnum::export_metrics(s, e);
+
+    REQUIRE(e.counters.size() == 5);
+    REQUIRE(e.counters[0] == std::pair<std::string, std::uint64_t>{"fastnum_samples", 1030});
+    REQUIRE(e.counters[2] == std::pair<std::string, std::uint64_t>{"fastnum_nans", 2});
+    REQUIRE(e.counters[4] == std::pair<std::string, std::uint64_t>{"fastnum_not_ready_transforms", 5});
+    REQUIRE(e.buckets.size() == 3);
+    REQUIRE(e.buckets[0] == std::pair<std::uint64_t, std::uint64_t>{1, 2});
+    REQUIRE(e.buckets[1] == std::pair<std::uint64_t, std::uint64_t>{2047, 1});
+    REQUIRE(e.buckets[2] == std::pair<std::uint64_t, std::uint64_t>{~std::uint64_t{0}, 7});
+}
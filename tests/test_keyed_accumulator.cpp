@@ -0,0 +1,153 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/keyed_accumulator.hpp>
+#include <fastnum/exponential_stats.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+TEST_CASE("KeyedRunningStats bulk observe matches unordered_map reference", "[keyed]") {
+    std::mt19937_64 rng(201);
+    std::uniform_int_distribution<std::uint64_t> key_dist(0, 999);
+    std::normal_distribution<double> dist(3.0, 2.0);
+
+    const std::size_t n = 20000;
+    std::vector<std::uint64_t> keys(n);
+    std::vector<double> xs(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys[i] = key_dist(rng) * 4096; // identity std::hash, clustered low bits
+        xs[i] = dist(rng);
+    }
+
+    fastnum::KeyedRunningStats<std::uint64_t> table;
+    table.observe(keys.data(), xs.data(), n);
+
+    std::unordered_map<std::uint64_t, fastnum::RunningStats<double>> ref;
+    for (std::size_t i = 0; i < n; ++i) ref[keys[i]].observe(xs[i]);
+
+    REQUIRE(table.size() == ref.size());
+    for (const auto& [k, rs] : ref) {
+        const auto* got = table.find(k);
+        REQUIRE(got != nullptr);
+        REQUIRE(got->count() == rs.count());
+        // Same per-key observation order, so bit-identical.
+        REQUIRE(got->mean() == rs.mean());
+        REQUIRE(got->m2() == rs.m2());
+    }
+    REQUIRE(table.find(1) == nullptr);
+    REQUIRE_FALSE(table.contains(4095));
+
+    // Dense arrays line up and follow first-insertion order.
+    REQUIRE(table.keys()[0] == keys[0]);
+    std::size_t total = 0;
+    table.for_each([&](std::uint64_t k, const fastnum::RunningStats<double>& rs) {
+        REQUIRE(table.find(k) == &rs);
+        total += rs.count();
+    });
+    REQUIRE(total == n);
+}
+
+TEST_CASE("KeyedAccumulator scalar observe, operator[] and clear", "[keyed]") {
+    fastnum::KeyedRunningStats<std::string> table;
+    table.observe(std::string("a"), 1.0);
+    table.observe(std::string("a"), 3.0);
+    table["b"].observe(10.0);
+
+    REQUIRE(table.size() == 2);
+    REQUIRE(table.find("a")->mean() == Catch::Approx(2.0));
+    REQUIRE(table.find("b")->count() == 1);
+
+    // Growth through many rehashes keeps every key reachable.
+    for (int i = 0; i < 5000; ++i) table[std::to_string(i)].observe(static_cast<double>(i));
+    REQUIRE(table.size() == 5002);
+    for (int i = 0; i < 5000; i += 97) REQUIRE(table.find(std::to_string(i))->mean() == i);
+
+    table.clear();
+    REQUIRE(table.empty());
+    REQUIRE(table.find("a") == nullptr);
+    table.observe(std::string("a"), 5.0);
+    REQUIRE(table.find("a")->count() == 1);
+}
+
+TEST_CASE("Keyed merge equals single-table ingestion", "[keyed][merge]") {
+    std::mt19937 rng(202);
+    std::uniform_int_distribution<int> key_dist(0, 300);
+    std::normal_distribution<double> dist(0.0, 1.0);
+
+    fastnum::KeyedCovariance<int> a, b, full;
+    for (int i = 0; i < 6000; ++i) {
+        const int k = key_dist(rng);
+        const double x = dist(rng);
+        const double y = x + 0.1 * dist(rng);
+        (i % 3 == 0 ? a : b).observe(k, x, y);
+        full.observe(k, x, y);
+    }
+    a.merge(b);
+
+    REQUIRE(a.size() == full.size());
+    full.for_each([&](int k, const fastnum::OnlineCovariance<double>& ref) {
+        const auto* got = a.find(k);
+        REQUIRE(got != nullptr);
+        REQUIRE(got->count() == ref.count());
+        REQUIRE(got->mean_x() == Catch::Approx(ref.mean_x()).epsilon(1e-12).margin(1e-12));
+        if (ref.count() > 1) {
+            REQUIRE(got->covariance_sample() == Catch::Approx(ref.covariance_sample()).epsilon(1e-10));
+        }
+    });
+}
+
+TEST_CASE("Keyed self-merge doubles every key", "[keyed][merge]") {
+    fastnum::KeyedAccumulator<int, fastnum::RunningStats<double>> table;
+    for (int i = 0; i < 100; ++i) table.observe(i % 7, static_cast<double>(i));
+    const auto before = table;
+
+    table.merge(table);
+    REQUIRE(table.size() == before.size());
+    before.for_each([&](int k, const fastnum::RunningStats<double>& ref) {
+        const auto* got = table.find(k);
+        REQUIRE(got != nullptr);
+        REQUIRE(got->count() == 2 * ref.count());
+        REQUIRE(got->mean() == Catch::Approx(ref.mean()));
+    });
+}
+
+TEST_CASE("Keyed covariance bulk observe", "[keyed]") {
+    const int keys[] = {1, 2, 1, 2, 1, 2};
+    const double xs[] = {1, 2, 3, 4, 5, 6};
+    const double ys[] = {2, 1, 6, 3, 10, 5};
+
+    fastnum::KeyedCovariance<int> table;
+    table.observe(keys, xs, ys, 6);
+    REQUIRE(table.find(1)->covariance_population() == Catch::Approx(16.0 / 3.0));
+    REQUIRE(table.find(2)->count() == 3);
+}
+
+TEST_CASE("KeyedStandardScaler transforms per key", "[keyed][scaler]") {
+    fastnum::KeyedStandardScaler<int> table;
+    const int keys[] = {0, 0, 0, 1, 1, 1};
+    const double xs[] = {1.0, 2.0, 3.0, 100.0, 200.0, 300.0};
+    table.observe(keys, xs, 6);
+
+    const int qk[] = {0, 1, 7};
+    const double in[] = {2.0, 300.0, 1.0};
+    double out[3];
+    table.transform(qk, in, out, 3);
+    REQUIRE(out[0] == Catch::Approx(0.0).margin(1e-12));
+    REQUIRE(out[1] == Catch::Approx(std::sqrt(1.5)));
+    REQUIRE(std::isnan(out[2]));
+}
+
+TEST_CASE("KeyedAccumulator seeds new keys from the prototype", "[keyed]") {
+    fastnum::KeyedAccumulator<int, fastnum::ExponentialStats<double>> table(
+        fastnum::ExponentialStats<double>(0.5), 64);
+    table.observe(3, 1.0);
+    table.observe(3, 2.0);
+    REQUIRE(table.find(3)->decay_factor() == Catch::Approx(0.5));
+    REQUIRE(table.find(3)->mean() == Catch::Approx((0.5 * 1.0 + 2.0) / 1.5));
+}
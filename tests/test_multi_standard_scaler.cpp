@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/multi_standard_scaler.hpp>
+#include <fastnum/online_standard_scaler.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+static std::vector<double> make_rows(std::size_t n, std::size_t d, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    std::vector<double> rows(n * d);
+    for (std::size_t r = 0; r < n; ++r)
+        for (std::size_t j = 0; j < d; ++j)
+            rows[r * d + j] = static_cast<double>(j) + (1.0 + 0.1 * static_cast<double>(j)) * dist(rng);
+    return rows;
+}
+
+static std::vector<double> to_columns(const std::vector<double>& rows, std::size_t n, std::size_t d) {
+    std::vector<double> cols(n * d);
+    for (std::size_t r = 0; r < n; ++r)
+        for (std::size_t j = 0; j < d; ++j) cols[j * n + r] = rows[r * d + j];
+    return cols;
+}
+
+TEST_CASE("MultiStandardScaler matches one OnlineStandardScaler per feature", "[multiscaler]") {
+    constexpr std::size_t d = 37;
+    constexpr std::size_t n = 401;
+    const auto rows = make_rows(n, d, 61);
+    const auto cols = to_columns(rows, n, d);
+
+    fastnum::MultiStandardScaler<double> by_rows(d);
+    by_rows.observe_rows(rows.data(), n);
+
+    fastnum::MultiStandardScaler<double> by_cols(d);
+    by_cols.observe_columns(cols.data(), n);
+
+    REQUIRE(by_rows.count() == n);
+    REQUIRE(by_cols.count() == n);
+    REQUIRE(by_rows.ready());
+
+    for (std::size_t j = 0; j < d; ++j) {
+        fastnum::OnlineStandardScaler<double> ref;
+        ref.observe(cols.data() + j * n, n);
+
+        REQUIRE(by_rows.mean(j) == Catch::Approx(ref.mean()).epsilon(1e-12));
+        REQUIRE(by_cols.mean(j) == Catch::Approx(ref.mean()).epsilon(1e-12));
+        REQUIRE(by_rows.freeze(j).transform(0.5) == Catch::Approx(ref.transform(0.5)).epsilon(1e-10));
+        REQUIRE(by_cols.freeze(j).transform(0.5) == Catch::Approx(ref.transform(0.5)).epsilon(1e-10));
+    }
+}
+
+TEST_CASE("MultiStandardScaler row and column transforms agree", "[multiscaler]") {
+    constexpr std::size_t d = 19;
+    constexpr std::size_t n = 64;
+    const auto rows = make_rows(n, d, 62);
+    const auto cols = to_columns(rows, n, d);
+
+    fastnum::MultiStandardScaler<double> scaler(d);
+    scaler.observe_rows(rows.data(), n);
+
+    std::vector<double> zr(rows.size()), zc(cols.size());
+    scaler.transform_rows(rows.data(), zr.data(), n);
+    scaler.transform_columns(cols.data(), zc.data(), n);
+
+    for (std::size_t r = 0; r < n; ++r) {
+        for (std::size_t j = 0; j < d; ++j) {
+            REQUIRE(zr[r * d + j] == zc[j * n + r]);
+            REQUIRE(zr[r * d + j] == scaler.freeze(j).transform(rows[r * d + j]));
+        }
+    }
+}
+
+TEST_CASE("MultiStandardScaler strided observe and merge", "[multiscaler][merge]") {
+    constexpr std::size_t d = 10;
+    constexpr std::size_t n = 300;
+    const auto rows = make_rows(n, d, 63);
+
+    fastnum::MultiStandardScaler<double> all(d);
+    all.observe_rows(rows.data(), n);
+
+    // Rows embedded with leading dimension 16.
+    constexpr std::size_t ld = 16;
+    std::vector<double> wide(n * ld, 1e300);
+    for (std::size_t r = 0; r < n; ++r)
+        for (std::size_t j = 0; j < d; ++j) wide[r * ld + j] = rows[r * d + j];
+
+    fastnum::MultiStandardScaler<double> a(d), b(d);
+    a.observe_rows(wide.data(), 120, ld);
+    b.observe_rows(wide.data() + 120 * ld, n - 120, ld);
+    a.merge(b);
+
+    REQUIRE(a.count() == all.count());
+    for (std::size_t j = 0; j < d; ++j) {
+        REQUIRE(a.mean(j) == Catch::Approx(all.mean(j)).epsilon(1e-12));
+        REQUIRE(a.variance_population(j) == Catch::Approx(all.variance_population(j)).epsilon(1e-10));
+        REQUIRE(a.inv_std(j) == Catch::Approx(all.inv_std(j)).epsilon(1e-10));
+    }
+}
+
+TEST_CASE("MultiStandardScaler per-feature readiness", "[multiscaler]") {
+    fastnum::MultiStandardScaler<double> scaler(2);
+    REQUIRE_FALSE(scaler.ready());
+
+    const double rows[] = {1.0, 7.0, 2.0, 7.0, 3.0, 7.0};
+    scaler.observe_rows(rows, 3);
+
+    REQUIRE(scaler.ready(0));
+    REQUIRE_FALSE(scaler.ready(1)); // constant column
+    REQUIRE_FALSE(scaler.ready());
+
+    double z[6];
+    scaler.transform_rows(rows, z, 3);
+    REQUIRE(z[0] == Catch::Approx(-std::sqrt(1.5)));
+    REQUIRE(std::isnan(z[1]));
+
+    scaler.reset();
+    REQUIRE(scaler.count() == 0);
+    REQUIRE_FALSE(scaler.ready(0));
+}
@@ -0,0 +1,153 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/one_vs_many_covariance.hpp>
+#include <fastnum/online_covariance.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+struct screening_data {
+    std::size_t d;
+    std::size_t ld;
+    std::vector<double> ys;
+    std::vector<double> rows;
+};
+
+// Candidates with varied scale and offset, some correlated with the target.
+screening_data make_data(std::size_t n, std::size_t d, std::size_t ld, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    screening_data s{d, ld, std::vector<double>(n), std::vector<double>(n * ld, -999.0)};
+    for (std::size_t r = 0; r < n; ++r) {
+        s.ys[r] = 50.0 + 3.0 * dist(rng);
+        for (std::size_t j = 0; j < d; ++j) {
+            const double beta = static_cast<double>(j % 5) * 0.2;
+            s.rows[r * ld + j] = 100.0 * static_cast<double>(j) + beta * s.ys[r] + dist(rng);
+        }
+    }
+    return s;
+}
+
+// Readiness threshold of 2, i.e. population variances up to 4 are "constant".
+struct coarse_policy : fastnum::compact_policy {
+    template <class T>
+    static constexpr T eps = static_cast<T>(2);
+};
+
+std::vector<fastnum::OnlineCovariance<double>> reference(const screening_data& s, std::size_t begin,
+                                                         std::size_t end) {
+    std::vector<fastnum::OnlineCovariance<double>> ref(s.d);
+    for (std::size_t r = begin; r < end; ++r) {
+        for (std::size_t j = 0; j < s.d; ++j) ref[j].observe(s.rows[r * s.ld + j], s.ys[r]);
+    }
+    return ref;
+}
+
+template <class Screen>
+void require_matches(const Screen& got, const std::vector<fastnum::OnlineCovariance<double>>& ref) {
+    REQUIRE(got.count() == ref[0].count());
+    REQUIRE(got.mean_target() == Catch::Approx(ref[0].mean_y()).epsilon(1e-12));
+    REQUIRE(got.variance_target_sample() == Catch::Approx(ref[0].variance_y_sample()).epsilon(1e-10));
+    std::vector<double> corr(got.dim());
+    got.correlations(corr.data());
+    for (std::size_t j = 0; j < got.dim(); ++j) {
+        REQUIRE(got.mean(j) == Catch::Approx(ref[j].mean_x()).epsilon(1e-12));
+        REQUIRE(got.variance_sample(j) == Catch::Approx(ref[j].variance_x_sample()).epsilon(1e-10));
+        REQUIRE(got.covariance_sample(j) == Catch::Approx(ref[j].covariance_sample()).epsilon(1e-9).margin(1e-12));
+        REQUIRE(got.correlation(j) == Catch::Approx(ref[j].correlation()).epsilon(1e-9).margin(1e-12));
+        REQUIRE(corr[j] == got.correlation(j));
+    }
+}
+
+} // namespace
+
+TEST_CASE("OneVsManyCovariance matches per-candidate OnlineCovariance", "[onevsmany]") {
+    // 37 and 101 candidates leave SIMD-width and scalar tails; ld > d pads rows.
+    for (std::size_t d : {std::size_t{1}, std::size_t{37}, std::size_t{101}}) {
+        const auto s = make_data(700, d, d + 3, static_cast<unsigned>(500 + d));
+        fastnum::OneVsManyCovariance<double> screen(d);
+        screen.observe(s.ys.data(), s.rows.data(), 300, s.ld);
+        for (std::size_t r = 300; r < 700; ++r) screen.observe(s.ys[r], s.rows.data() + r * s.ld);
+        require_matches(screen, reference(s, 0, 700));
+    }
+}
+
+TEST_CASE("OneVsManyCovariance merge agrees with OnlineCovariance::merge", "[onevsmany]") {
+    const auto s = make_data(1000, 19, 19, 510);
+    fastnum::OneVsManyCovariance<double, 19> a, b;
+    a.observe(s.ys.data(), s.rows.data(), 400);
+    b.observe(s.ys.data() + 400, s.rows.data() + 400 * 19, 600);
+    a.merge(b);
+
+    auto ref = reference(s, 0, 400);
+    const auto ref_b = reference(s, 400, 1000);
+    for (std::size_t j = 0; j < 19; ++j) ref[j].merge(ref_b[j]);
+    require_matches(a, ref);
+
+    fastnum::OneVsManyCovariance<double, 19> empty;
+    empty.merge(a);
+    REQUIRE(empty.count() == 1000);
+    REQUIRE(empty.covariance_sample(3) == a.covariance_sample(3));
+}
+
+TEST_CASE("OneVsManyCovariance readiness and reset", "[onevsmany]") {
+    fastnum::OneVsManyCovariance<double> screen(3);
+    const double row[3] = {1.0, 2.0, 3.0};
+    REQUIRE(std::isnan(screen.variance_target_population()));
+    screen.observe(1.0, row);
+    REQUIRE(!screen.ready());
+    REQUIRE(screen.covariance_population(0) == 0.0);
+    REQUIRE(std::isnan(screen.covariance_sample(0)));
+
+    const double row2[3] = {2.0, 2.0, 5.0};
+    screen.observe(1.0, row2); // constant target: correlations undefined
+    REQUIRE(screen.ready());
+    std::vector<double> corr(3);
+    screen.correlations(corr.data());
+    for (double c : corr) REQUIRE(std::isnan(c));
+
+    const double row3[3] = {3.0, 2.0, 7.0};
+    screen.observe(2.0, row3);
+    REQUIRE(screen.correlation(0) == Catch::Approx(0.8660254037844386));
+    REQUIRE(std::isnan(screen.correlation(1))); // constant candidate
+    REQUIRE(screen.correlation(2) == Catch::Approx(0.8660254037844386));
+
+    screen.reset();
+    REQUIRE(screen.count() == 0);
+    REQUIRE(screen.dim() == 3);
+    REQUIRE(screen.mean(2) == 0.0);
+}
+
+TEST_CASE("OneVsManyCovariance with no candidates and custom policies", "[onevsmany]") {
+    // No candidates: the batch path still tracks the target.
+    const double ys[5] = {1.0, 2.0, 3.0, 4.0, 5.0};
+    const double none[1] = {0.0};
+    fastnum::OneVsManyCovariance<double> dynamic(0);
+    dynamic.observe(ys, none, 5);
+    REQUIRE(dynamic.count() == 5);
+    REQUIRE(dynamic.variance_target_sample() == Catch::Approx(2.5));
+    fastnum::OneVsManyCovariance<double, 0> fixed;
+    fixed.observe(ys, none, 5);
+    fixed.observe(6.0, none);
+    REQUIRE(fixed.count() == 6);
+    REQUIRE(fixed.mean_target() == Catch::Approx(3.5));
+
+    // The readiness threshold comes from the policy, as in OnlineCovariance.
+    fastnum::OneVsManyCovariance<double, 2, coarse_policy> screen;
+    fastnum::OnlineCovariance<double, coarse_policy> ref;
+    const double targets[5] = {-10.0, -20.0, -30.0, -40.0, -50.0};
+    const double rows[10] = {1.0, 10.0, 2.0, 20.0, 3.0, 30.0, 4.0, 40.0, 5.0, 50.0};
+    screen.observe(targets, rows, 5);
+    for (std::size_t r = 0; r < 5; ++r) ref.observe(rows[2 * r], targets[r]);
+    static_assert(std::is_same_v<decltype(screen)::count_type, std::uint32_t>);
+    REQUIRE(std::isnan(screen.correlation(0))); // population variance 2 <= eps^2
+    REQUIRE(std::isnan(ref.correlation()));
+    REQUIRE(screen.correlation(1) == Catch::Approx(-1.0));
+}
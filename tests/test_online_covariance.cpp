@@ -158,3 +158,270 @@ TEST_CASE("OnlineCovariance merge equals observe-all-at-once", "[covariance][mer
                 Catch::Approx(all.correlation()).epsilon(1e-10));
     }
 }
+
+TEST_CASE("OnlineCovariance batch observe matches scalar observe", "[covariance][batch]") {
+    std::mt19937 rng(4242);
+    std::normal_distribution<double> dist(1.0, 2.0);
+
+    for (std::size_t n : {1u, 2u, 5u, 15u, 16u, 17u, 63u, 1000u, 4097u}) {
+        std::vector<double> xs(n), ys(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            xs[i] = dist(rng);
+            ys[i] = -0.5 * xs[i] + dist(rng);
+        }
+
+        fastnum::OnlineCovariance<double> stream;
+        for (std::size_t i = 0; i < n; ++i) stream.observe(xs[i], ys[i]);
+
+        fastnum::OnlineCovariance<double> batch;
+        batch.observe(xs, ys);
+
+        REQUIRE(batch.count() == stream.count());
+        REQUIRE(batch.mean_x() == Catch::Approx(stream.mean_x()).epsilon(1e-12));
+        REQUIRE(batch.mean_y() == Catch::Approx(stream.mean_y()).epsilon(1e-12));
+        REQUIRE(batch.covariance_population() ==
+                Catch::Approx(stream.covariance_population()).epsilon(1e-10).margin(1e-12));
+        REQUIRE(batch.variance_x_population() ==
+                Catch::Approx(stream.variance_x_population()).epsilon(1e-10));
+        REQUIRE(batch.variance_y_population() ==
+                Catch::Approx(stream.variance_y_population()).epsilon(1e-10));
+    }
+}
+
+TEST_CASE("OnlineCovariance weighted observe equals repeated observe", "[covariance][weighted]") {
+    std::mt19937 rng(1234);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    std::uniform_int_distribution<int> count(0, 5);
+
+    std::vector<double> xs(517), ys(517), ws(517), ex, ey;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = 3.0 + dist(rng);
+        ys[i] = 0.5 * xs[i] + dist(rng);
+        ws[i] = static_cast<double>(count(rng));
+        for (int k = 0; k < static_cast<int>(ws[i]); ++k) {
+            ex.push_back(xs[i]);
+            ey.push_back(ys[i]);
+        }
+    }
+
+    fastnum::OnlineCovariance<double> scalar, batch, summary;
+    for (std::size_t i = 0; i < xs.size(); ++i) scalar.observe(xs[i], ys[i], ws[i]);
+    batch.observe(xs.data(), ys.data(), ws.data(), xs.size());
+    summary.observe_summary(scalar.count(), scalar.mean_x(), scalar.mean_y(), scalar.m2_x(), scalar.m2_y(),
+                            scalar.comoment());
+
+    for (const auto* c : {&scalar, &batch, &summary}) {
+        REQUIRE(c->count() == ex.size());
+        REQUIRE(c->mean_x() == Catch::Approx(naive_mean(ex)).epsilon(1e-12));
+        REQUIRE(c->covariance_sample() == Catch::Approx(naive_cov_sample(ex, ey)).epsilon(1e-10));
+        REQUIRE(c->correlation() == Catch::Approx(naive_corr(ex, ey)).epsilon(1e-10));
+    }
+}
+
+TEST_CASE("OnlineCovariance fractional weights truncate alike in scalar and batch", "[covariance][weighted]") {
+    std::mt19937 rng(1235);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    std::uniform_real_distribution<double> weight(-1.0, 4.0);
+
+    for (const std::size_t n : {std::size_t{128}, std::size_t{301}}) {
+        for (const double fixed : {0.5, 2.5, -1.0, 0.0}) {
+            // fixed == 0 means random weights.
+            std::vector<double> xs(n), ys(n), ws(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                xs[i] = 3.0 + dist(rng);
+                ys[i] = 0.5 * xs[i] + dist(rng);
+                ws[i] = fixed != 0.0 ? fixed : weight(rng);
+            }
+            fastnum::OnlineCovariance<double> scalar, batch;
+            for (std::size_t i = 0; i < n; ++i) scalar.observe(xs[i], ys[i], ws[i]);
+            batch.observe(xs.data(), ys.data(), ws.data(), n);
+            REQUIRE(batch.count() == scalar.count());
+            REQUIRE(batch.mean_x() == Catch::Approx(scalar.mean_x()).epsilon(1e-12).margin(1e-12));
+            REQUIRE(batch.m2_y() == Catch::Approx(scalar.m2_y()).epsilon(1e-10).margin(1e-12));
+            REQUIRE(batch.comoment() == Catch::Approx(scalar.comoment()).epsilon(1e-10).margin(1e-12));
+        }
+    }
+}
+
+TEST_CASE("OnlineCovariance float weighted batch keeps exact counts beyond 2^24", "[covariance][weighted]") {
+    std::mt19937 rng(1236);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::uniform_int_distribution<int> count(900000, 1100000);
+
+    std::vector<float> xs(4096), ys(4096), ws(4096);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = dist(rng);
+        ys[i] = xs[i] + dist(rng);
+        ws[i] = static_cast<float>(count(rng));
+        total += static_cast<std::size_t>(ws[i]);
+    }
+    fastnum::OnlineCovariance<float> scalar, batch;
+    for (std::size_t i = 0; i < xs.size(); ++i) scalar.observe(xs[i], ys[i], ws[i]);
+    batch.observe(xs.data(), ys.data(), ws.data(), xs.size());
+    REQUIRE(scalar.count() == total);
+    REQUIRE(batch.count() == total);
+    REQUIRE(batch.correlation() == Catch::Approx(scalar.correlation()).epsilon(1e-3));
+}
+
+TEST_CASE("OnlineCovariance merge_many equals observing everything", "[covariance][merge]") {
+    std::mt19937 rng(4321);
+    std::normal_distribution<double> dist(0.0, 1.0);
+
+    std::vector<fastnum::OnlineCovariance<double>> parts(333);
+    std::vector<double> xs, ys;
+    for (std::size_t p = 0; p < parts.size(); ++p) {
+        for (std::size_t i = 0; i < p % 7; ++i) {
+            const double x = 100.0 + dist(rng);
+            const double y = -2.0 * x + dist(rng);
+            parts[p].observe(x, y);
+            xs.push_back(x);
+            ys.push_back(y);
+        }
+    }
+
+    fastnum::OnlineCovariance<double> many;
+    many.observe(xs[0], ys[0]); // existing state participates
+    many.merge_many(parts);
+    xs.push_back(xs[0]);
+    ys.push_back(ys[0]);
+
+    REQUIRE(many.count() == xs.size());
+    REQUIRE(many.mean_y() == Catch::Approx(naive_mean(ys)).epsilon(1e-12));
+    REQUIRE(many.covariance_sample() == Catch::Approx(naive_cov_sample(xs, ys)).epsilon(1e-10));
+    REQUIRE(many.correlation() == Catch::Approx(naive_corr(xs, ys)).epsilon(1e-10));
+}
+
+TEST_CASE("OnlineCovariance strided and interleaved observe match contiguous batches", "[covariance][batch]") {
+    std::mt19937 rng(31);
+    std::normal_distribution<double> dist(3.0, 2.0);
+
+    for (std::size_t n : {std::size_t{0}, std::size_t{5}, std::size_t{64}, std::size_t{1001}}) {
+        constexpr std::size_t cols = 3;
+        std::vector<double> rows(n * cols), xs(n), ys(n), xy(2 * n);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t c = 0; c < cols; ++c) rows[i * cols + c] = dist(rng);
+            xs[i] = rows[i * cols];
+            ys[i] = rows[i * cols + 2];
+            xy[2 * i] = xs[i];
+            xy[2 * i + 1] = ys[i];
+        }
+
+        fastnum::OnlineCovariance<double> contiguous, strided, interleaved, via_strides;
+        contiguous.observe(xs, ys);
+        strided.observe_strided(rows.data(), cols, rows.data() + 2, cols, n);
+        interleaved.observe_interleaved(xy);
+        via_strides.observe_strided(xy.data(), 2, xy.data() + 1, 2, n);
+
+        // Same values in the same lanes: the results are identical.
+        for (const auto* cov : {&strided, &interleaved, &via_strides}) {
+            REQUIRE(cov->count() == contiguous.count());
+            REQUIRE(cov->mean_x() == contiguous.mean_x());
+            REQUIRE(cov->mean_y() == contiguous.mean_y());
+            REQUIRE(cov->m2_x() == contiguous.m2_x());
+            REQUIRE(cov->comoment() == contiguous.comoment());
+        }
+    }
+}
+
+TEST_CASE("OnlineCovariance<float> interleaved observe matches naive reference", "[covariance][batch]") {
+    std::mt19937 rng(32);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> xy(2 * 777);
+    std::vector<double> xs, ys;
+    for (std::size_t i = 0; i < xy.size(); i += 2) {
+        xy[i] = dist(rng);
+        xy[i + 1] = 0.5f * xy[i] + dist(rng);
+        xs.push_back(xy[i]);
+        ys.push_back(xy[i + 1]);
+    }
+
+    fastnum::OnlineCovariance<float> cov;
+    cov.observe_interleaved(xy.data(), xy.size() / 2);
+    REQUIRE(cov.count() == xs.size());
+    REQUIRE(cov.mean_x() == Catch::Approx(naive_mean(xs)).epsilon(1e-5));
+    REQUIRE(cov.covariance_sample() == Catch::Approx(naive_cov_sample(xs, ys)).epsilon(1e-4));
+}
+
+TEST_CASE("OnlineCovariance NaN policy skips pairs with a non-finite member", "[covariance][nan]") {
+    using count_cov =
+        fastnum::OnlineCovariance<double, fastnum::nan_handling_policy<fastnum::nan_policy::count_and_skip>>;
+    std::mt19937 rng(52);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<double> xs(777), ys(777), xy, fx, fy;
+    std::size_t bad = 0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = i % 13 == 0 ? nan : dist(rng);
+        ys[i] = i % 19 == 5 ? std::numeric_limits<double>::infinity() : 2.0 * xs[i] + dist(rng);
+        xy.push_back(xs[i]);
+        xy.push_back(ys[i]);
+        if (std::isfinite(xs[i]) && std::isfinite(ys[i])) {
+            fx.push_back(xs[i]);
+            fy.push_back(ys[i]);
+        } else {
+            ++bad;
+        }
+    }
+
+    count_cov batch, interleaved, scalar;
+    batch.observe(xs, ys);
+    interleaved.observe_interleaved(xy);
+    for (std::size_t i = 0; i < xs.size(); ++i) scalar.observe(xs[i], ys[i]);
+
+    for (const auto* cov : {&batch, &interleaved, &scalar}) {
+        REQUIRE(cov->count() == fx.size());
+        REQUIRE(cov->skipped() == bad);
+        REQUIRE(cov->mean_x() == Catch::Approx(naive_mean(fx)).epsilon(1e-10));
+        REQUIRE(cov->covariance_sample() == Catch::Approx(naive_cov_sample(fx, fy)).epsilon(1e-10));
+    }
+
+    batch.merge(scalar);
+    REQUIRE(batch.skipped() == 2 * bad);
+
+    fastnum::OnlineCovariance<double> propagate;
+    propagate.observe(xs, ys);
+    REQUIRE(std::isnan(propagate.covariance_sample()));
+}
+
+TEST_CASE("OnlineCovariance NaN skipping switches kernels mid-batch", "[covariance][nan]") {
+    using count_cov =
+        fastnum::OnlineCovariance<double, fastnum::nan_handling_policy<fastnum::nan_policy::count_and_skip>>;
+    std::vector<double> xs(30000), ys(30000), fx, fy;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = static_cast<double>(i % 977) * 0.1;
+        ys[i] = static_cast<double>(i % 331) - 0.5 * xs[i];
+    }
+    ys[17000] = std::numeric_limits<double>::quiet_NaN();
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        if (i == 17000) continue;
+        fx.push_back(xs[i]);
+        fy.push_back(ys[i]);
+    }
+
+    count_cov cov;
+    cov.observe(xs, ys);
+    REQUIRE(cov.count() == fx.size());
+    REQUIRE(cov.skipped() == 1);
+    REQUIRE(cov.covariance_sample() == Catch::Approx(naive_cov_sample(fx, fy)).epsilon(1e-10));
+}
+
+TEST_CASE("OnlineCovariance<double> observes float columns in double precision", "[covariance][precision]") {
+    std::mt19937 rng(803);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    std::vector<float> xs(4099), ys(4099);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = static_cast<float>(500.0 + dist(rng));
+        ys[i] = static_cast<float>(0.5 * xs[i] + dist(rng));
+    }
+    const std::vector<double> wx(xs.begin(), xs.end()), wy(ys.begin(), ys.end());
+
+    fastnum::OnlineCovariance<double> mixed, ref;
+    mixed.observe(xs.data(), ys.data(), xs.size());
+    ref.observe(wx.data(), wy.data(), wx.size());
+    REQUIRE(mixed.count() == ref.count());
+    REQUIRE(mixed.mean_x() == Catch::Approx(ref.mean_x()).epsilon(1e-14));
+    REQUIRE(mixed.covariance_sample() == Catch::Approx(ref.covariance_sample()).epsilon(1e-12));
+    REQUIRE(mixed.correlation() == Catch::Approx(ref.correlation()).epsilon(1e-12));
+}
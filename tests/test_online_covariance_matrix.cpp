@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/online_covariance.hpp>
+#include <fastnum/online_covariance_matrix.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// --- Naive reference implementation (slow but correct) ---
+
+static std::vector<double> naive_cov_matrix_sample(const std::vector<double>& rows,
+                                                   std::size_t n, std::size_t d) {
+    std::vector<double> mean(d, 0.0);
+    for (std::size_t r = 0; r < n; ++r)
+        for (std::size_t j = 0; j < d; ++j) mean[j] += rows[r * d + j];
+    for (double& m : mean) m /= static_cast<double>(n);
+
+    std::vector<double> cov(d * d, 0.0);
+    for (std::size_t r = 0; r < n; ++r)
+        for (std::size_t i = 0; i < d; ++i)
+            for (std::size_t j = 0; j < d; ++j)
+                cov[i * d + j] += (rows[r * d + i] - mean[i]) * (rows[r * d + j] - mean[j]);
+    for (double& c : cov) c /= static_cast<double>(n - 1);
+    return cov;
+}
+
+static std::vector<double> make_rows(std::size_t n, std::size_t d, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    std::vector<double> rows(n * d);
+    for (std::size_t r = 0; r < n; ++r) {
+        const double common = dist(rng);
+        for (std::size_t j = 0; j < d; ++j) {
+            rows[r * d + j] = 10.0 * static_cast<double>(j) + common * static_cast<double>(j % 3) + dist(rng);
+        }
+    }
+    return rows;
+}
+
+TEST_CASE("OnlineCovarianceMatrix matches naive reference", "[covmatrix]") {
+    for (std::size_t d : {1u, 3u, 17u}) {
+        for (std::size_t n : {2u, 5u, 64u, 65u, 300u}) {
+            const auto rows = make_rows(n, d, static_cast<unsigned>(n * 31 + d));
+            fastnum::OnlineCovarianceMatrix<double> cm(d);
+            cm.observe(rows.data(), n);
+
+            const auto ref = naive_cov_matrix_sample(rows, n, d);
+            std::vector<double> got(d * d);
+            cm.covariance_matrix_sample(got.data());
+
+            REQUIRE(cm.count() == n);
+            for (std::size_t i = 0; i < d * d; ++i) {
+                REQUIRE(got[i] == Catch::Approx(ref[i]).epsilon(1e-10).margin(1e-12));
+            }
+        }
+    }
+}
+
+TEST_CASE("OnlineCovarianceMatrix agrees with pairwise OnlineCovariance", "[covmatrix]") {
+    constexpr std::size_t d = 5;
+    constexpr std::size_t n = 1000;
+    const auto rows = make_rows(n, d, 7);
+
+    fastnum::OnlineCovarianceMatrix<double, d> cm;
+    cm.observe(rows);
+
+    std::vector<double> corr(d * d);
+    cm.correlation_matrix(corr.data());
+
+    for (std::size_t i = 0; i < d; ++i) {
+        for (std::size_t j = 0; j < d; ++j) {
+            fastnum::OnlineCovariance<double> pair;
+            for (std::size_t r = 0; r < n; ++r) pair.observe(rows[r * d + i], rows[r * d + j]);
+
+            REQUIRE(cm.mean(i) == Catch::Approx(pair.mean_x()).epsilon(1e-12));
+            REQUIRE(cm.covariance_population(i, j) ==
+                    Catch::Approx(pair.covariance_population()).epsilon(1e-10).margin(1e-12));
+            REQUIRE(corr[i * d + j] == Catch::Approx(pair.correlation()).epsilon(1e-10).margin(1e-12));
+        }
+    }
+}
+
+TEST_CASE("OnlineCovarianceMatrix stream, strided and merge equivalence", "[covmatrix][merge]") {
+    constexpr std::size_t d = 9;
+    constexpr std::size_t n = 517;
+    const auto rows = make_rows(n, d, 99);
+
+    fastnum::OnlineCovarianceMatrix<double> all(d);
+    all.observe(rows.data(), n);
+
+    fastnum::OnlineCovarianceMatrix<double> stream(d);
+    for (std::size_t r = 0; r < n; ++r) stream.observe(rows.data() + r * d);
+
+    // Same data embedded in a wider matrix (leading dimension 12).
+    constexpr std::size_t ld = 12;
+    std::vector<double> wide(n * ld, -1e300);
+    for (std::size_t r = 0; r < n; ++r)
+        for (std::size_t j = 0; j < d; ++j) wide[r * ld + j] = rows[r * d + j];
+    fastnum::OnlineCovarianceMatrix<double> strided(d);
+    strided.observe(wide.data(), n, ld);
+
+    fastnum::OnlineCovarianceMatrix<double> a(d), b(d);
+    a.observe(rows.data(), 200);
+    b.observe(rows.data() + 200 * d, n - 200);
+    a.merge(b);
+
+    for (const auto* cm : {&stream, &strided, &a}) {
+        REQUIRE(cm->count() == all.count());
+        for (std::size_t i = 0; i < d; ++i) {
+            REQUIRE(cm->mean(i) == Catch::Approx(all.mean(i)).epsilon(1e-12));
+            for (std::size_t j = 0; j < d; ++j) {
+                REQUIRE(cm->covariance_sample(i, j) ==
+                        Catch::Approx(all.covariance_sample(i, j)).epsilon(1e-10).margin(1e-12));
+            }
+        }
+    }
+}
+
+TEST_CASE("OnlineCovarianceMatrix readiness and NaN policy", "[covmatrix]") {
+    fastnum::OnlineCovarianceMatrix<double, 2> cm;
+    REQUIRE_FALSE(cm.ready());
+    REQUIRE(std::isnan(cm.covariance_population(0, 1)));
+
+    const double r0[] = {1.0, 5.0};
+    cm.observe(r0);
+    REQUIRE_FALSE(cm.ready());
+    REQUIRE(cm.covariance_population(0, 1) == 0.0);
+    REQUIRE(std::isnan(cm.covariance_sample(0, 1)));
+
+    const double r1[] = {2.0, 5.0};
+    cm.observe(r1);
+    REQUIRE(cm.ready());
+    REQUIRE(cm.correlation(0, 0) == Catch::Approx(1.0));
+    REQUIRE(std::isnan(cm.correlation(0, 1))); // feature 1 is constant
+
+    cm.reset();
+    REQUIRE(cm.count() == 0);
+    REQUIRE(cm.mean(0) == 0.0);
+}
@@ -2,12 +2,14 @@
 #include <catch2/catch_approx.hpp>
 
 #include <fastnum/online_standard_scaler.hpp>
+#include <fastnum/exponential_stats.hpp>
 
 #include <random>
 #include <algorithm>
 #include <vector>
 #include <cmath>
 #include <cstddef>
+#include <type_traits>
 
 TEST_CASE("OnlineStandardScaler readiness") {
     fastnum::OnlineStandardScaler<double> scaler;
@@ -174,3 +176,359 @@ TEST_CASE("OnlineStandardScaler container observe overload works"){
     scaler.observe(data);
     REQUIRE(scaler.count() == data.size());
 }
+
+TEST_CASE("OnlineStandardScaler out-of-place transform matches scalar transform", "[scaler][transform]") {
+    std::mt19937 rng(31);
+    std::normal_distribution<double> dist(3.0, 1.5);
+
+    std::vector<double> data(1037);
+    std::generate(data.begin(), data.end(), [&]() { return dist(rng); });
+
+    fastnum::OnlineStandardScaler<double> scaler;
+    scaler.observe(data);
+    REQUIRE(scaler.ready());
+
+    const std::vector<double> original = data;
+    std::vector<double> out(data.size());
+    scaler.transform(data, out);
+    REQUIRE(data == original);
+
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        REQUIRE(out[i] == Catch::Approx(scaler.transform(data[i])).margin(1e-12));
+    }
+
+    std::vector<double> inplace = data;
+    scaler.transform_inplace(inplace);
+    REQUIRE(inplace == out);
+}
+
+TEST_CASE("OnlineStandardScaler<double> transforms float buffers", "[scaler][transform]") {
+    std::mt19937 rng(32);
+    std::normal_distribution<double> dist(-2.0, 4.0);
+
+    std::vector<double> fit(500);
+    std::generate(fit.begin(), fit.end(), [&]() { return dist(rng); });
+
+    fastnum::OnlineStandardScaler<double> scaler;
+    scaler.observe(fit);
+
+    std::vector<float> in(333);
+    for (std::size_t i = 0; i < in.size(); ++i) in[i] = static_cast<float>(fit[i]);
+    std::vector<float> out(in.size());
+    scaler.transform(in.data(), out.data(), in.size());
+
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        REQUIRE(out[i] == Catch::Approx(scaler.transform(static_cast<double>(in[i]))).margin(1e-5));
+    }
+}
+
+TEST_CASE("OnlineStandardScaler multi-threaded transform matches single-threaded", "[scaler][transform]") {
+    constexpr std::size_t N = 300001;
+
+    std::mt19937 rng(33);
+    std::normal_distribution<double> dist(0.0, 2.0);
+
+    std::vector<double> data(N);
+    std::generate(data.begin(), data.end(), [&]() { return dist(rng); });
+
+    fastnum::OnlineStandardScaler<double> scaler;
+    scaler.observe(data);
+
+    std::vector<double> serial(N), parallel(N);
+    scaler.transform(data.data(), serial.data(), N);
+    scaler.transform(data.data(), parallel.data(), N, 4);
+    REQUIRE(parallel == serial);
+}
+
+TEST_CASE("OnlineStandardScaler out-of-place transform fills NaN when not ready", "[scaler][transform]") {
+    fastnum::OnlineStandardScaler<double> scaler;
+    scaler.observe(1.0);
+
+    const std::vector<double> in{1.0, 2.0, 3.0};
+    std::vector<double> out(in.size(), 0.0);
+    scaler.transform(in.data(), out.data(), in.size());
+    for (double v : out) REQUIRE(std::isnan(v));
+
+    std::vector<double> par(in.size(), 0.0);
+    scaler.transform(in.data(), par.data(), in.size(), 2);
+    for (double v : par) REQUIRE(std::isnan(v));
+}
+
+TEST_CASE("FrozenStandardScaler matches live scaler and round-trips", "[scaler][freeze]") {
+    static_assert(std::is_trivially_copyable_v<fastnum::FrozenStandardScaler<double>>);
+    static_assert(sizeof(fastnum::FrozenStandardScaler<double>) == 2 * sizeof(double));
+
+    std::mt19937 rng(41);
+    std::normal_distribution<double> dist(5.0, 2.0);
+
+    std::vector<double> data(400);
+    std::generate(data.begin(), data.end(), [&]() { return dist(rng); });
+
+    fastnum::OnlineStandardScaler<double> scaler;
+    scaler.observe(data);
+    const auto frozen = scaler.freeze();
+    REQUIRE(frozen.ready());
+
+    for (double x : data) {
+        REQUIRE(frozen.transform(x) == scaler.transform(x));
+        REQUIRE(frozen.inverse_transform(frozen.transform(x)) == Catch::Approx(x).epsilon(1e-12));
+    }
+
+    std::vector<double> z(data.size()), back(data.size());
+    frozen.transform(data.data(), z.data(), data.size());
+    frozen.inverse_transform(z.data(), back.data(), z.size());
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        REQUIRE(z[i] == frozen.transform(data[i]));
+        REQUIRE(back[i] == Catch::Approx(data[i]).epsilon(1e-12));
+    }
+
+    // The snapshot is unaffected by further observations.
+    scaler.observe(100.0);
+    REQUIRE(frozen.transform(data[0]) != scaler.transform(data[0]));
+}
+
+TEST_CASE("FrozenStandardScaler from an unready scaler yields NaN", "[scaler][freeze]") {
+    fastnum::OnlineStandardScaler<double> scaler;
+    scaler.observe(2.0);
+    scaler.observe(2.0);
+
+    const auto frozen = scaler.freeze();
+    REQUIRE_FALSE(frozen.ready());
+    REQUIRE(std::isnan(frozen.transform(1.0)));
+    REQUIRE(std::isnan(frozen.inverse_transform(0.0)));
+}
+
+TEST_CASE("OnlineStandardScaler weighted observe forwards to the backend", "[scaler][weighted]") {
+    const std::vector<double> xs = {1.0, 2.0, 3.0, 10.0, -4.0};
+    const std::vector<double> ws = {3.0, 1.0, 0.0, 2.0, 5.0};
+
+    fastnum::OnlineStandardScaler<double> weighted, batch, repeated;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        weighted.observe(xs[i], ws[i]);
+        for (int k = 0; k < static_cast<int>(ws[i]); ++k) repeated.observe(xs[i]);
+    }
+    batch.observe(xs.data(), ws.data(), xs.size());
+
+    REQUIRE(weighted.count() == repeated.count());
+    REQUIRE(batch.count() == repeated.count());
+    REQUIRE(weighted.transform(2.5) == Catch::Approx(repeated.transform(2.5)));
+    REQUIRE(batch.transform(2.5) == Catch::Approx(repeated.transform(2.5)));
+
+    fastnum::OnlineStandardScaler<double> summary;
+    summary.observe_summary(repeated.stats().count(), repeated.stats().mean(), repeated.stats().m2());
+    REQUIRE(summary.transform(2.5) == Catch::Approx(repeated.transform(2.5)));
+}
+
+TEST_CASE("OnlineStandardScaler merge_many equals observe-all-at-once", "[scaler][merge]") {
+    std::mt19937 rng(77);
+    std::normal_distribution<double> dist(5.0, 2.0);
+
+    std::vector<fastnum::OnlineStandardScaler<double>> parts(150); // > one staging buffer
+    fastnum::OnlineStandardScaler<double> all;
+    for (std::size_t p = 0; p < parts.size(); ++p) {
+        for (std::size_t i = 0; i < p % 5; ++i) {
+            const double x = dist(rng);
+            parts[p].observe(x);
+            all.observe(x);
+        }
+    }
+
+    fastnum::OnlineStandardScaler<double> many;
+    many.merge_many(parts);
+    REQUIRE(many.count() == all.count());
+    REQUIRE(many.mean() == Catch::Approx(all.mean()).epsilon(1e-12));
+    REQUIRE(many.transform(7.0) == Catch::Approx(all.transform(7.0)).epsilon(1e-10));
+}
+
+namespace {
+
+// Reference for the prequential mode: transform with the prior state, then observe.
+template <class Scaler, class T>
+std::vector<T> prequential_reference(Scaler& scaler, const std::vector<T>& xs) {
+    std::vector<T> out(xs.size());
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        out[i] = scaler.transform(xs[i]);
+        scaler.observe(xs[i]);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("OnlineStandardScaler observe_and_transform prequential matches transform-then-observe", "[scaler][fused]") {
+    std::mt19937 rng(2024);
+    std::normal_distribution<double> dist(1e3, 4.0); // large offset exercises the shifted prefix sums
+
+    for (std::size_t n : {std::size_t{1}, std::size_t{3}, std::size_t{17}, std::size_t{255}, std::size_t{256},
+                          std::size_t{1000}}) {
+        std::vector<double> xs(n);
+        for (auto& x : xs) x = dist(rng);
+        // Warm states: empty, one sample, two samples and already ready.
+        for (std::size_t warm : {std::size_t{0}, std::size_t{1}, std::size_t{2}, std::size_t{50}}) {
+            fastnum::OnlineStandardScaler<double> ref, fused;
+            for (std::size_t i = 0; i < warm; ++i) {
+                const double w = dist(rng);
+                ref.observe(w);
+                fused.observe(w);
+            }
+            const auto expected = prequential_reference(ref, xs);
+            std::vector<double> out(n);
+            fused.observe_and_transform(xs.data(), out.data(), n);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                if (std::isnan(expected[i])) {
+                    REQUIRE(std::isnan(out[i]));
+                } else {
+                    REQUIRE(out[i] == Catch::Approx(expected[i]).epsilon(1e-8).margin(1e-9));
+                }
+            }
+            REQUIRE(fused.count() == ref.count());
+            REQUIRE(fused.mean() == Catch::Approx(ref.mean()).epsilon(1e-12));
+            REQUIRE(fused.stats().m2() == Catch::Approx(ref.stats().m2()).epsilon(1e-9));
+        }
+    }
+}
+
+TEST_CASE("OnlineStandardScaler observe_and_transform first outputs are NaN", "[scaler][fused]") {
+    const std::vector<double> xs = {1.0, 1.0, 2.0, 3.0, 4.0};
+    std::vector<double> out(xs.size());
+    fastnum::OnlineStandardScaler<double> scaler;
+    scaler.observe_and_transform(xs, out);
+
+    REQUIRE(std::isnan(out[0])); // nothing seen
+    REQUIRE(std::isnan(out[1])); // one sample
+    REQUIRE(std::isnan(out[2])); // {1, 1}: zero variance
+    REQUIRE(out[3] == Catch::Approx((3.0 - 4.0 / 3.0) / std::sqrt(2.0 / 9.0)));
+    REQUIRE(scaler.count() == xs.size());
+}
+
+TEST_CASE("OnlineStandardScaler observe_and_transform post_batch equals observe then transform", "[scaler][fused]") {
+    std::mt19937 rng(5);
+    std::normal_distribution<float> dist(-2.0f, 3.0f);
+    std::vector<float> xs(333);
+    for (auto& x : xs) x = dist(rng);
+
+    fastnum::OnlineStandardScaler<float> ref, fused;
+    ref.observe(xs.data(), xs.size());
+    std::vector<float> expected(xs.size());
+    ref.transform(xs.data(), expected.data(), xs.size());
+
+    std::vector<float> out(xs.size());
+    fused.observe_and_transform(xs.data(), out.data(), xs.size(), fastnum::fused_mode::post_batch);
+    REQUIRE(fused.count() == ref.count());
+    for (std::size_t i = 0; i < xs.size(); ++i) REQUIRE(out[i] == expected[i]);
+}
+
+TEST_CASE("OnlineStandardScaler observe_and_transform works in place", "[scaler][fused]") {
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<double> dist(0.0, 10.0);
+    std::vector<double> xs(600);
+    for (auto& x : xs) x = dist(rng);
+
+    for (auto mode : {fastnum::fused_mode::prequential, fastnum::fused_mode::post_batch}) {
+        fastnum::OnlineStandardScaler<double> ref, fused;
+        std::vector<double> out(xs.size());
+        ref.observe_and_transform(xs.data(), out.data(), xs.size(), mode);
+
+        auto buf = xs;
+        fused.observe_and_transform(buf.data(), buf.data(), buf.size(), mode);
+        for (std::size_t i = 0; i < xs.size(); ++i) {
+            if (std::isnan(out[i])) {
+                REQUIRE(std::isnan(buf[i]));
+            } else {
+                REQUIRE(buf[i] == Catch::Approx(out[i]));
+            }
+        }
+        REQUIRE(fused.mean() == Catch::Approx(ref.mean()));
+    }
+}
+
+TEST_CASE("OnlineStandardScaler observe_and_transform falls back for non-moment backends", "[scaler][fused]") {
+    std::mt19937 rng(13);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    std::vector<double> xs(100);
+    for (auto& x : xs) x = dist(rng);
+
+    using Scaler = fastnum::OnlineStandardScaler<double, fastnum::ExponentialStats<double>>;
+    Scaler ref, fused;
+    const auto expected = prequential_reference(ref, xs);
+    std::vector<double> out(xs.size());
+    fused.observe_and_transform(xs.data(), out.data(), xs.size());
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        if (std::isnan(expected[i])) {
+            REQUIRE(std::isnan(out[i]));
+        } else {
+            REQUIRE(out[i] == expected[i]);
+        }
+    }
+}
+
+TEST_CASE("OnlineStandardScaler observe_and_transform keeps a compensated backend exact", "[scaler][fused]") {
+    using Stats = fastnum::RunningStats<float, fastnum::compensated_policy<>>;
+    std::vector<float> xs(1 << 16);
+    for (std::size_t i = 0; i < xs.size(); ++i) xs[i] = 1000.0f + static_cast<float>(i % 97) * 0.01f;
+
+    fastnum::OnlineStandardScaler<float, Stats> ref, fused;
+    ref.observe(xs.data(), 100);
+    fused.observe(xs.data(), 100);
+    std::vector<float> out(xs.size());
+    fused.observe_and_transform(xs.data() + 100, out.data(), xs.size() - 100);
+    ref.observe(xs.data() + 100, xs.size() - 100);
+
+    // The state is the backend's own compensated batch observe.
+    REQUIRE(fused.count() == ref.count());
+    REQUIRE(fused.mean() == ref.mean());
+    REQUIRE(fused.stats().m2() == ref.stats().m2());
+    REQUIRE(std::isfinite(out[0]));
+}
+
+TEST_CASE("OnlineStandardScaler observe_strided forwards to the backend", "[scaler][batch]") {
+    std::vector<double> rows(4 * 50);
+    for (std::size_t i = 0; i < rows.size(); ++i) rows[i] = static_cast<double>(i % 13);
+    std::vector<double> col;
+    for (std::size_t i = 2; i < rows.size(); i += 4) col.push_back(rows[i]);
+
+    fastnum::OnlineStandardScaler<double> strided, contiguous;
+    strided.observe_strided(rows.data() + 2, 4, col.size());
+    contiguous.observe(col);
+    REQUIRE(strided.count() == contiguous.count());
+    REQUIRE(strided.transform(3.0) == contiguous.transform(3.0));
+}
+
+TEST_CASE("OnlineStandardScaler with a skipping backend ignores non-finite inputs", "[scaler][nan]") {
+    using Stats = fastnum::RunningStats<double, fastnum::nan_handling_policy<fastnum::nan_policy::count_and_skip>>;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<double> xs = {1.0, nan, 2.0, 3.0, nan, 4.0};
+
+    fastnum::OnlineStandardScaler<double, Stats> scaler;
+    scaler.observe(xs);
+    REQUIRE(scaler.count() == 4);
+    REQUIRE(scaler.skipped() == 2);
+    REQUIRE(scaler.mean() == Catch::Approx(2.5));
+
+    fastnum::OnlineStandardScaler<double, Stats> fused;
+    std::vector<double> out(xs.size());
+    fused.observe_and_transform(xs, out);
+    REQUIRE(fused.skipped() == 2);
+    REQUIRE(std::isnan(out[1]));
+    REQUIRE(std::isnan(out[2])); // one finite sample before it
+    REQUIRE(out[3] == Catch::Approx((3.0 - 1.5) / 0.5));
+    REQUIRE(std::isnan(out[4]));
+    REQUIRE(fused.mean() == Catch::Approx(2.5));
+}
+
+TEST_CASE("OnlineStandardScaler<double> fits float data without a copy", "[scaler][precision]") {
+    std::vector<float> xs(1000);
+    for (std::size_t i = 0; i < xs.size(); ++i) xs[i] = static_cast<float>(i % 10) + 0.25f;
+    fastnum::OnlineStandardScaler<double> scaler;
+    scaler.observe(xs);
+    scaler.observe(xs.data(), 10);
+    REQUIRE(scaler.count() == 1010);
+    REQUIRE(scaler.mean() == Catch::Approx(4.75));
+
+    // Compensated float state through the Stats parameter.
+    fastnum::OnlineStandardScaler<float, fastnum::RunningStats<float, fastnum::compensated_policy<>>> kahan;
+    kahan.observe(xs);
+    REQUIRE(kahan.mean() == Catch::Approx(4.75f));
+    REQUIRE(kahan.ready());
+}
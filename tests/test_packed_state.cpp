@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/packed_state.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Stand-in for MPI_Datatype; the op must convert to MPI_User_function*.
+struct fake_datatype {};
+
+} // namespace
+
+TEST_CASE("packed RunningStats buffers reduce like per-feature merges", "[packed_state]") {
+    using Stats = fastnum::RunningStats<double>;
+    std::mt19937 rng(801);
+    std::normal_distribution<double> dist(50.0, 8.0);
+
+    // Three "ranks", 1000 features (not a tile multiple); some features are
+    // empty on some ranks.
+    constexpr std::size_t features = 1000;
+    constexpr std::size_t ranks = 3;
+    std::vector<std::vector<Stats>> local(ranks, std::vector<Stats>(features));
+    std::vector<Stats> ref(features);
+    for (std::size_t r = 0; r < ranks; ++r) {
+        for (std::size_t f = 0; f < features; ++f) {
+            if ((f + r) % 7 == 0) continue;
+            for (std::size_t k = 0; k < 1 + (f * 3 + r) % 5; ++k) local[r][f].observe(dist(rng) + 0.01 * f);
+        }
+    }
+    for (std::size_t r = 0; r < ranks; ++r) {
+        for (std::size_t f = 0; f < features; ++f) ref[f].merge(local[r][f]);
+    }
+
+    std::vector<fastnum::packed_states<Stats>> packed;
+    for (const auto& l : local) packed.emplace_back(l.data(), l.size());
+    REQUIRE(packed[0].size() == features);
+    REQUIRE(packed[0].tile_count() == fastnum::packed_tile_count(features));
+    REQUIRE(packed[0].bytes() == packed[0].tile_count() * sizeof(fastnum::packed_tile<Stats>));
+    REQUIRE(packed[0][5].mean() == local[0][5].mean());
+
+    // Rank 0 reduces through the MPI-style callback, in two chunks as a
+    // pipelined collective would.
+    void (*op)(void*, void*, int*, fake_datatype*) = &fastnum::packed_reduce_op<Stats, fake_datatype>;
+    for (std::size_t r = 1; r < ranks; ++r) {
+        int first = 20;
+        int rest = static_cast<int>(packed[0].tile_count()) - first;
+        op(packed[r].data(), packed[0].data(), &first, nullptr);
+        op(packed[r].data() + first, packed[0].data() + first, &rest, nullptr);
+    }
+
+    std::vector<Stats> out(features);
+    packed[0].unpack(out.data(), out.size());
+    for (std::size_t f = 0; f < features; ++f) {
+        REQUIRE(out[f].count() == ref[f].count());
+        REQUIRE(out[f].mean() == Catch::Approx(ref[f].mean()).epsilon(1e-12));
+        REQUIRE(out[f].m2() == Catch::Approx(ref[f].m2()).epsilon(1e-10).margin(1e-12));
+    }
+
+    // Lanes empty on one side are copied exactly.
+    REQUIRE(local[1][6].count() == 0);
+    fastnum::packed_states<Stats> a(local[1].data(), features);
+    a.merge(packed[2]);
+    REQUIRE(a[6].mean() == local[2][6].mean());
+    REQUIRE(a[6].m2() == local[2][6].m2());
+}
+
+TEST_CASE("packed OnlineCovariance buffers reduce like per-pair merges", "[packed_state]") {
+    using Cov = fastnum::OnlineCovariance<float>;
+    std::mt19937 rng(802);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+
+    constexpr std::size_t pairs = 37;
+    std::vector<Cov> a(pairs), b(pairs), ref(pairs);
+    for (std::size_t p = 0; p < pairs; ++p) {
+        for (std::size_t k = 0; k < 20; ++k) {
+            const float x = dist(rng);
+            const float y = 0.3f * static_cast<float>(p % 5) * x + dist(rng);
+            (k % 3 == 0 ? a : b)[p].observe(x, y);
+        }
+        ref[p] = a[p];
+        ref[p].merge(b[p]);
+    }
+
+    fastnum::packed_states<Cov> pa(a.data(), pairs);
+    const fastnum::packed_states<Cov> pb(b.data(), pairs);
+    fastnum::packed_merge<Cov>(pb.data(), pa.data(), pa.tile_count());
+    for (std::size_t p = 0; p < pairs; ++p) {
+        const Cov c = pa[p];
+        REQUIRE(c.count() == 20);
+        REQUIRE(c.mean_x() == Catch::Approx(ref[p].mean_x()).epsilon(1e-5).margin(1e-6));
+        REQUIRE(c.covariance_sample() == Catch::Approx(ref[p].covariance_sample()).epsilon(1e-4).margin(1e-6));
+        REQUIRE(c.correlation() == Catch::Approx(ref[p].correlation()).epsilon(1e-4).margin(1e-6));
+    }
+}
+
+TEST_CASE("packed_states keeps padding lanes empty", "[packed_state]") {
+    using Stats = fastnum::RunningStats<double>;
+    std::vector<Stats> wide(40), narrow(20);
+    for (std::size_t i = 0; i < wide.size(); ++i) wide[i].observe(static_cast<double>(i));
+
+    fastnum::packed_states<Stats> small(narrow.data(), narrow.size());
+    small.merge(fastnum::packed_states<Stats>(std::span<const Stats>(wide)));
+    REQUIRE(small.size() == 20);
+    REQUIRE(small[19].mean() == 19.0);
+
+    // Lanes 20..31 of the last tile were not taken over from `wide`.
+    const auto& last = small.data()[1];
+    for (std::size_t l = 20 - fastnum::packed_lanes; l < fastnum::packed_lanes; ++l) REQUIRE(last.n[l] == 0);
+
+    small.reset();
+    REQUIRE(small.size() == 20);
+    REQUIRE(small[3].count() == 0);
+
+    // Counts far beyond 2^32 convert exactly in the SIMD merge.
+    const std::size_t big = (std::size_t{1} << 44) + 3;
+    const Stats lo = Stats::from_moments(big, 1.0, 0.0);
+    const Stats hi = Stats::from_moments(big + 2, 3.0, 0.0);
+    fastnum::packed_states<Stats> pl(&lo, 1);
+    pl.merge(fastnum::packed_states<Stats>(&hi, 1));
+    Stats ref = lo;
+    ref.merge(hi);
+    REQUIRE(pl[0].count() == 2 * big + 2);
+    REQUIRE(pl[0].mean() == Catch::Approx(ref.mean()).epsilon(1e-15));
+    REQUIRE(pl[0].m2() == Catch::Approx(ref.m2()).epsilon(1e-15));
+
+    // Compensation terms are folded in when packing.
+    using Comp = fastnum::RunningStats<float, fastnum::compensated_policy<>>;
+    Comp c;
+    for (int i = 0; i < 1000; ++i) c.observe(0.1f * static_cast<float>(i));
+    const fastnum::packed_states<Comp> pc(&c, 1);
+    REQUIRE(pc[0].mean() == c.mean());
+    REQUIRE(pc[0].m2() == c.m2());
+}
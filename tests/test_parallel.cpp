@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/parallel.hpp>
+#include <fastnum/running_stats.hpp>
+#include <fastnum/online_standard_scaler.hpp>
+#include <fastnum/online_covariance.hpp>
+#include <fastnum/exponential_stats.hpp>
+#include <fastnum/histogram.hpp>
+#include <fastnum/quantile_sketch.hpp>
+
+#include <random>
+#include <vector>
+#include <cstddef>
+
+TEST_CASE("parallel_observe RunningStats matches serial fit", "[parallel]") {
+    constexpr std::size_t N = 100003;
+
+    std::mt19937 rng(51);
+    std::normal_distribution<double> dist(1e3, 5.0);
+    std::vector<double> xs(N);
+    for (double& x : xs) x = dist(rng);
+
+    fastnum::RunningStats<double> serial;
+    serial.observe(xs);
+
+    // Small chunks so that several threads and tree levels are exercised.
+    for (std::size_t threads : {1u, 2u, 3u, 7u, 16u}) {
+        fastnum::RunningStats<double> par;
+        fastnum::parallel_observe({threads, 1000}, par, xs);
+
+        REQUIRE(par.count() == N);
+        REQUIRE(par.mean() == Catch::Approx(serial.mean()).epsilon(1e-12));
+        REQUIRE(par.variance_sample() == Catch::Approx(serial.variance_sample()).epsilon(1e-10));
+    }
+}
+
+TEST_CASE("parallel_observe appends to an already fitted scaler", "[parallel]") {
+    std::mt19937 rng(52);
+    std::normal_distribution<double> dist(-3.0, 2.0);
+    std::vector<double> head(50), xs(20000);
+    for (double& x : head) x = dist(rng);
+    for (double& x : xs) x = dist(rng);
+
+    fastnum::OnlineStandardScaler<double> serial;
+    serial.observe(head);
+    serial.observe(xs);
+
+    fastnum::OnlineStandardScaler<double> par;
+    par.observe(head);
+    fastnum::parallel_observe({4, 512}, par, xs.data(), xs.size());
+
+    REQUIRE(par.count() == serial.count());
+    REQUIRE(par.mean() == Catch::Approx(serial.mean()).epsilon(1e-12));
+    REQUIRE(par.transform(1.0) == Catch::Approx(serial.transform(1.0)).epsilon(1e-10));
+}
+
+TEST_CASE("parallel_observe OnlineCovariance matches serial fit", "[parallel][covariance]") {
+    constexpr std::size_t N = 50001;
+
+    std::mt19937 rng(53);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    std::vector<double> xs(N), ys(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        xs[i] = dist(rng);
+        ys[i] = 0.3 * xs[i] + dist(rng);
+    }
+
+    fastnum::OnlineCovariance<double> serial;
+    serial.observe(xs, ys);
+
+    fastnum::OnlineCovariance<double> par;
+    fastnum::parallel_observe({5, 1024}, par, xs, ys);
+
+    REQUIRE(par.count() == N);
+    REQUIRE(par.mean_x() == Catch::Approx(serial.mean_x()).epsilon(1e-10).margin(1e-12));
+    REQUIRE(par.covariance_sample() == Catch::Approx(serial.covariance_sample()).epsilon(1e-10));
+    REQUIRE(par.correlation() == Catch::Approx(serial.correlation()).epsilon(1e-10));
+}
+
+TEST_CASE("parallel_observe handles empty and tiny inputs", "[parallel]") {
+    fastnum::RunningStats<double> rs;
+    fastnum::parallel_observe({}, rs, static_cast<const double*>(nullptr), 0);
+    REQUIRE(rs.count() == 0);
+
+    const std::vector<double> xs{1.0, 2.0, 3.0};
+    fastnum::parallel_observe({8, 1}, rs, xs);
+    REQUIRE(rs.count() == 3);
+    REQUIRE(rs.mean() == Catch::Approx(2.0));
+    REQUIRE(rs.variance_sample() == Catch::Approx(1.0));
+}
+
+TEST_CASE("parallel_observe keeps the configuration of acc", "[parallel]") {
+    std::mt19937 rng(52);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    std::vector<double> xs(200000);
+    for (double& x : xs) x = dist(rng);
+
+    // Parts are empty copies of acc, so they use its k, not the default one.
+    fastnum::QuantileSketch<double> serial(2000), par(2000);
+    serial.observe(xs);
+    fastnum::parallel_observe({4, 1000}, par, xs);
+    REQUIRE(par.k() == 2000);
+    REQUIRE(par.count() == xs.size());
+    REQUIRE(par.retained() > serial.retained() / 2);
+    REQUIRE(par.quantile(0.5) == Catch::Approx(serial.quantile(0.5)).margin(0.01));
+
+    // Histograms have no default constructor; the parts take acc's range.
+    fastnum::Histogram<double, 32> hs(-3.0, 3.0), hp(-3.0, 3.0);
+    hs.observe(xs);
+    hp.observe(1.0);
+    fastnum::parallel_observe({4, 1000}, hp, xs);
+    REQUIRE(hp.count() == xs.size() + 1);
+    for (std::size_t i = 0; i < 32; ++i) REQUIRE(hp.bin_count(i) == hs.bin_count(i) + (i == 21 ? 1 : 0));
+
+    // Decayed state depends on sample order: no chunked fits.
+    static_assert(fastnum::detail::order_sensitive_v<fastnum::ExponentialStats<double>>);
+    static_assert(fastnum::OnlineStandardScaler<double, fastnum::ExponentialStats<double>>::order_sensitive);
+    static_assert(!fastnum::detail::order_sensitive_v<fastnum::QuantileSketch<double>>);
+}
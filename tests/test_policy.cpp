@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/policy.hpp>
+#include <fastnum/running_stats.hpp>
+#include <fastnum/online_covariance.hpp>
+#include <fastnum/online_standard_scaler.hpp>
+#include <fastnum/exponential_stats.hpp>
+#include <fastnum/serialization.hpp>
+
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// Variance threshold of 0.5^2: ready only for visibly spread data.
+struct loose_policy : fastnum::default_policy {
+    template <class T>
+    static constexpr T eps = static_cast<T>(0.5);
+};
+
+} // namespace
+
+TEST_CASE("Accumulator sizes are fixed per configuration", "[policy]") {
+    STATIC_REQUIRE(sizeof(fastnum::RunningStats<double>) == 24);
+    STATIC_REQUIRE(sizeof(fastnum::RunningStats<float>) == 16);
+    STATIC_REQUIRE(sizeof(fastnum::RunningStats<float, fastnum::compact_policy>) == 12);
+    STATIC_REQUIRE(sizeof(fastnum::RunningStats<double, fastnum::compact_policy>) == 24);
+
+    // No per-instance epsilon.
+    STATIC_REQUIRE(sizeof(fastnum::OnlineCovariance<double>) == 48);
+    STATIC_REQUIRE(sizeof(fastnum::OnlineCovariance<float, fastnum::compact_policy>) == 24);
+    STATIC_REQUIRE(sizeof(fastnum::OnlineStandardScaler<double>) == 24);
+    STATIC_REQUIRE(sizeof(fastnum::OnlineStandardScaler<double, fastnum::RunningStats<double, loose_policy>>) == 24);
+
+    STATIC_REQUIRE(std::is_same_v<fastnum::RunningStats<float, fastnum::compact_policy>::count_type, std::uint32_t>);
+    STATIC_REQUIRE(std::is_trivially_copyable_v<fastnum::OnlineCovariance<float, fastnum::compact_policy>>);
+}
+
+TEST_CASE("Compact counts give the same statistics", "[policy]") {
+    std::mt19937 rng(301);
+    std::normal_distribution<float> dist(1.0f, 2.0f);
+    std::vector<float> xs(3001);
+    for (float& x : xs) x = dist(rng);
+
+    fastnum::RunningStats<float> wide;
+    fastnum::RunningStats<float, fastnum::compact_policy> compact;
+    wide.observe(xs);
+    compact.observe(xs.data(), 1000);
+    fastnum::RunningStats<float, fastnum::compact_policy> rest;
+    rest.observe(xs.data() + 1000, xs.size() - 1000);
+    compact.merge(rest);
+
+    REQUIRE(compact.count() == wide.count());
+    REQUIRE(compact.mean() == Catch::Approx(wide.mean()).epsilon(1e-5));
+    REQUIRE(compact.variance_sample() == Catch::Approx(wide.variance_sample()).epsilon(1e-4));
+
+    fastnum::OnlineCovariance<float, fastnum::compact_policy> cov;
+    cov.observe(xs.data(), xs.data(), xs.size());
+    REQUIRE(cov.count() == xs.size());
+    REQUIRE(cov.correlation() == Catch::Approx(1.0f));
+}
+
+TEST_CASE("Readiness epsilon comes from the policy", "[policy]") {
+    const double xs[] = {1.0, 1.1, 0.9, 1.0};
+
+    fastnum::OnlineStandardScaler<double> strict;
+    fastnum::OnlineStandardScaler<double, fastnum::RunningStats<double, loose_policy>> loose;
+    strict.observe(xs, 4);
+    loose.observe(xs, 4);
+    REQUIRE(strict.ready());
+    REQUIRE_FALSE(loose.ready()); // variance 0.005 <= 0.25
+
+    fastnum::OnlineCovariance<double, loose_policy> cov;
+    cov.observe(xs, xs, 4);
+    REQUIRE_FALSE(cov.ready());
+
+    // Backends without a policy_type fall back to default_policy.
+    STATIC_REQUIRE(std::is_same_v<fastnum::detail::policy_of_t<int>, fastnum::default_policy>);
+    STATIC_REQUIRE(std::is_same_v<fastnum::detail::policy_of_t<fastnum::ExponentialStats<double, loose_policy>>,
+                                  loose_policy>);
+}
+
+TEST_CASE("Serialized states are portable across count types", "[policy][serialization]") {
+    fastnum::RunningStats<double, fastnum::compact_policy> compact;
+    for (double x : {1.0, 2.0, 4.0}) compact.observe(x);
+
+    unsigned char buf[64];
+    const std::size_t n = fastnum::to_bytes(compact, buf, sizeof buf);
+    REQUIRE(n == fastnum::serialized_size<fastnum::RunningStats<double>>(1));
+
+    fastnum::RunningStats<double> wide;
+    REQUIRE(fastnum::from_bytes(buf, n, wide) == fastnum::state_error::none);
+    REQUIRE(wide.count() == 3);
+    REQUIRE(wide.m2() == compact.m2());
+}
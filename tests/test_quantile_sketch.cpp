@@ -0,0 +1,171 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/quantile_sketch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+// --- Exact reference on a sorted copy ---
+
+static double true_rank(const std::vector<double>& sorted, double x) {
+    const auto it = std::upper_bound(sorted.begin(), sorted.end(), x);
+    return static_cast<double>(it - sorted.begin()) / static_cast<double>(sorted.size());
+}
+
+static std::vector<double> lognormal_data(std::size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::lognormal_distribution<double> dist(0.0, 1.5);
+    std::vector<double> xs(n);
+    for (double& x : xs) x = dist(rng);
+    return xs;
+}
+
+// Worst rank error of the sketch's quantiles over a grid of q.
+static double max_rank_error(const fastnum::QuantileSketch<double>& s, std::vector<double> xs) {
+    std::sort(xs.begin(), xs.end());
+    double worst = 0.0;
+    for (int i = 1; i < 100; ++i) {
+        const double q = i / 100.0;
+        worst = std::max(worst, std::abs(true_rank(xs, s.quantile(q)) - q));
+        worst = std::max(worst, std::abs(s.rank(xs[static_cast<std::size_t>(q * xs.size())]) -
+                                         true_rank(xs, xs[static_cast<std::size_t>(q * xs.size())])));
+    }
+    return worst;
+}
+
+TEST_CASE("QuantileSketch is exact while nothing was compacted", "[quantile]") {
+    fastnum::QuantileSketch<double> s;
+    REQUIRE_FALSE(s.ready());
+    REQUIRE(std::isnan(s.quantile(0.5)));
+    REQUIRE(std::isnan(s.rank(1.0)));
+
+    for (int i = 1; i <= 101; ++i) s.observe(static_cast<double>(i));
+    REQUIRE(s.ready());
+    REQUIRE(s.count() == 101);
+    REQUIRE(s.retained() == 101);
+    REQUIRE(s.quantile(0.5) == 51.0);
+    REQUIRE(s.quantile(0.0) == 1.0);
+    REQUIRE(s.quantile(1.0) == 101.0);
+    REQUIRE(s.rank(51.0) == Catch::Approx(51.0 / 101.0));
+    REQUIRE(s.min() == 1.0);
+    REQUIRE(s.max() == 101.0);
+}
+
+TEST_CASE("QuantileSketch stays within its documented rank error", "[quantile]") {
+    using S = fastnum::QuantileSketch<double>;
+    const auto xs = lognormal_data(200000, 501);
+
+    S s;
+    for (double x : xs) s.observe(x);
+
+    REQUIRE(s.count() == xs.size());
+    REQUIRE(s.retained() <= S::required_capacity(s.k()));
+    REQUIRE(max_rank_error(s, xs) < S::normalized_rank_error(s.k()));
+    REQUIRE(s.min() == *std::min_element(xs.begin(), xs.end()));
+    REQUIRE(s.max() == *std::max_element(xs.begin(), xs.end()));
+
+    // Smaller k: larger, still bounded error.
+    S small(64);
+    small.observe(xs.data(), xs.size());
+    REQUIRE(small.retained() <= S::required_capacity(64));
+    REQUIRE(max_rank_error(small, xs) < S::normalized_rank_error(64));
+}
+
+TEST_CASE("QuantileSketch batch observe matches scalar observe", "[quantile]") {
+    auto xs = lognormal_data(30001, 502);
+    xs[17] = std::numeric_limits<double>::quiet_NaN();
+
+    fastnum::QuantileSketch<double> a, b;
+    for (double x : xs) a.observe(x);
+    b.observe(xs); // container overload
+
+    REQUIRE(a.count() == xs.size() - 1); // NaN ignored
+    REQUIRE(b.count() == a.count());
+    REQUIRE(b.retained() == a.retained());
+    for (double q : {0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99}) REQUIRE(b.quantile(q) == a.quantile(q));
+}
+
+TEST_CASE("QuantileSketch batch observe does not compact for trailing NaNs", "[quantile]") {
+    constexpr std::size_t k = 8;
+    auto xs = lognormal_data(fastnum::QuantileSketch<double>::required_capacity(k), 503);
+    xs.push_back(std::numeric_limits<double>::quiet_NaN());
+    xs.push_back(std::numeric_limits<double>::quiet_NaN());
+
+    fastnum::QuantileSketch<double> a(k), b(k);
+    for (double x : xs) a.observe(x);
+    b.observe(xs.data(), xs.size());
+
+    REQUIRE(b.count() == a.count());
+    REQUIRE(b.retained() == a.retained());
+    for (double q : {0.1, 0.5, 0.9}) REQUIRE(b.quantile(q) == a.quantile(q));
+}
+
+TEST_CASE("QuantileSketch merge keeps the error bound", "[quantile]") {
+    using S = fastnum::QuantileSketch<double>;
+    const auto xs = lognormal_data(120000, 503);
+
+    std::vector<S> parts(6);
+    for (std::size_t i = 0; i < xs.size(); ++i) parts[i % parts.size()].observe(xs[i]);
+
+    S merged;
+    for (const auto& p : parts) merged.merge(p);
+    REQUIRE(merged.count() == xs.size());
+    REQUIRE(merged.retained() <= S::required_capacity(merged.k()));
+    REQUIRE(max_rank_error(merged, xs) < S::normalized_rank_error(merged.k()));
+
+    // Merging into a small sketch, and into itself.
+    S tiny(16);
+    tiny.observe(xs.data(), 5000);
+    tiny.merge(parts[0]);
+    REQUIRE(tiny.count() == 5000 + parts[0].count());
+    REQUIRE(tiny.retained() <= S::required_capacity(16));
+
+    S twice = parts[1];
+    twice.merge(twice);
+    REQUIRE(twice.count() == 2 * parts[1].count());
+    REQUIRE(twice.quantile(0.5) == Catch::Approx(parts[1].quantile(0.5)).epsilon(0.05));
+
+    S empty;
+    merged.merge(empty);
+    REQUIRE(merged.count() == xs.size());
+}
+
+TEST_CASE("QuantileSketch on a caller buffer never allocates past it", "[quantile]") {
+    using S = fastnum::QuantileSketch<double>;
+    std::vector<double> buffer(S::required_capacity(100));
+
+    S s(buffer.data(), buffer.size());
+    REQUIRE(s.k() == 100);
+    REQUIRE(S::k_for_capacity(S::required_capacity(100) - 1) == 99);
+    REQUIRE(S::k_for_capacity(3) == 0);
+
+    const auto xs = lognormal_data(50000, 504);
+    s.observe(xs.data(), xs.size());
+    REQUIRE(s.retained() <= S::required_capacity(100));
+    REQUIRE(max_rank_error(s, xs) < S::normalized_rank_error(100));
+
+    // Copies own their storage; moves keep the borrowed buffer.
+    S copy = s;
+    s.reset();
+    REQUIRE_FALSE(s.ready());
+    REQUIRE(copy.count() == xs.size());
+    REQUIRE(max_rank_error(copy, xs) < S::normalized_rank_error(100));
+
+    S moved = std::move(copy);
+    REQUIRE(moved.count() == xs.size());
+}
+
+TEST_CASE("QuantileSketch sizing is compile-time", "[quantile]") {
+    using S = fastnum::QuantileSketch<float>;
+    STATIC_REQUIRE(S::required_capacity(200) < 3 * 200 + 500);
+    STATIC_REQUIRE(S::k_for_capacity(S::required_capacity(200)) == 200);
+
+    S s(32);
+    for (int i = 0; i < 100000; ++i) s.observe(static_cast<float>(i % 1000));
+    REQUIRE(s.quantile(0.5f) == Catch::Approx(500.0f).margin(1000.0f * S::normalized_rank_error(32)));
+}
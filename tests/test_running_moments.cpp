@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/running_moments.hpp>
+#include <fastnum/running_stats.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// --- Naive two-pass reference ---
+
+struct NaiveMoments {
+    double mean, m2, m3, m4;
+};
+
+static NaiveMoments naive_moments(const std::vector<double>& xs) {
+    double mean = 0.0;
+    for (double x : xs) mean += x;
+    mean /= static_cast<double>(xs.size());
+    NaiveMoments r{mean, 0.0, 0.0, 0.0};
+    for (double x : xs) {
+        const double d = x - mean;
+        r.m2 += d * d;
+        r.m3 += d * d * d;
+        r.m4 += d * d * d * d;
+    }
+    return r;
+}
+
+static std::vector<double> gamma_data(std::size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::gamma_distribution<double> dist(2.0, 3.0); // skewed, heavy right tail
+    std::vector<double> xs(n);
+    for (double& x : xs) x = 100.0 + dist(rng);
+    return xs;
+}
+
+TEST_CASE("RunningMoments matches two-pass moments", "[moments]") {
+    const auto xs = gamma_data(5000, 401);
+    const auto ref = naive_moments(xs);
+
+    fastnum::RunningMoments<double> m;
+    for (double x : xs) m.observe(x);
+
+    REQUIRE(m.count() == xs.size());
+    REQUIRE(m.mean() == Catch::Approx(ref.mean).epsilon(1e-12));
+    REQUIRE(m.moment_sum<2>() == Catch::Approx(ref.m2).epsilon(1e-10));
+    REQUIRE(m.moment_sum<3>() == Catch::Approx(ref.m3).epsilon(1e-8));
+    REQUIRE(m.moment_sum<4>() == Catch::Approx(ref.m4).epsilon(1e-8));
+
+    const double n = static_cast<double>(xs.size());
+    REQUIRE(m.skewness() == Catch::Approx(std::sqrt(n) * ref.m3 / std::pow(ref.m2, 1.5)).epsilon(1e-8));
+    REQUIRE(m.kurtosis() == Catch::Approx(n * ref.m4 / (ref.m2 * ref.m2)).epsilon(1e-8));
+    // Gamma(k = 2): skewness 2/sqrt(k), excess kurtosis 6/k.
+    REQUIRE(m.skewness() == Catch::Approx(std::sqrt(2.0)).epsilon(0.15));
+    REQUIRE(m.excess_kurtosis() == Catch::Approx(3.0).epsilon(0.35));
+}
+
+TEST_CASE("RunningMoments batch observe equals scalar observe", "[moments][batch]") {
+    for (std::size_t n : {1u, 7u, 16u, 33u, 1000u, 4099u}) {
+        const auto head = gamma_data(5, 402);
+        const auto xs = gamma_data(n, 403 + static_cast<unsigned>(n));
+
+        fastnum::RunningMoments<double> stream, batch;
+        for (double x : head) {
+            stream.observe(x);
+            batch.observe(x);
+        }
+        for (double x : xs) stream.observe(x);
+        batch.observe(xs);
+
+        REQUIRE(batch.count() == stream.count());
+        REQUIRE(batch.mean() == Catch::Approx(stream.mean()).epsilon(1e-12));
+        REQUIRE(batch.variance_sample() == Catch::Approx(stream.variance_sample()).epsilon(1e-10));
+        REQUIRE(batch.skewness() == Catch::Approx(stream.skewness()).epsilon(1e-8));
+        REQUIRE(batch.kurtosis() == Catch::Approx(stream.kurtosis()).epsilon(1e-8));
+    }
+}
+
+TEST_CASE("RunningMoments merge equals single pass", "[moments][merge]") {
+    const auto xs = gamma_data(3001, 404);
+    fastnum::RunningMoments<double> full, a, b;
+    full.observe(xs);
+    a.observe(xs.data(), 1234);
+    b.observe(xs.data() + 1234, xs.size() - 1234);
+    a.merge(b);
+
+    REQUIRE(a.count() == full.count());
+    REQUIRE(a.mean() == Catch::Approx(full.mean()).epsilon(1e-12));
+    REQUIRE(a.moment_sum<3>() == Catch::Approx(full.moment_sum<3>()).epsilon(1e-9));
+    REQUIRE(a.moment_sum<4>() == Catch::Approx(full.moment_sum<4>()).epsilon(1e-9));
+
+    fastnum::RunningMoments<double> empty;
+    empty.merge(a);
+    REQUIRE(empty.kurtosis() == a.kurtosis());
+    a.reset();
+    REQUIRE(a.count() == 0);
+}
+
+TEST_CASE("Lower orders track only what they need", "[moments]") {
+    const auto xs = gamma_data(777, 405);
+
+    fastnum::RunningMoments<double, 0> count_only;
+    count_only.observe(xs);
+    REQUIRE(count_only.count() == xs.size());
+
+    fastnum::RunningMoments<double, 1> mean_only;
+    mean_only.observe(xs);
+    fastnum::RunningMoments<double, 2> var;
+    var.observe(xs);
+    fastnum::RunningStats<double> rs;
+    rs.observe(xs);
+    REQUIRE(mean_only.mean() == Catch::Approx(rs.mean()).epsilon(1e-12));
+    REQUIRE(var.variance_sample() == Catch::Approx(rs.variance_sample()).epsilon(1e-12));
+
+    std::vector<float> xf(xs.begin(), xs.end());
+    fastnum::RunningMoments<float, 3> skew_f;
+    skew_f.observe(xf);
+    fastnum::RunningMoments<double, 3> skew_d;
+    skew_d.observe(xs);
+    REQUIRE(skew_f.skewness() == Catch::Approx(skew_d.skewness()).epsilon(1e-3));
+    STATIC_REQUIRE(sizeof(fastnum::RunningMoments<double, 2>) == sizeof(fastnum::RunningStats<double>));
+    STATIC_REQUIRE(sizeof(fastnum::RunningMoments<double, 4>) == 40);
+}
+
+TEST_CASE("RunningMoments NaN policy", "[moments]") {
+    fastnum::RunningMoments<double> m;
+    REQUIRE(std::isnan(m.variance_population()));
+    m.observe(1.0);
+    REQUIRE(std::isnan(m.skewness()));
+    m.observe(1.0);
+    REQUIRE(std::isnan(m.kurtosis())); // zero variance
+    m.observe(4.0);
+    REQUIRE(std::isfinite(m.skewness()));
+}
@@ -92,3 +92,406 @@ TEST_CASE("RunningStats merge equals push-all-at-once", "[runningstats][merge]")
 }
 
 
+
+TEST_CASE("RunningStats batch observe matches scalar observe", "[runningstats][batch]") {
+    std::mt19937 rng(2024);
+    std::normal_distribution<double> dist(5.0, 2.0);
+
+    // Sizes around and between SIMD block boundaries, including empty tails.
+    for (std::size_t n : {0u, 1u, 3u, 7u, 16u, 31u, 32u, 33u, 64u, 127u, 1000u, 4099u}) {
+        std::vector<double> xs(n);
+        for (double& x : xs) x = dist(rng);
+
+        fastnum::RunningStats<double> stream;
+        for (double x : xs) stream.observe(x);
+
+        fastnum::RunningStats<double> batch;
+        batch.observe(xs.data(), xs.size());
+
+        REQUIRE(batch.count() == n);
+        if (n == 0) continue;
+        REQUIRE(batch.mean() == Catch::Approx(stream.mean()).epsilon(1e-12));
+        if (n >= 2) {
+            REQUIRE(batch.variance_sample() == Catch::Approx(stream.variance_sample()).epsilon(1e-10));
+        }
+    }
+}
+
+TEST_CASE("RunningStats batch observe appends to existing state", "[runningstats][batch]") {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+
+    std::vector<double> xs(777);
+    for (double& x : xs) x = dist(rng);
+
+    fastnum::RunningStats<double> stream;
+    for (double x : xs) stream.observe(x);
+
+    fastnum::RunningStats<double> mixed;
+    for (std::size_t i = 0; i < 10; ++i) mixed.observe(xs[i]);
+    mixed.observe(xs.data() + 10, 500);
+    std::vector<double> rest(xs.begin() + 510, xs.end());
+    mixed.observe(rest);
+
+    REQUIRE(mixed.count() == stream.count());
+    REQUIRE(mixed.mean() == Catch::Approx(stream.mean()).epsilon(1e-12));
+    REQUIRE(mixed.variance_population() == Catch::Approx(stream.variance_population()).epsilon(1e-10));
+}
+
+TEST_CASE("RunningStats<float> batch observe matches naive", "[runningstats][batch]") {
+    std::mt19937 rng(7);
+    std::normal_distribution<float> dist(10.0f, 3.0f);
+
+    std::vector<float> xs(100000);
+    for (float& x : xs) x = dist(rng);
+    std::vector<double> wide(xs.begin(), xs.end());
+
+    fastnum::RunningStats<float> rs;
+    rs.observe(xs);
+
+    REQUIRE(rs.count() == xs.size());
+    REQUIRE(rs.mean() == Catch::Approx(naive_mean(wide)).epsilon(1e-5));
+    REQUIRE(rs.variance_sample() == Catch::Approx(naive_sample_var(wide)).epsilon(1e-4));
+}
+
+TEST_CASE("RunningStats weighted observe equals repeated observe", "[runningstats][weighted]") {
+    std::mt19937 rng(8);
+    std::normal_distribution<double> dist(50.0, 7.0);
+    std::uniform_int_distribution<int> count(0, 9);
+
+    std::vector<double> xs(1003), ws(1003), expanded;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = dist(rng);
+        ws[i] = static_cast<double>(count(rng));
+        for (int k = 0; k < static_cast<int>(ws[i]); ++k) expanded.push_back(xs[i]);
+    }
+
+    fastnum::RunningStats<double> scalar, batch;
+    for (std::size_t i = 0; i < xs.size(); ++i) scalar.observe(xs[i], ws[i]);
+    batch.observe(xs.data(), ws.data(), xs.size());
+
+    REQUIRE(scalar.count() == expanded.size());
+    REQUIRE(batch.count() == expanded.size());
+    REQUIRE(scalar.mean() == Catch::Approx(naive_mean(expanded)).epsilon(1e-12));
+    REQUIRE(batch.mean() == Catch::Approx(naive_mean(expanded)).epsilon(1e-12));
+    REQUIRE(scalar.variance_sample() == Catch::Approx(naive_sample_var(expanded)).epsilon(1e-10));
+    REQUIRE(batch.variance_sample() == Catch::Approx(naive_sample_var(expanded)).epsilon(1e-10));
+
+    // Zero weights are no-ops, also on an empty accumulator.
+    fastnum::RunningStats<double> z;
+    z.observe(3.0, 0.0);
+    REQUIRE(z.count() == 0);
+    REQUIRE(z.mean() == 0.0);
+}
+
+TEST_CASE("RunningStats fractional weights truncate alike in scalar and batch", "[runningstats][weighted]") {
+    std::mt19937 rng(9);
+    std::normal_distribution<double> dist(30.0, 4.0);
+    std::uniform_real_distribution<double> weight(-1.0, 4.0);
+
+    // Uniform sub-1 and fractional weights, then a mix, over lengths that do
+    // and do not fill whole lane blocks.
+    for (const double fixed : {0.5, 0.999, 2.5, -3.0, -1.0}) {
+        std::vector<double> xs(128), ws(128, fixed);
+        for (double& x : xs) x = dist(rng);
+        fastnum::RunningStats<double> scalar, batch;
+        for (std::size_t i = 0; i < xs.size(); ++i) scalar.observe(xs[i], ws[i]);
+        batch.observe(xs.data(), ws.data(), xs.size());
+        REQUIRE(batch.count() == scalar.count());
+        REQUIRE(batch.mean() == Catch::Approx(scalar.mean()).epsilon(1e-12));
+        REQUIRE(batch.m2() == Catch::Approx(scalar.m2()).epsilon(1e-10));
+    }
+    for (const std::size_t n : {std::size_t{128}, std::size_t{257}, std::size_t{1001}}) {
+        std::vector<double> xs(n), ws(n), expanded;
+        for (std::size_t i = 0; i < n; ++i) {
+            xs[i] = dist(rng);
+            ws[i] = weight(rng);
+            for (int k = 0; k < static_cast<int>(ws[i]); ++k) expanded.push_back(xs[i]);
+        }
+        fastnum::RunningStats<double> scalar, batch;
+        for (std::size_t i = 0; i < n; ++i) scalar.observe(xs[i], ws[i]);
+        batch.observe(xs.data(), ws.data(), n);
+        REQUIRE(scalar.count() == expanded.size());
+        REQUIRE(batch.count() == expanded.size());
+        REQUIRE(batch.mean() == Catch::Approx(naive_mean(expanded)).epsilon(1e-12));
+        REQUIRE(batch.variance_sample() == Catch::Approx(naive_sample_var(expanded)).epsilon(1e-10));
+    }
+}
+
+TEST_CASE("RunningStats float weighted batch keeps exact counts beyond 2^24", "[runningstats][weighted]") {
+    std::mt19937 rng(10);
+    std::normal_distribution<float> dist(5.0f, 2.0f);
+    std::uniform_int_distribution<int> count(900000, 1100000);
+
+    std::vector<float> xs(4096), ws(4096);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = dist(rng);
+        ws[i] = static_cast<float>(count(rng));
+        total += static_cast<std::size_t>(ws[i]);
+    }
+    fastnum::RunningStats<float> scalar, batch;
+    for (std::size_t i = 0; i < xs.size(); ++i) scalar.observe(xs[i], ws[i]);
+    batch.observe(xs.data(), ws.data(), xs.size());
+    REQUIRE(scalar.count() == total);
+    REQUIRE(batch.count() == total);
+    REQUIRE(batch.mean() == Catch::Approx(scalar.mean()).epsilon(1e-4));
+}
+
+TEST_CASE("RunningStats observe_summary injects reduced chunks", "[runningstats][weighted]") {
+    std::vector<double> a = {1.0, 2.0, 4.0, 8.0}, b = {3.0, 5.0, 7.0};
+    fastnum::RunningStats<double> sa, sb, all;
+    sa.observe(a);
+    sb.observe(b);
+    all.observe(a);
+    all.observe(b);
+
+    fastnum::RunningStats<double> rs;
+    rs.observe_summary(sa.count(), sa.mean(), sa.m2());
+    rs.observe_summary(0, 123.0, 456.0); // empty chunk
+    rs.observe_summary(sb.count(), sb.mean(), sb.m2());
+    REQUIRE(rs.count() == all.count());
+    REQUIRE(rs.mean() == Catch::Approx(all.mean()));
+    REQUIRE(rs.variance_sample() == Catch::Approx(all.variance_sample()));
+}
+
+TEST_CASE("RunningStats merge_many equals observing everything", "[runningstats][merge]") {
+    std::mt19937 rng(9);
+    std::normal_distribution<double> dist(1e6, 2.0); // large mean: cancellation-prone
+    std::uniform_int_distribution<std::size_t> len(0, 40);
+
+    std::vector<fastnum::RunningStats<double>> parts(1001);
+    std::vector<double> all;
+    for (auto& p : parts) {
+        const std::size_t m = len(rng); // includes empty states
+        for (std::size_t i = 0; i < m; ++i) {
+            const double x = dist(rng);
+            p.observe(x);
+            all.push_back(x);
+        }
+    }
+
+    fastnum::RunningStats<double> many, folded;
+    many.merge_many(parts);
+    for (const auto& p : parts) folded.merge(p);
+
+    REQUIRE(many.count() == all.size());
+    REQUIRE(many.mean() == Catch::Approx(naive_mean(all)).epsilon(1e-14));
+    REQUIRE(many.variance_sample() == Catch::Approx(naive_sample_var(all)).epsilon(1e-9));
+    REQUIRE(many.variance_sample() == Catch::Approx(folded.variance_sample()).epsilon(1e-8));
+
+    // Existing state takes part; empty input and all-empty parts are no-ops.
+    fastnum::RunningStats<double> split;
+    split.merge(parts[0]);
+    split.merge_many(parts.data() + 1, parts.size() - 1);
+    REQUIRE(split.count() == all.size());
+    REQUIRE(split.variance_sample() == Catch::Approx(many.variance_sample()).epsilon(1e-12));
+    split.merge_many(nullptr, 0);
+    std::vector<fastnum::RunningStats<double>> empties(5);
+    split.merge_many(empties);
+    REQUIRE(split.count() == all.size());
+    fastnum::RunningStats<double> none;
+    none.merge_many(empties);
+    REQUIRE(none.count() == 0);
+    REQUIRE(none.mean() == 0.0);
+}
+
+TEST_CASE("RunningStats observe_strided matches a contiguous batch", "[runningstats][batch]") {
+    std::mt19937 rng(41);
+    std::normal_distribution<double> dist(-1.0, 5.0);
+
+    for (std::size_t stride : {std::size_t{1}, std::size_t{2}, std::size_t{7}}) {
+        for (std::size_t n : {std::size_t{0}, std::size_t{3}, std::size_t{100}, std::size_t{2049}}) {
+            std::vector<double> matrix(n * stride), column(n);
+            for (auto& v : matrix) v = dist(rng);
+            for (std::size_t i = 0; i < n; ++i) column[i] = matrix[i * stride];
+
+            fastnum::RunningStats<double> contiguous, strided;
+            contiguous.observe(column);
+            strided.observe_strided(matrix.data(), stride, n);
+            REQUIRE(strided.count() == contiguous.count());
+            REQUIRE(strided.mean() == contiguous.mean());
+            REQUIRE(strided.m2() == contiguous.m2());
+        }
+    }
+
+    std::vector<float> rows(3 * 333);
+    for (auto& v : rows) v = static_cast<float>(dist(rng));
+    std::vector<double> col;
+    for (std::size_t i = 1; i < rows.size(); i += 3) col.push_back(rows[i]);
+    fastnum::RunningStats<float> rs;
+    rs.observe_strided(rows.data() + 1, 3, 333);
+    REQUIRE(rs.count() == 333);
+    REQUIRE(rs.mean() == Catch::Approx(naive_mean(col)).epsilon(1e-5));
+    REQUIRE(rs.variance_sample() == Catch::Approx(naive_sample_var(col)).epsilon(1e-4));
+}
+
+TEST_CASE("RunningStats NaN policy skips non-finite inputs", "[runningstats][nan]") {
+    using skip_stats = fastnum::RunningStats<double, fastnum::nan_handling_policy<fastnum::nan_policy::skip>>;
+    using count_stats =
+        fastnum::RunningStats<double, fastnum::nan_handling_policy<fastnum::nan_policy::count_and_skip>>;
+    STATIC_REQUIRE(sizeof(skip_stats) == sizeof(fastnum::RunningStats<double>));
+    STATIC_REQUIRE(fastnum::RunningStats<double>::nans == fastnum::nan_policy::propagate);
+
+    std::mt19937 rng(51);
+    std::normal_distribution<double> dist(4.0, 2.0);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    std::vector<double> xs(1003), finite;
+    std::size_t bad = 0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = i % 17 == 3 ? nan : i % 101 == 7 ? -inf : dist(rng);
+        if (std::isfinite(xs[i])) finite.push_back(xs[i]); else ++bad;
+    }
+
+    fastnum::RunningStats<double> propagate, reference;
+    skip_stats skip;
+    count_stats counted;
+    propagate.observe(xs);
+    reference.observe(finite);
+    skip.observe(xs);
+    counted.observe(xs.data(), xs.size());
+
+    REQUIRE(std::isnan(propagate.mean()));
+    for (std::size_t c : {skip.count(), counted.count()}) REQUIRE(c == finite.size());
+    REQUIRE(skip.mean() == Catch::Approx(reference.mean()).epsilon(1e-12));
+    REQUIRE(counted.variance_sample() == Catch::Approx(naive_sample_var(finite)).epsilon(1e-10));
+    REQUIRE(skip.skipped() == 0);
+    REQUIRE(counted.skipped() == bad);
+
+    // Scalar, strided and weighted paths follow the same policy.
+    count_stats scalar;
+    for (double x : xs) scalar.observe(x);
+    REQUIRE(scalar.count() == finite.size());
+    REQUIRE(scalar.skipped() == bad);
+    REQUIRE(scalar.mean() == Catch::Approx(reference.mean()).epsilon(1e-12));
+
+    count_stats strided;
+    strided.observe_strided(xs.data(), 2, xs.size() / 2 + 1);
+    std::size_t strided_bad = 0;
+    for (std::size_t i = 0; i < xs.size(); i += 2) strided_bad += std::isfinite(xs[i]) ? 0 : 1;
+    REQUIRE(strided.skipped() == strided_bad);
+    REQUIRE(strided.count() + strided_bad == xs.size() / 2 + 1);
+
+    std::vector<double> ws(xs.size(), 2.0);
+    ws[10] = nan;
+    count_stats weighted;
+    weighted.observe(xs.data(), ws.data(), xs.size());
+    const std::size_t weighted_bad = bad + (std::isfinite(xs[10]) ? 1 : 0);
+    REQUIRE(weighted.skipped() == weighted_bad);
+    REQUIRE(weighted.mean() == Catch::Approx(reference.mean()).epsilon(1e-3));
+
+    // Drop counts survive merges and are cleared by reset().
+    count_stats merged;
+    merged.merge(counted);
+    merged.merge(scalar);
+    REQUIRE(merged.skipped() == 2 * bad);
+    std::vector<count_stats> parts(5, counted);
+    merged.merge_many(parts);
+    REQUIRE(merged.skipped() == 7 * bad);
+    merged.reset();
+    REQUIRE(merged.skipped() == 0);
+    REQUIRE(merged.count() == 0);
+}
+
+TEST_CASE("RunningStats NaN skipping switches kernels mid-batch", "[runningstats][nan]") {
+    using count_stats =
+        fastnum::RunningStats<double, fastnum::nan_handling_policy<fastnum::nan_policy::count_and_skip>>;
+    // Clean chunks take the unmasked kernel; non-finite values from well past
+    // the first chunk on switch to the masked one.
+    std::vector<double> xs(40000);
+    for (std::size_t i = 0; i < xs.size(); ++i) xs[i] = static_cast<double>(i % 1000) * 0.01 + 1e6;
+    xs[20000] = std::numeric_limits<double>::quiet_NaN();
+    xs[39999] = std::numeric_limits<double>::infinity();
+    std::vector<double> finite;
+    for (double x : xs) if (std::isfinite(x)) finite.push_back(x);
+
+    count_stats rs;
+    rs.observe(xs);
+    REQUIRE(rs.count() == finite.size());
+    REQUIRE(rs.skipped() == 2);
+    REQUIRE(rs.mean() == Catch::Approx(naive_mean(finite)).epsilon(1e-12));
+    REQUIRE(rs.variance_sample() == Catch::Approx(naive_sample_var(finite)).epsilon(1e-9));
+
+    count_stats clean;
+    clean.observe(finite);
+    REQUIRE(clean.skipped() == 0);
+    REQUIRE(clean.variance_sample() == Catch::Approx(naive_sample_var(finite)).epsilon(1e-9));
+}
+
+TEST_CASE("RunningStats<double> observes float input in double precision", "[runningstats][precision]") {
+    std::mt19937 rng(801);
+    std::normal_distribution<double> dist(1e4, 0.5);
+    std::vector<float> xs(10007);
+    for (float& x : xs) x = static_cast<float>(dist(rng));
+    const std::vector<double> wide(xs.begin(), xs.end());
+
+    fastnum::RunningStats<double> mixed, ref;
+    mixed.observe(xs.data(), 5000);
+    mixed.observe(xs.data() + 5000, xs.size() - 5000);
+    ref.observe(wide.data(), wide.size());
+    REQUIRE(mixed.count() == ref.count());
+    REQUIRE(mixed.mean() == Catch::Approx(ref.mean()).epsilon(1e-14));
+    REQUIRE(mixed.variance_sample() == Catch::Approx(ref.variance_sample()).epsilon(1e-12));
+
+    fastnum::RunningStats<double, fastnum::nan_handling_policy<fastnum::nan_policy::count_and_skip>> skipping;
+    xs[17] = std::numeric_limits<float>::quiet_NaN();
+    skipping.observe(xs); // containers of float take the same path
+    REQUIRE(skipping.count() == xs.size() - 1);
+    REQUIRE(skipping.skipped() == 1);
+}
+
+TEST_CASE("RunningStats compensated_policy keeps long float streams accurate", "[runningstats][precision]") {
+    // 2^23 float samples around 1000: a plain float Welford mean stalls and
+    // M2 drifts; the compensated one stays within a few ulps of double state.
+    std::mt19937 rng(802);
+    std::normal_distribution<double> dist(1000.0, 1.0);
+    std::vector<float> xs(std::size_t{1} << 23);
+    for (float& x : xs) x = static_cast<float>(dist(rng));
+
+    fastnum::RunningStats<double> ref;
+    ref.observe(xs.data(), xs.size());
+
+    using Kahan = fastnum::RunningStats<float, fastnum::compensated_policy<>>;
+    Kahan batch;
+    batch.observe(xs.data(), xs.size() / 2);
+    batch.observe(xs.data() + xs.size() / 2, xs.size() / 2);
+    Kahan scalar;
+    for (std::size_t i = 0; i < xs.size(); ++i) scalar.observe(xs[i]);
+    fastnum::RunningStats<double> ref_scalar;
+    for (std::size_t i = 0; i < xs.size(); ++i) ref_scalar.observe(xs[i]);
+    fastnum::RunningStats<float> plain_scalar;
+    for (std::size_t i = 0; i < xs.size(); ++i) plain_scalar.observe(xs[i]);
+
+    REQUIRE(batch.count() == xs.size());
+    REQUIRE(batch.mean() == Catch::Approx(ref.mean()).epsilon(2e-7));
+    REQUIRE(batch.variance_sample() == Catch::Approx(ref.variance_sample()).epsilon(1e-5));
+    REQUIRE(scalar.mean() == Catch::Approx(ref_scalar.mean()).epsilon(2e-7));
+    REQUIRE(scalar.variance_sample() == Catch::Approx(ref_scalar.variance_sample()).epsilon(1e-5));
+    REQUIRE(std::abs(plain_scalar.variance_sample() / ref_scalar.variance_sample() - 1.0) > 1e-3);
+
+    // Merging and reset fold / clear the compensation.
+    Kahan merged = scalar;
+    merged.merge(batch);
+    REQUIRE(merged.count() == 2 * xs.size());
+    REQUIRE(merged.mean() == Catch::Approx(ref.mean()).epsilon(2e-7));
+    // merge_many folds the terms too: it reduces exactly the settled moments.
+    const Kahan parts[2] = {scalar, batch};
+    const fastnum::RunningStats<float> settled[2] = {
+        fastnum::RunningStats<float>::from_moments(scalar.count(), scalar.mean(), scalar.m2()),
+        fastnum::RunningStats<float>::from_moments(batch.count(), batch.mean(), batch.m2())};
+    Kahan many;
+    many.merge_many(parts, 2);
+    fastnum::RunningStats<float> many_settled;
+    many_settled.merge_many(settled, 2);
+    REQUIRE(many.count() == merged.count());
+    REQUIRE(many.mean() == many_settled.mean());
+    REQUIRE(many.m2() == many_settled.m2());
+    REQUIRE(many.mean() == Catch::Approx(merged.mean()).epsilon(1e-7));
+    merged.reset();
+    merged.observe(2.0f);
+    merged.observe(4.0f);
+    REQUIRE(merged.mean() == 3.0f);
+    REQUIRE(merged.m2() == 2.0f);
+}
@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/serialization.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+TEST_CASE("RunningStats state round-trips bit-exactly", "[serialization]") {
+    fastnum::RunningStats<double> rs;
+    for (double x : {1.5, -2.0, 7.25, 3.0}) rs.observe(x);
+
+    std::vector<unsigned char> buf(fastnum::serialized_size<fastnum::RunningStats<double>>(1));
+    REQUIRE(fastnum::to_bytes(rs, buf.data(), buf.size()) == buf.size());
+    REQUIRE(buf.size() == 32 + 24);
+
+    // Header is little-endian and starts with the magic.
+    REQUIRE(std::memcmp(buf.data(), "FNST", 4) == 0);
+    REQUIRE(buf[6] == static_cast<unsigned char>(fastnum::state_kind::running_stats));
+    REQUIRE(buf[7] == sizeof(double));
+
+    fastnum::RunningStats<double> back;
+    REQUIRE(fastnum::from_bytes(buf.data(), buf.size(), back) == fastnum::state_error::none);
+    REQUIRE(back.count() == rs.count());
+    REQUIRE(back.mean() == rs.mean());
+    REQUIRE(back.m2() == rs.m2());
+
+    // Decoded state keeps accumulating like the original.
+    rs.observe(10.0);
+    back.observe(10.0);
+    REQUIRE(back.variance_sample() == rs.variance_sample());
+}
+
+TEST_CASE("Array of covariance states merges straight from the buffer", "[serialization]") {
+    std::mt19937 rng(101);
+    std::normal_distribution<double> dist(0.0, 1.0);
+
+    constexpr std::size_t parts = 300;
+    std::vector<fastnum::OnlineCovariance<double>> states(parts);
+    fastnum::OnlineCovariance<double> full;
+    for (auto& s : states) {
+        for (int i = 0; i < 7; ++i) {
+            const double x = dist(rng);
+            const double y = 0.5 * x + dist(rng);
+            s.observe(x, y);
+            full.observe(x, y);
+        }
+    }
+
+    using Cov = fastnum::OnlineCovariance<double>;
+    std::vector<std::uint64_t> storage((fastnum::serialized_size<Cov>(parts) + 7) / 8); // 8-byte aligned
+    const std::size_t bytes = fastnum::to_bytes(states.data(), parts, storage.data(), storage.size() * 8);
+    REQUIRE(bytes == fastnum::serialized_size<Cov>(parts));
+
+    const fastnum::state_view<Cov> view(storage.data(), bytes);
+    REQUIRE(view.ok());
+    REQUIRE(view.size() == parts);
+    REQUIRE(view[17].comoment() == states[17].comoment());
+    if constexpr (std::endian::native == std::endian::little) {
+        REQUIRE(view.records() != nullptr);
+        REQUIRE(view.records()[3].n == 7);
+    }
+
+    const Cov merged = view.merged();
+    REQUIRE(merged.count() == full.count());
+    REQUIRE(merged.mean_x() == Catch::Approx(full.mean_x()).epsilon(1e-12));
+    REQUIRE(merged.covariance_sample() == Catch::Approx(full.covariance_sample()).epsilon(1e-12));
+
+    std::vector<Cov> decoded(parts);
+    std::size_t count = 0;
+    REQUIRE(fastnum::from_bytes(storage.data(), bytes, decoded.data(), decoded.size(), &count) ==
+            fastnum::state_error::none);
+    REQUIRE(count == parts);
+    REQUIRE(decoded[parts - 1].m2_y() == states[parts - 1].m2_y());
+    REQUIRE(fastnum::from_bytes(storage.data(), bytes, decoded.data(), parts - 1) ==
+            fastnum::state_error::capacity);
+}
+
+TEST_CASE("Corrupt or mismatched blobs are rejected", "[serialization]") {
+    fastnum::RunningStats<double> rs[3];
+    for (int i = 0; i < 3; ++i) rs[i].observe(static_cast<double>(i));
+
+    using RS = fastnum::RunningStats<double>;
+    std::vector<unsigned char> buf(fastnum::serialized_size<RS>(3));
+    REQUIRE(fastnum::to_bytes(rs, 3, buf.data(), buf.size()) == buf.size());
+    REQUIRE(fastnum::to_bytes(rs, 3, buf.data(), buf.size() - 1) == 0);
+
+    SECTION("flipped payload bit") {
+        buf.back() ^= 0x01;
+        REQUIRE(fastnum::state_view<RS>(buf.data(), buf.size()).error() == fastnum::state_error::bad_checksum);
+        REQUIRE(fastnum::state_view<RS>(buf.data(), buf.size(), false).ok());
+        buf.back() ^= 0x01;
+    }
+    SECTION("truncated") {
+        REQUIRE(fastnum::state_view<RS>(buf.data(), buf.size() - 1).error() == fastnum::state_error::truncated);
+        REQUIRE(fastnum::state_view<RS>(buf.data(), 10).error() == fastnum::state_error::truncated);
+    }
+    SECTION("wrong magic / version") {
+        buf[0] = 'X';
+        REQUIRE(fastnum::state_view<RS>(buf.data(), buf.size()).error() == fastnum::state_error::bad_magic);
+        buf[0] = 'F';
+        buf[4] = 99;
+        REQUIRE(fastnum::state_view<RS>(buf.data(), buf.size()).error() == fastnum::state_error::bad_version);
+        buf[4] = 1;
+    }
+    SECTION("wrong accumulator or scalar type") {
+        REQUIRE(fastnum::state_view<fastnum::RunningStats<float>>(buf.data(), buf.size()).error() ==
+                fastnum::state_error::kind_mismatch);
+        REQUIRE(fastnum::state_view<fastnum::OnlineCovariance<double>>(buf.data(), buf.size()).error() ==
+                fastnum::state_error::kind_mismatch);
+    }
+    SECTION("single-state decode needs exactly one record") {
+        RS one;
+        REQUIRE(fastnum::from_bytes(buf.data(), buf.size(), one) == fastnum::state_error::capacity);
+    }
+}
+
+TEST_CASE("Checksum is optional and empty arrays are valid", "[serialization]") {
+    fastnum::RunningStats<float> rs;
+    rs.observe(2.0f);
+    unsigned char buf[64];
+    const std::size_t n = fastnum::to_bytes(rs, buf, sizeof buf, false);
+    REQUIRE(n == 32 + 16);
+    buf[n - 1] ^= 0x80; // not detected without a checksum
+    REQUIRE(fastnum::state_view<fastnum::RunningStats<float>>(buf, n).ok());
+
+    const std::size_t e = fastnum::to_bytes<fastnum::RunningStats<float>>(nullptr, 0, buf, sizeof buf);
+    REQUIRE(e == 32);
+    const fastnum::state_view<fastnum::RunningStats<float>> view(buf, e);
+    REQUIRE(view.ok());
+    REQUIRE(view.size() == 0);
+    REQUIRE(view.merged().count() == 0);
+}
@@ -0,0 +1,164 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <fastnum/sliding_window.hpp>
+#include <fastnum/exponential_stats.hpp>
+#include <fastnum/histogram.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct sample {
+    std::int64_t t;
+    double x;
+    double y;
+};
+
+// Brute force: everything whose bucket is within the window of `now`.
+template <class Acc, class Fn>
+Acc rebuild(const std::vector<sample>& history, std::int64_t now, std::int64_t width, std::int64_t buckets,
+            Fn&& observe) {
+    const auto bucket = [width](std::int64_t t) { return t >= 0 ? t / width : -((-t + width - 1) / width); };
+    Acc acc;
+    for (const sample& s : history) {
+        if (bucket(s.t) > bucket(now) - buckets) observe(acc, s);
+    }
+    return acc;
+}
+
+} // namespace
+
+TEST_CASE("WindowedRunningStats matches a rebuilt window", "[window]") {
+    constexpr std::size_t B = 16;
+    constexpr std::int64_t width = 10;
+    fastnum::WindowedRunningStats<B> window(width);
+
+    std::mt19937 rng(301);
+    std::normal_distribution<double> dist(5.0, 2.0);
+    std::geometric_distribution<int> gap(0.3);
+
+    std::vector<sample> history;
+    std::int64_t t = -57;
+    for (int i = 0; i < 3000; ++i) {
+        t += gap(rng);
+        if (i == 1500) t += 40 * width; // idle stretch longer than the window
+        const double x = dist(rng);
+        history.push_back({t, x, 0.0});
+        window.observe(t, x);
+
+        if (i % 37 == 0 || i == 1500) {
+            const auto ref = rebuild<fastnum::RunningStats<double>>(
+                history, t, width, B, [](auto& acc, const sample& s) { acc.observe(s.x); });
+            const auto got = window.aggregate();
+            REQUIRE(got.count() == ref.count());
+            REQUIRE(got.mean() == Catch::Approx(ref.mean()).epsilon(1e-12));
+            if (ref.count() > 1) {
+                REQUIRE(got.variance_sample() == Catch::Approx(ref.variance_sample()).epsilon(1e-10));
+            }
+        }
+    }
+    REQUIRE(window.closed_buckets() == B - 1);
+    REQUIRE(window.newest_bucket() == (t >= 0 ? t / width : -((-t + width - 1) / width)));
+    REQUIRE(window.window_begin() == (window.newest_bucket() - static_cast<std::int64_t>(B) + 1) * width);
+}
+
+TEST_CASE("WindowedCovariance tracks correlation and batch updates", "[window]") {
+    constexpr std::size_t B = 5;
+    fastnum::WindowedCovariance<B> window(100);
+
+    std::vector<sample> history;
+    std::mt19937 rng(302);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    for (std::int64_t t = 0; t < 2000; t += 7) {
+        const double x = dist(rng);
+        const double y = 0.5 * x + dist(rng);
+        history.push_back({t, x, y});
+        window.observe(t, x, y);
+    }
+    const std::int64_t now = history.back().t;
+    const auto ref = rebuild<fastnum::OnlineCovariance<double>>(
+        history, now, 100, B, [](auto& acc, const sample& s) { acc.observe(s.x, s.y); });
+    const auto got = window.aggregate();
+    REQUIRE(got.count() == ref.count());
+    REQUIRE(got.correlation() == Catch::Approx(ref.correlation()).epsilon(1e-10));
+
+    // Batches go straight into the open bucket.
+    const std::vector<double> xs = {1.0, 2.0, 3.0}, ys = {2.0, 4.0, 6.5};
+    window.observe(now, xs.data(), ys.data(), xs.size());
+    window.open_bucket().observe(4.0, 8.0);
+    REQUIRE(window.aggregate().count() == ref.count() + 4);
+}
+
+TEST_CASE("SlidingWindow edge cases", "[window]") {
+    SECTION("single bucket keeps only the open one") {
+        fastnum::WindowedRunningStats<1> window(10);
+        window.observe(0, 1.0);
+        window.observe(9, 3.0);
+        REQUIRE(window.aggregate().mean() == Catch::Approx(2.0));
+        window.observe(10, 5.0);
+        REQUIRE(window.aggregate().count() == 1);
+        REQUIRE(window.aggregate().mean() == Catch::Approx(5.0));
+    }
+
+    SECTION("buckets expire one at a time") {
+        fastnum::WindowedRunningStats<3> window(1);
+        for (std::int64_t t = 0; t < 10; ++t) {
+            window.observe(t, static_cast<double>(t));
+            const auto a = window.aggregate();
+            REQUIRE(a.count() == static_cast<std::size_t>(t < 2 ? t + 1 : 3));
+            REQUIRE(a.mean() == Catch::Approx(t < 2 ? static_cast<double>(t) / 2.0 : static_cast<double>(t - 1)));
+        }
+        window.advance(11); // bucket 10 is empty, 9 still in the window
+        REQUIRE(window.aggregate().count() == 1);
+        window.advance(12);
+        REQUIRE(window.aggregate().count() == 0);
+    }
+
+    SECTION("clear restarts the window") {
+        fastnum::WindowedRunningStats<4> window(10);
+        window.observe(100, 1.0);
+        window.observe(120, 2.0);
+        window.clear();
+        REQUIRE(window.aggregate().count() == 0);
+        window.observe(5, 7.0); // earlier than before: a fresh window
+        REQUIRE(window.aggregate().mean() == Catch::Approx(7.0));
+        REQUIRE(window.newest_bucket() == 0);
+    }
+
+    SECTION("floating-point time and a configured prototype") {
+        fastnum::SlidingWindow<fastnum::RunningStats<double>, 4, double> window(0.5);
+        window.observe(-0.25, 1.0); // bucket -1
+        window.observe(1.2, 3.0);   // bucket 2
+        REQUIRE(window.newest_bucket() == 2);
+        REQUIRE(window.aggregate().count() == 2);
+        window.observe(1.6, 3.0); // bucket 3: bucket -1 expires
+        REQUIRE(window.aggregate().count() == 2);
+        REQUIRE(window.window_begin() == Catch::Approx(0.0));
+
+        fastnum::SlidingWindow<fastnum::ExponentialStats<double>, 2> ew(10, fastnum::ExponentialStats<double>(0.5));
+        ew.observe(0, 1.0);
+        ew.observe(1, 3.0);
+        fastnum::ExponentialStats<double> ref(0.5);
+        ref.observe(1.0);
+        ref.observe(3.0);
+        REQUIRE(ew.aggregate().mean() == Catch::Approx(ref.mean())); // same bucket, configured decay
+        REQUIRE(ew.aggregate().weight() == Catch::Approx(1.5));
+    }
+
+    SECTION("accumulators without a default constructor") {
+        using Hist = fastnum::Histogram<double, 10>;
+        fastnum::SlidingWindow<Hist, 3> window(1, Hist(0.0, 10.0));
+        for (std::int64_t t = 0; t < 6; ++t) window.observe(t, static_cast<double>(t) + 0.5);
+        const auto a = window.aggregate();
+        REQUIRE(a.count() == 3);
+        REQUIRE(a.hi() == 10.0);
+        REQUIRE(a.bin_count(3) == 1);
+        REQUIRE(a.bin_count(5) == 1);
+        REQUIRE(a.bin_count(2) == 0);
+    }
+}